@@ -2,77 +2,233 @@
 #include <vector>
 #include <algorithm>
 #include <sstream>
+#include <string>
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include "../../common/NumberStream.h"
+#include "../../common/IntervalSchedule.h"
+#include "../../common/TextStream.h"
 using namespace std;
 
+// Job sequencing with deadlines: take jobs by decreasing profit and give each
+// the latest free unit slot at or before its deadline. Free slots are found
+// with a disjoint-set forest instead of scanning backwards, so the whole run
+// is O(n log n) for the sort plus near-constant time per job. At most n jobs
+// can run, so deadlines are capped at n and the slot table never exceeds n.
+// --weighted switches to weighted interval scheduling for jobs that have a
+// start time and a duration instead of a unit slot and a deadline.
+
 struct Job {
-    char id;
-    int deadline;
-    int profit;
+    long long id;
+    long long deadline;
+    long long profit;
 };
 
-bool compare(Job a, Job b) {
-    return a.profit > b.profit;
+// slot[s] == s while s is free; once taken it points at s - 1. find(d) walks
+// to the latest free slot <= d with path halving; 0 means none is left.
+class SlotAllocator {
+    vector<uint32_t> slot;
+
+public:
+    explicit SlotAllocator(size_t slots) : slot(slots + 1) {
+        for (size_t s = 0; s <= slots; s++) slot[s] = s;
+    }
+
+    uint32_t take(uint32_t d) {
+        while (slot[d] != d) {
+            slot[d] = slot[slot[d]];
+            d = slot[d];
+        }
+        if (d > 0) slot[d] = d - 1;
+        return d;
+    }
+};
+
+struct Schedule {
+    vector<size_t> picked;     // positions into the sorted jobs, in pick order
+    vector<size_t> bySlot;     // the same jobs in execution order
+    long long totalProfit = 0;
+    size_t slots = 0;
+};
+
+Schedule sequence(vector<Job>& jobs) {
+    stable_sort(jobs.begin(), jobs.end(), [](const Job& a, const Job& b) { return a.profit > b.profit; });
+    Schedule schedule;
+    long long maxDeadline = 0;
+    for (const Job& job : jobs) maxDeadline = max(maxDeadline, job.deadline);
+    schedule.slots = (size_t)min<long long>(maxDeadline, jobs.size());
+
+    SlotAllocator allocator(schedule.slots);
+    vector<size_t> atSlot(schedule.slots + 1, SIZE_MAX);
+    for (size_t i = 0; i < jobs.size(); i++) {
+        if (jobs[i].deadline < 1) continue;
+        uint32_t s = allocator.take((uint32_t)min<long long>(jobs[i].deadline, schedule.slots));
+        if (s == 0) continue;
+        atSlot[s] = i;
+        schedule.picked.push_back(i);
+        schedule.totalProfit += jobs[i].profit;
+    }
+    for (size_t s = 1; s <= schedule.slots; s++) {
+        if (atSlot[s] != SIZE_MAX) schedule.bySlot.push_back(atSlot[s]);
+    }
+    return schedule;
 }
 
-int main(int argc, char* argv[]) {
-    if (argc < 2) {
-        cout << "{\"error\":\"Usage: ./JobScheduling <jobs>\"}" << endl;
-        return 1;
+// The original backwards scan over every slot, kept for the benchmark
+long long scanSequence(vector<Job> jobs) {
+    stable_sort(jobs.begin(), jobs.end(), [](const Job& a, const Job& b) { return a.profit > b.profit; });
+    long long maxDeadline = 0;
+    for (const Job& job : jobs) maxDeadline = max(maxDeadline, job.deadline);
+    vector<char> taken(maxDeadline + 1, 0);
+    long long total = 0;
+    for (const Job& job : jobs) {
+        for (long long j = job.deadline; j > 0; j--) {
+            if (!taken[j]) {
+                taken[j] = 1;
+                total += job.profit;
+                break;
+            }
+        }
     }
-    
-    string jobsStr = argv[1];
-    stringstream ss(jobsStr);
-    
-    // Parse: "5;A,2,100;B,1,19;C,2,27;D,1,25;E,3,15"
-    string token;
-    getline(ss, token, ';');
-    int n = stoi(token);
-    
+    return total;
+}
+
+// Job ids print as the labels given on the command line, or as numbers
+struct Ids {
+    vector<string> labels;
+    void print(long long id) const {
+        if (labels.empty()) cout << id;
+        else cout << "\"" << jsonEscape(labels[id]) << "\"";
+    }
+};
+
+int runBenchmark(size_t n) {
+    mt19937_64 rng(5);
     vector<Job> jobs(n);
-    for (int i = 0; i < n; i++) {
-        getline(ss, token, ';');
-        stringstream jobSS(token);
-        string val;
-        
-        getline(jobSS, val, ',');
-        jobs[i].id = val[0];
-        
-        getline(jobSS, val, ',');
-        jobs[i].deadline = stoi(val);
-        
-        getline(jobSS, val, ',');
-        jobs[i].profit = stoi(val);
+    vector<intervals::Interval> items(n);
+    for (size_t i = 0; i < n; i++) {
+        jobs[i] = {(long long)i, 1 + (long long)(rng() % n), 1 + (long long)(rng() % 1000000)};
+        long long start = rng() % (10 * n);
+        items[i] = {start, start + 1 + (long long)(rng() % 100), 1 + (long long)(rng() % 1000), (long long)i};
     }
-    
-    sort(jobs.begin(), jobs.end(), compare);
-    
-    int maxDeadline = 0;
-    for (const Job& job : jobs) {
-        maxDeadline = max(maxDeadline, job.deadline);
+    auto timed = [](auto fn) {
+        auto start = chrono::steady_clock::now();
+        fn();
+        return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    };
+    Schedule schedule;
+    long long scanned = -1, weighted = 0;
+    vector<size_t> chosen;
+    vector<Job> copy = jobs;
+    double tDsu = timed([&] { schedule = sequence(copy); });
+    double tScan = n <= 200000 ? timed([&] { scanned = scanSequence(jobs); }) : -1;
+    double tWeighted = timed([&] { weighted = intervals::weightedSchedule(items, chosen); });
+
+    cout << "{\"algorithm\":\"Job Scheduling\",\"mode\":\"benchmark\",\"jobs\":" << n << ",\"results\":["
+         << "{\"kernel\":\"dsu\",\"totalProfit\":" << schedule.totalProfit << ",\"seconds\":" << tDsu << "}";
+    if (scanned >= 0) cout << ",{\"kernel\":\"scan\",\"totalProfit\":" << scanned << ",\"seconds\":" << tScan << "}";
+    cout << ",{\"kernel\":\"weighted-interval\",\"totalProfit\":" << weighted << ",\"scheduled\":" << chosen.size()
+         << ",\"seconds\":" << tWeighted << "}]"
+         << ",\"consistent\":" << (scanned < 0 || scanned == schedule.totalProfit ? "true" : "false") << "}" << endl;
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    ios::sync_with_stdio(false);
+    bool weighted = false, withList = true;
+    vector<string> args;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--weighted") weighted = true;
+        else if (arg == "--no-list") withList = false;
+        else args.push_back(arg);
     }
-    
-    vector<int> timeSlots(maxDeadline + 1, -1);
-    vector<char> scheduledJobs;
-    int totalProfit = 0;
-    
-    for (int i = 0; i < n; i++) {
-        for (int j = jobs[i].deadline; j > 0; j--) {
-            if (timeSlots[j] == -1) {
-                timeSlots[j] = i;
-                totalProfit += jobs[i].profit;
-                scheduledJobs.push_back(jobs[i].id);
-                break;
+    if (!args.empty() && args[0] == "bench") return runBenchmark(args.size() >= 2 ? stoull(args[1]) : 1000000);
+    if (args.empty() || (args[0] == "--file" && args.size() < 2)) {
+        cout << "{\"error\":\"Usage: ./JobScheduling <jobs | --file path|-> [--weighted] [--no-list] | ./JobScheduling bench [n]\"}" << endl;
+        return 1;
+    }
+
+    // Records are id,deadline,profit or, with --weighted, id,start,duration,profit
+    Ids ids;
+    vector<Job> jobs;
+    vector<intervals::Interval> items;
+    auto add = [&](long long id, const long long* f) {
+        if (weighted) items.push_back({f[0], f[0] + f[1], f[2], id});
+        else jobs.push_back({id, f[0], f[1]});
+    };
+    int fields = weighted ? 3 : 2;
+    size_t bytes = 0;
+    auto start = chrono::steady_clock::now();
+    if (args[0] == "--file") {
+        NumberStream in;
+        string error;
+        if (!in.open(args[1], error)) {
+            cout << "{\"error\":\"" << jsonEscape(error) << "\"}" << endl;
+            return 1;
+        }
+        long long id, f[3];
+        while (in.next(id)) {
+            int got = 0;
+            while (got < fields && in.next(f[got])) got++;
+            if (got < fields) break;
+            add(id, f);
+        }
+        bytes = in.bytes();
+    } else {
+        // Parse: "5;A,2,100;B,1,19;C,2,27;D,1,25;E,3,15"
+        stringstream ss(args[0]);
+        string token;
+        getline(ss, token, ';');
+        int n = stoi(token);
+        for (int i = 0; i < n; i++) {
+            getline(ss, token, ';');
+            stringstream jobSS(token);
+            string val;
+            getline(jobSS, val, ',');
+            ids.labels.push_back(val);
+            long long f[3];
+            for (int k = 0; k < fields; k++) {
+                getline(jobSS, val, ',');
+                f[k] = stoll(val);
             }
+            add(i, f);
         }
     }
-    
+    double readSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
     // Output JSON
-    cout << "{\"algorithm\":\"Job Scheduling\",\"scheduledJobs\":[";
-    for (size_t i = 0; i < scheduledJobs.size(); i++) {
-        if (i > 0) cout << ",";
-        cout << "\"" << scheduledJobs[i] << "\"";
+    auto printList = [&](const char* name, const vector<size_t>& positions, auto idOf) {
+        if (!withList) return;
+        cout << ",\"" << name << "\":[";
+        for (size_t i = 0; i < positions.size(); i++) {
+            if (i > 0) cout << ",";
+            ids.print(idOf(positions[i]));
+        }
+        cout << "]";
+    };
+    start = chrono::steady_clock::now();
+    if (weighted) {
+        vector<size_t> chosen;
+        long long total = intervals::weightedSchedule(items, chosen);
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout << "{\"algorithm\":\"Weighted Interval Scheduling\",\"jobs\":" << items.size();
+        printList("scheduledJobs", chosen, [&](size_t p) { return items[p].id; });
+        cout << ",\"scheduledCount\":" << chosen.size() << ",\"totalProfit\":" << total;
+        if (bytes) cout << ",\"bytesRead\":" << bytes;
+        cout << ",\"readSeconds\":" << readSeconds << ",\"seconds\":" << seconds << "}" << endl;
+    } else {
+        Schedule schedule = sequence(jobs);
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout << "{\"algorithm\":\"Job Scheduling\",\"jobs\":" << jobs.size();
+        printList("scheduledJobs", schedule.picked, [&](size_t p) { return jobs[p].id; });
+        printList("sequence", schedule.bySlot, [&](size_t p) { return jobs[p].id; });
+        cout << ",\"scheduledCount\":" << schedule.picked.size() << ",\"totalProfit\":" << schedule.totalProfit
+             << ",\"slots\":" << schedule.slots;
+        if (bytes) cout << ",\"bytesRead\":" << bytes;
+        cout << ",\"readSeconds\":" << readSeconds << ",\"seconds\":" << seconds << "}" << endl;
     }
-    cout << "],\"totalProfit\":" << totalProfit << "}" << endl;
-    
+
     return 0;
 }
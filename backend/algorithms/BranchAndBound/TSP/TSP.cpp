@@ -1,65 +1,249 @@
 #include <iostream>
 #include <vector>
 #include <sstream>
-#include <climits>
-#include <cstring>
+#include <string>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <limits>
+#include <cstdint>
+#include "../../common/Barrier.h"
 using namespace std;
 
-int n;
-vector<vector<int>> dist;
-int dp[16][16];
+// Held-Karp over a flat table: city 0 is the start, the other N = n - 1 cities
+// are bits 0..N-1, and best[mask * N + j] is the cheapest path from 0 through
+// exactly the cities in mask, ending at j. Every subset of popcount s depends
+// only on subsets of popcount s - 1, so each layer is split across threads
+// (subsets are unranked in colex order to give each thread its own range).
+// Entries use the narrowest unsigned type that can hold n * max(dist); the
+// tour is recovered by re-deriving predecessors, so no parent table is kept.
 
-int tspDP(int mask, int pos) {
-    if (mask == (1 << n) - 1) {
-        return dist[pos][0];
+const int MAX_CITIES = 30;
+
+struct Tour {
+    uint64_t cost = 0;
+    vector<int> order;
+    int storageBits = 0;
+    size_t tableBytes = 0;
+};
+
+uint64_t binom[MAX_CITIES + 1][MAX_CITIES + 1];
+
+void fillBinomials() {
+    for (int a = 0; a <= MAX_CITIES; a++) {
+        binom[a][0] = 1;
+        for (int b = 1; b <= a; b++) binom[a][b] = binom[a - 1][b - 1] + (b <= a - 1 ? binom[a - 1][b] : 0);
+    }
+}
+
+// The rank-th subset of {0..N-1} with s bits, in increasing numeric order
+uint32_t unrank(uint64_t rank, int s, int N) {
+    uint32_t mask = 0;
+    for (int k = s, p = N - 1; k > 0; k--) {
+        while (binom[p][k] > rank) p--;
+        mask |= 1u << p;
+        rank -= binom[p][k];
+        p--;
+    }
+    return mask;
+}
+
+// Next subset with the same popcount (Gosper's hack)
+inline uint32_t nextSubset(uint32_t x) {
+    uint32_t c = x & -x, r = x + c;
+    return (((r ^ x) >> 2) / c) | r;
+}
+
+template <typename Cost>
+Tour heldKarp(const vector<vector<uint64_t>>& dist, unsigned threads) {
+    int n = dist.size(), N = n - 1;
+    const Cost INF = numeric_limits<Cost>::max();
+    Tour tour;
+    tour.storageBits = sizeof(Cost) * 8;
+    if (n == 1) {
+        tour.order = {0, 0};
+        return tour;
+    }
+
+    // into[j][k] = cost of the edge from city k+1 to city j+1 (0 for the start)
+    vector<vector<Cost>> into(N, vector<Cost>(N));
+    for (int j = 0; j < N; j++) {
+        for (int k = 0; k < N; k++) into[j][k] = dist[k + 1][j + 1];
+    }
+
+    size_t subsets = size_t(1) << N;
+    vector<Cost> best(subsets * N, INF);
+    tour.tableBytes = best.size() * sizeof(Cost);
+    for (int j = 0; j < N; j++) best[(size_t(1) << j) * N + j] = dist[0][j + 1];
+
+    auto layer = [&](int s, uint64_t from, uint64_t to) {
+        if (from >= to) return;
+        uint32_t mask = unrank(from, s, N);
+        for (uint64_t r = from; r < to; r++, mask = nextSubset(mask)) {
+            Cost* row = &best[size_t(mask) * N];
+            for (uint32_t bits = mask; bits; bits &= bits - 1) {
+                int j = __builtin_ctz(bits);
+                uint32_t prev = mask ^ (1u << j);
+                const Cost* prevRow = &best[size_t(prev) * N];
+                const Cost* edge = into[j].data();
+                Cost value = INF;
+                for (uint32_t ks = prev; ks; ks &= ks - 1) {
+                    int k = __builtin_ctz(ks);
+                    Cost candidate = prevRow[k] + edge[k];
+                    if (candidate < value) value = candidate;
+                }
+                row[j] = value;
+            }
+        }
+    };
+
+    if (threads < 1) threads = 1;
+    Barrier barrier(threads);
+    vector<thread> workers;
+    for (unsigned t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            for (int s = 2; s <= N; s++) {
+                uint64_t count = binom[N][s], per = (count + threads - 1) / threads;
+                layer(s, min(count, t * per), min(count, (t + 1) * per));
+                barrier.wait();
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    // Close the cycle, then walk back: the predecessor of j is any k whose
+    // entry plus the edge k -> j reproduces the stored value
+    uint32_t full = subsets - 1;
+    int last = 0;
+    uint64_t total = numeric_limits<uint64_t>::max();
+    for (int j = 0; j < N; j++) {
+        uint64_t c = (uint64_t)best[size_t(full) * N + j] + dist[j + 1][0];
+        if (c < total) {
+            total = c;
+            last = j;
+        }
+    }
+    tour.cost = total;
+    vector<int> reversed = {0};
+    uint32_t mask = full;
+    int j = last;
+    while (true) {
+        reversed.push_back(j + 1);
+        uint32_t prev = mask ^ (1u << j);
+        if (!prev) break;
+        Cost value = best[size_t(mask) * N + j];
+        for (uint32_t ks = prev; ks; ks &= ks - 1) {
+            int k = __builtin_ctz(ks);
+            if ((Cost)(best[size_t(prev) * N + k] + into[j][k]) == value) {
+                j = k;
+                break;
+            }
+        }
+        mask = prev;
     }
-    
-    if (dp[mask][pos] != -1)
-        return dp[mask][pos];
-    
-    int ans = INT_MAX;
-    
-    for (int city = 0; city < n; city++) {
-        if ((mask & (1 << city)) == 0) {
-            int newCost = dist[pos][city] + tspDP(mask | (1 << city), city);
-            ans = min(ans, newCost);
+    reversed.push_back(0);
+    tour.order.assign(reversed.rbegin(), reversed.rend());
+    return tour;
+}
+
+// Picks 16-, 32- or 64-bit entries; any path costs at most n * max(dist)
+Tour solve(const vector<vector<uint64_t>>& dist, unsigned threads) {
+    uint64_t maxEdge = 0;
+    for (auto& row : dist) for (uint64_t d : row) maxEdge = max(maxEdge, d);
+    uint64_t bound = maxEdge * dist.size();
+    if (bound < numeric_limits<uint16_t>::max()) return heldKarp<uint16_t>(dist, threads);
+    if (bound < numeric_limits<uint32_t>::max()) return heldKarp<uint32_t>(dist, threads);
+    return heldKarp<uint64_t>(dist, threads);
+}
+
+size_t tableBytes(int n, uint64_t maxEdge) {
+    uint64_t bound = maxEdge * n;
+    size_t width = bound < numeric_limits<uint16_t>::max() ? 2 : bound < numeric_limits<uint32_t>::max() ? 4 : 8;
+    return n <= 1 ? 0 : (size_t(1) << (n - 1)) * (n - 1) * width;
+}
+
+int runBenchmark(int maxN, unsigned threads) {
+    mt19937 rng(17);
+    cout << "{\"algorithm\":\"TSP\",\"mode\":\"benchmark\",\"threads\":" << threads << ",\"results\":[";
+    for (int n = 4; n <= maxN; n++) {
+        // Random points on a 1000 x 1000 grid, Manhattan distances (fit in 16 bits up to n = 32)
+        vector<int> x(n), y(n);
+        for (int i = 0; i < n; i++) {
+            x[i] = rng() % 1000;
+            y[i] = rng() % 1000;
+        }
+        vector<vector<uint64_t>> dist(n, vector<uint64_t>(n));
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) dist[i][j] = abs(x[i] - x[j]) + abs(y[i] - y[j]);
         }
+        auto start = chrono::steady_clock::now();
+        Tour tour = solve(dist, threads);
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        if (n > 4) cout << ",";
+        cout << "{\"cities\":" << n << ",\"minCost\":" << tour.cost << ",\"storageBits\":" << tour.storageBits
+             << ",\"tableBytes\":" << tour.tableBytes << ",\"seconds\":" << seconds << "}";
     }
-    
-    return dp[mask][pos] = ans;
+    cout << "]}" << endl;
+    return 0;
 }
 
 int main(int argc, char* argv[]) {
+    fillBinomials();
+    unsigned hardware = max(1u, thread::hardware_concurrency());
+    if (argc >= 2 && string(argv[1]) == "bench") {
+        return runBenchmark(argc >= 3 ? stoi(argv[2]) : 20, argc >= 4 ? stoul(argv[3]) : hardware);
+    }
     if (argc < 2) {
-        cout << "{\"error\":\"Usage: ./TSP <matrix>\"}" << endl;
+        cout << "{\"error\":\"Usage: ./TSP <matrix> [threads] [memoryLimitMB] | ./TSP bench [maxCities] [threads]\"}" << endl;
         return 1;
     }
-    
+
     string matrixStr = argv[1];
+    unsigned threads = argc >= 3 ? stoul(argv[2]) : hardware;
+    size_t memoryLimit = (argc >= 4 ? stoull(argv[3]) : 4096) << 20;
     stringstream ss(matrixStr);
-    
+
     // Parse: "4;0,10,15,20;10,0,35,25;15,35,0,30;20,25,30,0"
     string token;
     getline(ss, token, ';');
-    n = stoi(token);
-    
-    dist.assign(n, vector<int>(n));
-    
+    int n = stoi(token);
+    if (n < 1 || n > MAX_CITIES) {
+        cout << "{\"error\":\"Held-Karp supports 1 to " << MAX_CITIES << " cities\"}" << endl;
+        return 1;
+    }
+
+    vector<vector<uint64_t>> dist(n, vector<uint64_t>(n));
+    uint64_t maxEdge = 0;
     for (int i = 0; i < n; i++) {
         getline(ss, token, ';');
         stringstream rowSS(token);
         string val;
         for (int j = 0; j < n; j++) {
             getline(rowSS, val, ',');
-            dist[i][j] = stoi(val);
+            dist[i][j] = stoull(val);
+            maxEdge = max(maxEdge, dist[i][j]);
         }
     }
-    
-    memset(dp, -1, sizeof(dp));
-    int minCost = tspDP(1, 0);
-    
+
+    if (tableBytes(n, maxEdge) > memoryLimit) {
+        cout << "{\"error\":\"Held-Karp table for " << n << " cities needs " << tableBytes(n, maxEdge)
+             << " bytes, over the " << (memoryLimit >> 20) << " MB limit\"}" << endl;
+        return 1;
+    }
+
+    auto start = chrono::steady_clock::now();
+    Tour tour = solve(dist, threads);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
     // Output JSON
-    cout << "{\"algorithm\":\"TSP\",\"cities\":" << n << ",\"minCost\":" << minCost << "}" << endl;
-    
+    cout << "{\"algorithm\":\"TSP\",\"cities\":" << n << ",\"minCost\":" << tour.cost << ",\"tour\":[";
+    for (size_t i = 0; i < tour.order.size(); i++) {
+        if (i > 0) cout << ",";
+        cout << tour.order[i];
+    }
+    cout << "],\"storageBits\":" << tour.storageBits << ",\"tableBytes\":" << tour.tableBytes
+         << ",\"threads\":" << threads << ",\"seconds\":" << seconds << "}" << endl;
+
     return 0;
 }
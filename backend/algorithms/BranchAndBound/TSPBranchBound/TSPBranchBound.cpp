@@ -0,0 +1,731 @@
+#include <iostream>
+#include <vector>
+#include <sstream>
+#include <string>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <queue>
+#include <memory>
+#include <cmath>
+#include <limits>
+#include <cstdint>
+#include "../../common/TourSearch.h"
+using namespace std;
+
+// Exact branch and bound for symmetric TSP, for sizes past Held-Karp (TSP.cpp).
+//  - bound: Held-Karp 1-tree (minimum spanning tree on cities 1..n-1 plus the
+//    two cheapest edges at city 0) under node penalties pi, tightened by
+//    subgradient ascent. Children start from their parent's pi, so a few
+//    steps suffice below the root.
+//  - branching: Volgenant-Jonker on a city v of 1-tree degree > 2 with free
+//    tree edges e1, e2: {exclude e1}, {include e1, exclude e2}, {include both}.
+//    Included/excluded edges are propagated (degree 2 closes a city, a forced
+//    path may not close early), and fed to the 1-tree as hard constraints.
+//  - search: threads take the lowest-bound open node and dive depth first
+//    through its best child, pushing the siblings back; open nodes live in a
+//    block pool so records are recycled instead of reallocated.
+//  - incumbent: seeded by greedy + 2-opt/Or-opt + kicks from TourSearch.h and
+//    shared as an atomic, so every thread prunes against the best tour found.
+
+typedef chrono::steady_clock Clock;
+
+struct Matrix {
+    int n;
+    vector<long long> d;
+    long long operator()(int a, int b) const { return d[(size_t)a * n + b]; }
+};
+
+// Edge sets are n*n bitsets, both (i, j) and (j, i) set
+inline bool test(const uint64_t* bits, size_t i) { return bits[i >> 6] >> (i & 63) & 1; }
+inline void mark(uint64_t* bits, int n, int a, int b) {
+    size_t i = (size_t)a * n + b, j = (size_t)b * n + a;
+    bits[i >> 6] |= uint64_t(1) << (i & 63);
+    bits[j >> 6] |= uint64_t(1) << (j & 63);
+}
+
+// A search node: penalties plus included/excluded edge bitsets
+struct Node {
+    vector<double> pi;
+    vector<uint64_t> inc, exc;
+    Node(int n, int words) : pi(n, 0.0), inc(words, 0), exc(words, 0) {}
+};
+
+// Fixed-size records for open nodes, carved from blocks that never move.
+// Released records are reused first. Callers serialise allocate/release.
+class NodePool {
+    static const size_t BLOCK = 1024;
+    int n, words;
+    vector<unique_ptr<double[]>> penalties;
+    vector<unique_ptr<uint64_t[]>> bits;
+    vector<uint32_t> freed;
+    size_t next = 0;
+
+public:
+    NodePool(int n, int words, size_t maxRecords)
+        : n(n), words(words), penalties((maxRecords + BLOCK - 1) / BLOCK), bits(penalties.size()) {}
+
+    static size_t recordBytes(int n, int words) { return n * sizeof(double) + 2 * words * sizeof(uint64_t); }
+    size_t records() const { return next; }
+
+    bool allocate(uint32_t& id) {
+        if (!freed.empty()) {
+            id = freed.back();
+            freed.pop_back();
+            return true;
+        }
+        size_t block = next / BLOCK;
+        if (block >= penalties.size()) return false;
+        if (!penalties[block]) {
+            penalties[block].reset(new double[BLOCK * n]);
+            bits[block].reset(new uint64_t[BLOCK * 2 * words]);
+        }
+        id = next++;
+        return true;
+    }
+    void release(uint32_t id) { freed.push_back(id); }
+
+    void store(uint32_t id, const Node& node) {
+        copy(node.pi.begin(), node.pi.end(), &penalties[id / BLOCK][(id % BLOCK) * n]);
+        uint64_t* b = &bits[id / BLOCK][(id % BLOCK) * 2 * words];
+        copy(node.inc.begin(), node.inc.end(), b);
+        copy(node.exc.begin(), node.exc.end(), b + words);
+    }
+    void load(uint32_t id, Node& node) const {
+        const double* p = &penalties[id / BLOCK][(id % BLOCK) * n];
+        copy(p, p + n, node.pi.begin());
+        const uint64_t* b = &bits[id / BLOCK][(id % BLOCK) * 2 * words];
+        copy(b, b + words, node.inc.begin());
+        copy(b + words, b + 2 * words, node.exc.begin());
+    }
+};
+
+// Closes cities with two included edges, forbids the edge that would close a
+// forced path early, and checks every city still has two usable edges.
+// Returns false when the constraints admit no tour.
+bool propagate(int n, Node& node, vector<int>& deg, vector<char>& seen) {
+    for (;;) {
+        bool changed = false;
+        for (int v = 0; v < n; v++) {
+            deg[v] = 0;
+            for (int j = 0; j < n; j++) deg[v] += test(node.inc.data(), (size_t)v * n + j);
+            if (deg[v] > 2) return false;
+        }
+        for (int v = 0; v < n; v++) {
+            if (deg[v] != 2) continue;
+            for (int j = 0; j < n; j++) {
+                size_t e = (size_t)v * n + j;
+                if (j != v && !test(node.inc.data(), e) && !test(node.exc.data(), e)) {
+                    mark(node.exc.data(), n, v, j);
+                    changed = true;
+                }
+            }
+        }
+        fill(seen.begin(), seen.end(), 0);
+        auto walk = [&](int from, int& length) {
+            int prev = -1, cur = from;
+            length = 0;
+            for (;;) {
+                seen[cur] = 1;
+                int next = -1;
+                for (int j = 0; j < n && next < 0; j++) {
+                    if (j != prev && j != cur && test(node.inc.data(), (size_t)cur * n + j)) next = j;
+                }
+                if (next < 0 || next == from) return cur;
+                prev = cur;
+                cur = next;
+                length++;
+            }
+        };
+        for (int v = 0; v < n; v++) {
+            if (deg[v] != 1 || seen[v]) continue;
+            int length, end = walk(v, length);
+            if (length >= 2 && length < n - 1 && !test(node.exc.data(), (size_t)v * n + end)) {
+                mark(node.exc.data(), n, v, end);
+                changed = true;
+            }
+        }
+        for (int v = 0; v < n; v++) {
+            if (deg[v] != 2 || seen[v]) continue;
+            int length;
+            walk(v, length);
+            if (length + 1 < n) return false;   // forced cycle shorter than a tour
+        }
+        for (int v = 0; v < n; v++) {
+            int usable = 0;
+            for (int j = 0; j < n; j++) usable += j != v && !test(node.exc.data(), (size_t)v * n + j);
+            if (usable < 2) return false;
+        }
+        if (!changed) return true;
+    }
+}
+
+// Constrained 1-tree and subgradient ascent; one per thread
+class OneTree {
+    const Matrix& dist;
+    int n;
+    vector<double> key, bestPi;
+    vector<char> forcedKey, inTree;
+    vector<int> parent;
+
+public:
+    vector<int> degree;
+    vector<pair<int, int>> edges;
+
+    OneTree(const Matrix& dist) : dist(dist), n(dist.n), key(n), bestPi(n), forcedKey(n), inTree(n), parent(n), degree(n) {}
+
+    // Prim on 1..n-1 with included edges ranked ahead of everything, excluded
+    // edges absent; then city 0's two edges. False if no 1-tree exists.
+    bool build(const Node& node, double& value) {
+        const uint64_t* inc = node.inc.data();
+        const uint64_t* exc = node.exc.data();
+        const double* pi = node.pi.data();
+        auto weight = [&](int a, int b) { return dist(a, b) + pi[a] + pi[b]; };
+        edges.clear();
+        fill(degree.begin(), degree.end(), 0);
+        fill(inTree.begin(), inTree.end(), 0);
+        value = 0;
+        auto offer = [&](int from, int v) {
+            size_t e = (size_t)from * n + v;
+            if (test(exc, e)) return;
+            bool f = test(inc, e);
+            double w = weight(from, v);
+            if (parent[v] < 0 || f > forcedKey[v] || (f == forcedKey[v] && w < key[v])) {
+                parent[v] = from;
+                key[v] = w;
+                forcedKey[v] = f;
+            }
+        };
+        fill(parent.begin(), parent.end(), -1);
+        inTree[1] = 1;
+        for (int v = 2; v < n; v++) offer(1, v);
+        for (int step = 2; step < n; step++) {
+            int pick = -1;
+            for (int v = 2; v < n; v++) {
+                if (inTree[v] || parent[v] < 0) continue;
+                if (pick < 0 || forcedKey[v] > forcedKey[pick] || (forcedKey[v] == forcedKey[pick] && key[v] < key[pick])) pick = v;
+            }
+            if (pick < 0) return false;
+            inTree[pick] = 1;
+            edges.push_back({parent[pick], pick});
+            value += key[pick];
+            for (int v = 2; v < n; v++) {
+                if (!inTree[v]) offer(pick, v);
+            }
+        }
+        // City 0: included edges first, then the cheapest allowed
+        int first = -1, second = -1;
+        for (int v = 1; v < n; v++) {
+            if (!test(inc, v)) continue;
+            (first < 0 ? first : second) = v;
+        }
+        while (second < 0) {
+            int pick = -1;
+            for (int u = 1; u < n; u++) {
+                if (u == first || test(exc, u)) continue;
+                if (pick < 0 || weight(0, u) < weight(0, pick)) pick = u;
+            }
+            if (pick < 0) return false;
+            (first < 0 ? first : second) = pick;
+        }
+        edges.push_back({0, first});
+        edges.push_back({0, second});
+        value += weight(0, first) + weight(0, second);
+        for (auto& e : edges) {
+            degree[e.first]++;
+            degree[e.second]++;
+        }
+        for (int v = 0; v < n; v++) value -= 2 * pi[v];
+        return true;
+    }
+
+    // Subgradient ascent from node.pi for a number of steps (Polyak step
+    // toward the incumbent, halved after `patience` steps without progress).
+    // Leaves the best pi in node.pi. Returns false if the node is infeasible;
+    // isTour is set when a 1-tree turned out to be a tour (bound is exact).
+    bool ascend(Node& node, int steps, double lambda, int patience, const atomic<long long>& incumbent,
+                double& bound, bool& isTour) {
+        isTour = false;
+        bound = -1e300;
+        int stale = 0;
+        for (int it = 0; it < steps; it++) {
+            double value;
+            if (!build(node, value)) return false;
+            if (value > bound + 1e-9) {
+                bound = value;
+                copy(node.pi.begin(), node.pi.end(), bestPi.begin());
+                stale = 0;
+            } else if (++stale >= patience) {
+                lambda /= 2;
+                stale = 0;
+            }
+            long long norm = 0;
+            for (int v = 0; v < n; v++) norm += (long long)(degree[v] - 2) * (degree[v] - 2);
+            if (norm == 0) {
+                isTour = true;
+                bound = value;
+                return true;
+            }
+            long long upper = incumbent.load(memory_order_relaxed);
+            if (ceil(bound - 1e-7) >= upper) break;
+            double t = lambda * (upper - value) / norm;
+            for (int v = 0; v < n; v++) node.pi[v] += t * (degree[v] - 2);
+        }
+        copy(bestPi.begin(), bestPi.end(), node.pi.begin());
+        return true;
+    }
+
+    // Only valid right after build() produced a tour
+    vector<int> tourOrder(long long& cost) const {
+        vector<vector<int>> adj(n);
+        for (auto& e : edges) {
+            adj[e.first].push_back(e.second);
+            adj[e.second].push_back(e.first);
+        }
+        vector<int> order = {0};
+        cost = 0;
+        for (int prev = -1, cur = 0; (int)order.size() < n;) {
+            int next = adj[cur][0] == prev ? adj[cur][1] : adj[cur][0];
+            cost += dist(cur, next);
+            prev = cur;
+            cur = next;
+            order.push_back(cur);
+        }
+        cost += dist(order.back(), 0);
+        return order;
+    }
+};
+
+struct Stats {
+    long long minCost = 0, heuristicCost = 0, lowerBound = 0;
+    double rootBound = 0;
+    vector<int> tour;
+    bool optimal = true;
+    string stopReason;
+    uint64_t explored = 0, pruned = 0;
+    size_t maxOpen = 0, poolRecords = 0;
+    double heuristicSeconds = 0, searchSeconds = 0;
+};
+
+class BranchAndBound {
+    struct Open {
+        double bound;
+        int depth;
+        uint32_t id;
+        // Lowest bound first; deeper first on ties
+        bool operator<(const Open& o) const { return bound != o.bound ? bound > o.bound : depth < o.depth; }
+    };
+
+    const Matrix& dist;
+    int n, words;
+    unsigned threads;
+    Clock::time_point deadline;
+    NodePool pool;
+    priority_queue<Open> open;
+    mutex lock, tourLock;
+    condition_variable ready;
+    int busy = 0;
+    bool stop = false;
+    string stopReason;
+    double lostBound = 1e300;   // bound of nodes dropped when the pool ran out
+    size_t maxOpen = 0;
+    atomic<long long> incumbent;
+    vector<int> bestTour;
+    atomic<uint64_t> explored{0}, pruned{0};
+
+    bool hopeless(double bound) const { return ceil(bound - 1e-7) >= incumbent.load(memory_order_relaxed); }
+
+    void offer(long long cost, const vector<int>& tour) {
+        lock_guard<mutex> guard(tourLock);
+        if (cost < incumbent.load()) {
+            incumbent.store(cost);
+            bestTour = tour;
+        }
+    }
+
+    // Caller holds lock
+    void push(const Node& node, double bound, int depth) {
+        uint32_t id;
+        if (!pool.allocate(id)) {
+            lostBound = min(lostBound, bound);
+            stop = true;
+            stopReason = "memory";
+            ready.notify_all();
+            return;
+        }
+        pool.store(id, node);
+        open.push({bound, depth, id});
+        maxOpen = max(maxOpen, open.size());
+        ready.notify_one();
+    }
+
+    // Bounds a freshly constrained child; false if it is fathomed
+    bool evaluate(OneTree& tree, Node& child, double& bound, vector<int>& deg, vector<char>& seen) {
+        explored.fetch_add(1, memory_order_relaxed);
+        bool isTour;
+        if (!propagate(n, child, deg, seen) || !tree.ascend(child, 12 + n / 4, 0.1, 4, incumbent, bound, isTour)) {
+            pruned.fetch_add(1, memory_order_relaxed);
+            return false;
+        }
+        if (isTour) {
+            long long cost;
+            vector<int> order = tree.tourOrder(cost);
+            offer(cost, order);
+            return false;
+        }
+        if (hopeless(bound)) {
+            pruned.fetch_add(1, memory_order_relaxed);
+            return false;
+        }
+        return true;
+    }
+
+    void dive(OneTree& tree, Node& node, double bound, int depth, vector<Node>& kids, vector<int>& deg, vector<char>& seen) {
+        for (;;) {
+            if (hopeless(bound)) {
+                pruned.fetch_add(1, memory_order_relaxed);
+                return;
+            }
+            if (Clock::now() >= deadline) {
+                lock_guard<mutex> guard(lock);
+                push(node, bound, depth);
+                stop = true;
+                if (stopReason.empty()) stopReason = "time";
+                ready.notify_all();
+                return;
+            }
+            double value;
+            tree.build(node, value);
+            if (*max_element(tree.degree.begin(), tree.degree.end()) <= 2) {
+                long long cost;
+                vector<int> order = tree.tourOrder(cost);
+                offer(cost, order);
+                return;
+            }
+            // Branch on the city of highest degree, its two dearest free edges
+            int v = max_element(tree.degree.begin(), tree.degree.end()) - tree.degree.begin();
+            vector<pair<double, int>> free;
+            int forced = 0;
+            for (auto& e : tree.edges) {
+                if (e.first != v && e.second != v) continue;
+                int u = e.first == v ? e.second : e.first;
+                if (test(node.inc.data(), (size_t)v * n + u)) forced++;
+                else free.push_back({dist(v, u) + node.pi[u], u});
+            }
+            sort(free.rbegin(), free.rend());
+            int e1 = free[0].second, e2 = free[1].second;
+
+            int count = forced == 0 ? 3 : 2;
+            double bounds[3];
+            bool alive[3];
+            for (int c = 0; c < count; c++) {
+                Node& child = kids[c];
+                child = node;
+                if (c == 0) mark(child.exc.data(), n, v, e1);
+                else {
+                    mark(child.inc.data(), n, v, e1);
+                    if (count == 3) mark((c == 1 ? child.exc : child.inc).data(), n, v, e2);
+                }
+                alive[c] = evaluate(tree, child, bounds[c], deg, seen);
+            }
+            int best = -1;
+            for (int c = 0; c < count; c++) {
+                if (alive[c] && (best < 0 || bounds[c] < bounds[best])) best = c;
+            }
+            if (best < 0) return;
+            {
+                lock_guard<mutex> guard(lock);
+                for (int c = 0; c < count; c++) {
+                    if (alive[c] && c != best) push(kids[c], bounds[c], depth + 1);
+                }
+                // The search has stopped: keep the child we would otherwise
+                // have dived into, so the reported lower bound still covers it
+                if (stop) {
+                    push(kids[best], bounds[best], depth + 1);
+                    return;
+                }
+            }
+            swap(node, kids[best]);
+            bound = bounds[best];
+            depth++;
+        }
+    }
+
+    void worker() {
+        OneTree tree(dist);
+        Node node(n, words);
+        vector<Node> kids(3, Node(n, words));
+        vector<int> deg(n);
+        vector<char> seen(n);
+        unique_lock<mutex> guard(lock);
+        for (;;) {
+            ready.wait(guard, [&] { return stop || !open.empty() || busy == 0; });
+            if (stop || open.empty()) break;
+            Open top = open.top();
+            open.pop();
+            pool.load(top.id, node);
+            pool.release(top.id);
+            if (hopeless(top.bound)) {
+                pruned.fetch_add(1, memory_order_relaxed);
+                continue;
+            }
+            busy++;
+            guard.unlock();
+            dive(tree, node, top.bound, top.depth, kids, deg, seen);
+            guard.lock();
+            busy--;
+            if (busy == 0 && open.empty()) ready.notify_all();
+        }
+        ready.notify_all();
+    }
+
+public:
+    bool polish = true;   // false seeds with the bare greedy tour
+
+    BranchAndBound(const Matrix& dist, unsigned threads, double budget, size_t memoryBytes)
+        : dist(dist), n(dist.n), words(((size_t)dist.n * dist.n + 63) / 64), threads(max(1u, threads)),
+          deadline(Clock::now() + chrono::duration_cast<Clock::duration>(chrono::duration<double>(budget))),
+          pool(n, words, memoryBytes / NodePool::recordBytes(n, words)) {}
+
+    Stats run() {
+        Stats stats;
+        auto start = Clock::now();
+
+        // Incumbent: greedy tour, local search, then a fixed number of kicks
+        vector<vector<int>> cand = toursearch::nearestByScan(n, min(10, n - 1), dist);
+        toursearch::LocalSearch<Matrix> search(dist, cand, toursearch::greedyTour(n, dist, cand));
+        if (polish) {
+            search.optimizeAll();
+            mt19937 rng(7);
+            size_t kicks = 0;
+            toursearch::iterateKicks(search, rng, [&] { return kicks++ < (size_t)100 * n; },
+                                     [](long long, const vector<int>&) {});
+        }
+        incumbent.store(search.cost);
+        bestTour = search.tour();
+        stats.heuristicCost = search.cost;
+        stats.heuristicSeconds = chrono::duration<double>(Clock::now() - start).count();
+
+        // Root: a long ascent from pi = 0
+        OneTree tree(dist);
+        Node root(n, words);
+        vector<int> deg(n);
+        vector<char> seen(n);
+        double bound = 0;
+        bool isTour = false;
+        propagate(n, root, deg, seen);
+        tree.ascend(root, 50 * n, 2.0, max(10, n / 2), incumbent, bound, isTour);
+        explored = 1;
+        stats.rootBound = bound;
+        if (isTour) {
+            long long cost;
+            vector<int> order = tree.tourOrder(cost);
+            offer(cost, order);
+        } else if (!hopeless(bound)) {
+            push(root, bound, 0);
+            vector<thread> workers;
+            for (unsigned t = 0; t < threads; t++) workers.emplace_back([this]() { worker(); });
+            for (auto& w : workers) w.join();
+        }
+
+        stats.minCost = incumbent.load();
+        stats.tour = bestTour;
+        stats.optimal = !stop;
+        stats.stopReason = stopReason;
+        double lower = lostBound;
+        if (!open.empty()) lower = min(lower, open.top().bound);
+        stats.lowerBound = stop ? min<long long>(stats.minCost, (long long)ceil(lower - 1e-7)) : stats.minCost;
+        stats.explored = explored.load();
+        stats.pruned = pruned.load();
+        stats.maxOpen = maxOpen;
+        stats.poolRecords = pool.records();
+        stats.searchSeconds = chrono::duration<double>(Clock::now() - start).count() - stats.heuristicSeconds;
+        return stats;
+    }
+};
+
+Stats solve(const Matrix& dist, unsigned threads, double budget, size_t memoryBytes, bool polish = true) {
+    if (dist.n <= 3) {
+        Stats stats;
+        for (int i = 0; i < dist.n; i++) stats.tour.push_back(i);
+        stats.minCost = stats.heuristicCost = stats.lowerBound = toursearch::tourLength(stats.tour, dist);
+        stats.rootBound = stats.minCost;
+        return stats;
+    }
+    BranchAndBound search(dist, threads, budget, memoryBytes);
+    search.polish = polish;
+    return search.run();
+}
+
+// Random points on a 1000 x 1000 square, rounded Euclidean distances
+Matrix randomInstance(int n, unsigned seed) {
+    mt19937 rng(seed);
+    vector<double> x(n), y(n);
+    for (int i = 0; i < n; i++) {
+        x[i] = rng() % 1000;
+        y[i] = rng() % 1000;
+    }
+    Matrix dist{n, vector<long long>((size_t)n * n)};
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) dist.d[(size_t)i * n + j] = llround(hypot(x[i] - x[j], y[i] - y[j]));
+    }
+    return dist;
+}
+
+void printStats(const Stats& s) {
+    double seconds = s.heuristicSeconds + s.searchSeconds;
+    double rate = s.searchSeconds > 0 ? 1 / s.searchSeconds : 0;
+    cout << "\"minCost\":" << s.minCost << ",\"optimal\":" << (s.optimal ? "true" : "false");
+    if (!s.optimal) cout << ",\"stoppedBy\":\"" << s.stopReason << "\"";
+    cout << ",\"lowerBound\":" << s.lowerBound << ",\"rootBound\":" << s.rootBound
+         << ",\"heuristicCost\":" << s.heuristicCost << ",\"nodesExplored\":" << s.explored
+         << ",\"nodesPruned\":" << s.pruned << ",\"nodesPerSecond\":" << s.explored * rate
+         << ",\"prunedPerSecond\":" << s.pruned * rate << ",\"maxOpenNodes\":" << s.maxOpen
+         << ",\"poolRecords\":" << s.poolRecords << ",\"heuristicSeconds\":" << s.heuristicSeconds
+         << ",\"seconds\":" << seconds;
+}
+
+int runBenchmark(int minN, int maxN, unsigned threads, double budget) {
+    cout << "{\"algorithm\":\"TSP Branch and Bound\",\"mode\":\"benchmark\",\"threads\":" << threads << ",\"results\":[";
+    for (int n = minN; n <= maxN; n += 5) {
+        Stats s = solve(randomInstance(n, 100 + n), threads, budget, size_t(1024) << 20);
+        if (n > minN) cout << ",";
+        cout << "{\"cities\":" << n << ",";
+        printStats(s);
+        cout << "}";
+    }
+    cout << "]}" << endl;
+    return 0;
+}
+
+// Plain Held-Karp as in TSP.cpp, small enough to serve as a reference
+long long heldKarp(const Matrix& dist) {
+    int N = dist.n - 1;
+    const long long INF = numeric_limits<long long>::max() / 2;
+    vector<long long> best(((size_t)1 << N) * N, INF);
+    for (int j = 0; j < N; j++) best[((size_t)1 << j) * N + j] = dist(0, j + 1);
+    for (size_t mask = 1; mask < ((size_t)1 << N); mask++) {
+        for (int j = 0; j < N; j++) {
+            long long here = best[mask * N + j];
+            if (!(mask >> j & 1) || here >= INF) continue;
+            for (int k = 0; k < N; k++) {
+                if (mask >> k & 1) continue;
+                long long& next = best[(mask | (size_t)1 << k) * N + k];
+                next = min(next, here + dist(j + 1, k + 1));
+            }
+        }
+    }
+    long long cost = INF;
+    for (int j = 0; j < N; j++) cost = min(cost, best[(((size_t)1 << N) - 1) * N + j] + dist(j + 1, 0));
+    return cost;
+}
+
+// Differential check against Held-Karp on random symmetric matrices with
+// small integer weights, where ties and forced paths are common. The search
+// starts from the bare greedy tour so a wrong bound shows up as a wrong cost
+// instead of hiding behind an already optimal incumbent.
+int runCheck(int instances, int cities, unsigned threads) {
+    int mismatches = 0;
+    long long firstSeed = -1;
+    for (int i = 0; i < instances; i++) {
+        mt19937 rng(410 + i);
+        int n = 4 + rng() % (cities - 3);
+        Matrix dist{n, vector<long long>((size_t)n * n, 0)};
+        for (int a = 0; a < n; a++) {
+            for (int b = 0; b < a; b++) dist.d[(size_t)a * n + b] = dist.d[(size_t)b * n + a] = 1 + rng() % 50;
+        }
+        Stats s = solve(dist, threads, 60.0, size_t(256) << 20, false);
+        long long exact = heldKarp(dist);
+        if (s.minCost != exact || !s.optimal || s.lowerBound > exact) {
+            mismatches++;
+            if (firstSeed < 0) firstSeed = 410 + i;
+        }
+    }
+    cout << "{\"algorithm\":\"TSP Branch and Bound\",\"mode\":\"check\",\"instances\":" << instances
+         << ",\"maxCities\":" << cities << ",\"mismatches\":" << mismatches;
+    if (firstSeed >= 0) cout << ",\"firstMismatchSeed\":" << firstSeed;
+    cout << "}" << endl;
+    return mismatches == 0 ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+    unsigned threads = max(1u, thread::hardware_concurrency());
+    double budget = 60.0;
+    size_t memoryMB = 1024;
+    vector<string> args;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) threads = max(1, stoi(argv[++i]));
+        else if (arg == "--time" && i + 1 < argc) budget = stod(argv[++i]) / 1000.0;
+        else if (arg == "--memory" && i + 1 < argc) memoryMB = stoull(argv[++i]);
+        else args.push_back(arg);
+    }
+
+    if (!args.empty() && args[0] == "bench") {
+        return runBenchmark(args.size() >= 2 ? stoi(args[1]) : 30, args.size() >= 3 ? stoi(args[2]) : 60, threads,
+                            budget);
+    }
+    if (!args.empty() && args[0] == "check") {
+        int cities = args.size() >= 3 ? stoi(args[2]) : 13;
+        if (cities < 4 || cities > 18) {
+            cout << "{\"error\":\"check needs 4..18 cities for the Held-Karp reference\"}" << endl;
+            return 1;
+        }
+        return runCheck(args.size() >= 2 ? stoi(args[1]) : 1000, cities, threads);
+    }
+    if (args.empty()) {
+        cout << "{\"error\":\"Usage: ./TSPBranchBound <matrix | --random n [seed]> [--threads t] [--time ms] "
+                "[--memory MB] | ./TSPBranchBound bench [minCities] [maxCities] [--time ms] | ./TSPBranchBound check "
+                "[instances] [maxCities]\"}" << endl;
+        return 1;
+    }
+
+    Matrix dist;
+    if (args[0] == "--random") {
+        dist = randomInstance(args.size() >= 2 ? stoi(args[1]) : 40, args.size() >= 3 ? stoul(args[2]) : 1);
+    } else {
+        // Parse: "4;0,10,15,20;10,0,35,25;15,35,0,30;20,25,30,0"
+        stringstream ss(args[0]);
+        string token;
+        getline(ss, token, ';');
+        dist.n = stoi(token);
+        if (dist.n < 1) {
+            cout << "{\"error\":\"No cities given\"}" << endl;
+            return 1;
+        }
+        dist.d.assign((size_t)dist.n * dist.n, 0);
+        for (int i = 0; i < dist.n; i++) {
+            getline(ss, token, ';');
+            stringstream rowSS(token);
+            string val;
+            for (int j = 0; j < dist.n; j++) {
+                getline(rowSS, val, ',');
+                dist.d[(size_t)i * dist.n + j] = stoll(val);
+            }
+        }
+        for (int i = 0; i < dist.n; i++) {
+            for (int j = 0; j < i; j++) {
+                if (dist(i, j) != dist(j, i)) {
+                    cout << "{\"error\":\"The 1-tree bound needs a symmetric matrix; use TSP for asymmetric instances\"}" << endl;
+                    return 1;
+                }
+            }
+        }
+    }
+
+    Stats s = solve(dist, threads, budget, memoryMB << 20);
+
+    // Output JSON; the tour starts and ends at city 0 like TSP.cpp
+    vector<int>& t = s.tour;
+    rotate(t.begin(), find(t.begin(), t.end(), 0), t.end());
+    cout << "{\"algorithm\":\"TSP Branch and Bound\",\"cities\":" << dist.n << ",\"tour\":[";
+    for (int c : t) cout << c << ",";
+    cout << "0],";
+    printStats(s);
+    cout << ",\"threads\":" << threads << "}" << endl;
+    return 0;
+}
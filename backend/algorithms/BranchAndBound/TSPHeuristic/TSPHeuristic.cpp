@@ -0,0 +1,273 @@
+#include <iostream>
+#include <vector>
+#include <sstream>
+#include <fstream>
+#include <string>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <mutex>
+#include <cmath>
+#include <cstdint>
+#include "../../common/TourSearch.h"
+using namespace std;
+
+// Heuristic TSP for instances far past Held-Karp (TSP.cpp). Each thread builds
+// a start tour (greedy edge matching on thread 0, nearest neighbour from a
+// random city elsewhere), runs 2-opt + Or-opt from TourSearch.h, then keeps
+// applying double-bridge kicks with local re-optimisation, keeping a kick only
+// if the tour got shorter (iterated local search, the usual cheap stand-in
+// for Lin-Kernighan).
+// Candidate lists come from a uniform grid for coordinates, or from a row scan
+// for distance matrices. Runs until the time budget is spent and reports the
+// best cost over time.
+
+typedef chrono::steady_clock Clock;
+
+// Coordinates, TSPLIB EUC_2D distances (rounded Euclidean)
+struct PointDist {
+    vector<double> x, y;
+    long long operator()(int a, int b) const {
+        double dx = x[a] - x[b], dy = y[a] - y[b];
+        return llround(sqrt(dx * dx + dy * dy));
+    }
+};
+
+struct MatrixDist {
+    int n;
+    vector<long long> d;
+    long long operator()(int a, int b) const { return d[(size_t)a * n + b]; }
+};
+
+// k nearest neighbours on a grid with about two points per cell: search rings
+// of cells outward until the ring is farther away than the current k-th best
+vector<vector<int>> nearestByGrid(const PointDist& pts, int k) {
+    int n = pts.x.size();
+    k = min(k, n - 1);
+    vector<vector<int>> cand(n);
+    if (k <= 0) return cand;
+    double minX = *min_element(pts.x.begin(), pts.x.end()), maxX = *max_element(pts.x.begin(), pts.x.end());
+    double minY = *min_element(pts.y.begin(), pts.y.end()), maxY = *max_element(pts.y.begin(), pts.y.end());
+    int side = max(1, (int)sqrt(n / 2.0));
+    double cw = max((maxX - minX) / side, 1e-9), ch = max((maxY - minY) / side, 1e-9);
+    auto cellOf = [&](int p, int& cx, int& cy) {
+        cx = min(side - 1, (int)((pts.x[p] - minX) / cw));
+        cy = min(side - 1, (int)((pts.y[p] - minY) / ch));
+    };
+    vector<vector<int>> cells(side * side);
+    for (int p = 0; p < n; p++) {
+        int cx, cy;
+        cellOf(p, cx, cy);
+        cells[cy * side + cx].push_back(p);
+    }
+
+    vector<pair<double, int>> heap;
+    for (int p = 0; p < n; p++) {
+        int cx, cy;
+        cellOf(p, cx, cy);
+        heap.clear();
+        auto consider = [&](int q) {
+            if (q == p) return;
+            double dx = pts.x[p] - pts.x[q], dy = pts.y[p] - pts.y[q];
+            double d = dx * dx + dy * dy;
+            if ((int)heap.size() < k) {
+                heap.push_back({d, q});
+                push_heap(heap.begin(), heap.end());
+            } else if (d < heap.front().first) {
+                pop_heap(heap.begin(), heap.end());
+                heap.back() = {d, q};
+                push_heap(heap.begin(), heap.end());
+            }
+        };
+        for (int r = 0; r < side; r++) {
+            if ((int)heap.size() == k) {
+                // Everything in ring r is at least (r - 1) cells away
+                double reach = (r - 1) * min(cw, ch);
+                if (reach > 0 && reach * reach > heap.front().first) break;
+            }
+            for (int gy = cy - r; gy <= cy + r; gy++) {
+                if (gy < 0 || gy >= side) continue;
+                for (int gx = cx - r; gx <= cx + r; gx++) {
+                    if (gx < 0 || gx >= side) continue;
+                    if (max(abs(gx - cx), abs(gy - cy)) != r) continue;
+                    for (int q : cells[gy * side + gx]) consider(q);
+                }
+            }
+        }
+        sort_heap(heap.begin(), heap.end());
+        for (auto& e : heap) cand[p].push_back(e.second);
+    }
+    return cand;
+}
+
+struct Progress {
+    mutex lock;
+    long long bestCost = -1;
+    vector<int> bestTour;
+    vector<pair<double, long long>> history;   // (seconds, cost) at every improvement
+    Clock::time_point start;
+    size_t kicks = 0;
+
+    void offer(long long cost, const vector<int>& tour) {
+        lock_guard<mutex> guard(lock);
+        if (bestCost >= 0 && cost >= bestCost) return;
+        bestCost = cost;
+        bestTour = tour;
+        history.push_back({chrono::duration<double>(Clock::now() - start).count(), cost});
+    }
+};
+
+template <typename Dist>
+void runStart(int id, const Dist& dist, const vector<vector<int>>& cand, const string& construct,
+              Clock::time_point deadline, Progress& progress) {
+    int n = cand.size();
+    mt19937 rng(1000 + id);
+    vector<int> tour = construct == "greedy" && id == 0 ? toursearch::greedyTour(n, dist, cand)
+                                                        : toursearch::nearestNeighborTour(n, id == 0 ? 0 : rng() % n, dist, cand);
+    toursearch::LocalSearch<Dist> search(dist, cand, tour);
+    search.setDeadline(deadline);
+    progress.offer(search.cost, search.tour());
+    search.optimizeAll();
+    progress.offer(search.cost, search.tour());
+    size_t kicks = toursearch::iterateKicks(search, rng, [&] { return Clock::now() < deadline; },
+                                            [&](long long cost, const vector<int>& tour) { progress.offer(cost, tour); });
+    lock_guard<mutex> guard(progress.lock);
+    progress.kicks += kicks;
+}
+
+template <typename Dist>
+void solve(const Dist& dist, const vector<vector<int>>& cand, const string& construct, double budget,
+           unsigned threads, Progress& progress) {
+    progress.start = Clock::now();
+    auto deadline = progress.start + chrono::duration_cast<Clock::duration>(chrono::duration<double>(budget));
+    vector<thread> workers;
+    for (unsigned t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() { runStart(t, dist, cand, construct, deadline, progress); });
+    }
+    for (auto& w : workers) w.join();
+}
+
+void printResult(const string& mode, int n, Progress& progress, unsigned threads, double setupSeconds, bool withTour) {
+    cout << "{\"algorithm\":\"TSP Heuristic\",\"mode\":\"" << mode << "\",\"cities\":" << n
+         << ",\"cost\":" << progress.bestCost << ",\"starts\":" << threads << ",\"kicks\":" << progress.kicks
+         << ",\"candidateSeconds\":" << setupSeconds << ",\"history\":[";
+    for (size_t h = 0; h < progress.history.size(); h++) {
+        if (h > 0) cout << ",";
+        cout << "{\"seconds\":" << progress.history[h].first << ",\"cost\":" << progress.history[h].second << "}";
+    }
+    cout << "]";
+    if (withTour) {
+        // Rotate so the tour starts and ends at city 0, like TSP.cpp
+        vector<int>& t = progress.bestTour;
+        rotate(t.begin(), find(t.begin(), t.end(), 0), t.end());
+        cout << ",\"tour\":[";
+        for (int c : t) cout << c << ",";
+        cout << (t.empty() ? "" : "0") << "]";
+    }
+    cout << "}" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    ios::sync_with_stdio(false);
+    unsigned threads = max(1u, thread::hardware_concurrency());
+    double budget = 1.0;
+    int k = 10;
+    string construct = "greedy";
+    bool withTour = true;
+    vector<string> args;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--time" && i + 1 < argc) budget = stod(argv[++i]) / 1000.0;
+        else if (arg == "--threads" && i + 1 < argc) threads = max(1, stoi(argv[++i]));
+        else if (arg == "--k" && i + 1 < argc) k = max(1, stoi(argv[++i]));
+        else if (arg == "--construct" && i + 1 < argc) construct = argv[++i];
+        else if (arg == "--no-tour") withTour = false;
+        else args.push_back(arg);
+    }
+
+    if (args.empty() || (construct != "greedy" && construct != "nn")) {
+        cout << "{\"error\":\"Usage: ./TSPHeuristic <matrix | --points x,y;x,y;... | --file path | --random n> "
+                "[--time ms] [--threads t] [--k neighbours] [--construct greedy|nn] [--no-tour]\"}" << endl;
+        return 1;
+    }
+
+    Progress progress;
+    auto setup = Clock::now();
+    if (args[0] == "--points" || args[0] == "--file" || args[0] == "--random") {
+        PointDist pts;
+        if (args[0] == "--random") {
+            mt19937 rng(21);
+            int n = args.size() >= 2 ? stoi(args[1]) : 1000;
+            uniform_real_distribution<double> coord(0, 1000000);
+            for (int i = 0; i < n; i++) {
+                pts.x.push_back(coord(rng));
+                pts.y.push_back(coord(rng));
+            }
+        } else {
+            string data;
+            if (args[0] == "--file" && args.size() >= 2) {
+                ifstream in(args[1]);
+                stringstream all;
+                all << in.rdbuf();
+                data = all.str();
+            } else if (args.size() >= 2) {
+                data = args[1];
+                replace(data.begin(), data.end(), ';', '\n');
+            }
+            replace(data.begin(), data.end(), ',', ' ');
+            stringstream ss(data);
+            double x, y;
+            while (ss >> x >> y) {
+                pts.x.push_back(x);
+                pts.y.push_back(y);
+            }
+        }
+        int n = pts.x.size();
+        if (n < 1) {
+            cout << "{\"error\":\"No cities given\"}" << endl;
+            return 1;
+        }
+        vector<vector<int>> cand = nearestByGrid(pts, k);
+        double setupSeconds = chrono::duration<double>(Clock::now() - setup).count();
+        solve(pts, cand, construct, budget, threads, progress);
+        printResult("points", n, progress, threads, setupSeconds, withTour);
+    } else {
+        // Parse: "4;0,10,15,20;10,0,35,25;15,35,0,30;20,25,30,0"
+        stringstream ss(args[0]);
+        string token;
+        getline(ss, token, ';');
+        MatrixDist dist;
+        dist.n = stoi(token);
+        dist.d.assign((size_t)dist.n * dist.n, 0);
+        for (int i = 0; i < dist.n; i++) {
+            getline(ss, token, ';');
+            stringstream rowSS(token);
+            string val;
+            for (int j = 0; j < dist.n; j++) {
+                getline(rowSS, val, ',');
+                dist.d[(size_t)i * dist.n + j] = stoll(val);
+            }
+        }
+        if (dist.n < 1) {
+            cout << "{\"error\":\"No cities given\"}" << endl;
+            return 1;
+        }
+        // 2-opt and Or-opt gains assume d(a, b) == d(b, a); on an asymmetric
+        // matrix an "improving" move can undo another forever
+        for (int i = 0; i < dist.n; i++) {
+            for (int j = 0; j < i; j++) {
+                if (dist(i, j) != dist(j, i)) {
+                    cout << "{\"error\":\"Local search needs a symmetric matrix; use TSP for asymmetric instances\"}" << endl;
+                    return 1;
+                }
+            }
+        }
+        vector<vector<int>> cand = toursearch::nearestByScan(dist.n, k, dist);
+        double setupSeconds = chrono::duration<double>(Clock::now() - setup).count();
+        solve(dist, cand, construct, budget, threads, progress);
+        printResult("matrix", dist.n, progress, threads, setupSeconds, withTour);
+    }
+
+    return 0;
+}
@@ -1,48 +1,61 @@
 #include <iostream>
 #include <vector>
-#include <list>
-#include <queue>
 #include <sstream>
 #include <string>
+#include <utility>
+#include "../../common/CSRGraph.h"
 using namespace std;
 
+// Undirected graph over the shared CSR layout. Edges are collected first and
+// the adjacency arrays are built once, on the first query, so neighbours keep
+// the order the edges were added in.
 class Graph {
 private:
     int vertices;
-    vector<list<int>> adjList;
+    csr::EdgeList edges;
+    csr::Graph adj;
+    bool built = false;
     
-    void DFS(int start, vector<bool>& visited, vector<int>& result) {
-        visited[start] = true;
-        result.push_back(start);
-        
-        for (int neighbor : adjList[start]) {
-            if (!visited[neighbor]) {
-                DFS(neighbor, visited, result);
-            }
+    const csr::Graph& adjacency() {
+        if (!built) {
+            adj = csr::build(edges, csr::Undirected);
+            built = true;
+        }
+        return adj;
+    }
+    
+    static string pathJson(const char* traversal, int start, const vector<uint32_t>& result) {
+        stringstream ss;
+        ss << "{\"traversal\":\"" << traversal << "\",\"start\":" << start << ",\"path\":[";
+        for (size_t i = 0; i < result.size(); i++) {
+            if (i > 0) ss << ",";
+            ss << result[i];
         }
+        ss << "]}";
+        return ss.str();
     }
     
 public:
     Graph(int v) : vertices(v) {
-        adjList.resize(v);
+        edges.n = v;
     }
     
     void addEdge(int src, int dest) {
-        adjList[src].push_back(dest);
-        adjList[dest].push_back(src);
+        edges.from.push_back(src);
+        edges.to.push_back(dest);
+        built = false;
     }
     
     string display() {
+        const csr::Graph& g = adjacency();
         stringstream ss;
         ss << "{\"adjacencyList\":[";
         for (int i = 0; i < vertices; i++) {
             if (i > 0) ss << ",";
             ss << "{\"vertex\":" << i << ",\"neighbors\":[";
-            bool first = true;
-            for (int neighbor : adjList[i]) {
-                if (!first) ss << ",";
-                ss << neighbor;
-                first = false;
+            for (uint64_t e = g.offsets[i]; e < g.offsets[i + 1]; e++) {
+                if (e > g.offsets[i]) ss << ",";
+                ss << g.targets[e];
             }
             ss << "]}";
         }
@@ -50,50 +63,50 @@ public:
         return ss.str();
     }
     
+    // Iterative preorder: each frame remembers the next edge to try, which
+    // visits vertices in the same order as the recursive version
     string DFSTraversal(int start) {
+        const csr::Graph& g = adjacency();
         vector<bool> visited(vertices, false);
-        vector<int> result;
-        DFS(start, visited, result);
-        
-        stringstream ss;
-        ss << "{\"traversal\":\"DFS\",\"start\":" << start << ",\"path\":[";
-        for (size_t i = 0; i < result.size(); i++) {
-            if (i > 0) ss << ",";
-            ss << result[i];
+        vector<uint32_t> result;
+        vector<pair<uint32_t, uint64_t>> stack;
+        visited[start] = true;
+        result.push_back(start);
+        stack.push_back({(uint32_t)start, g.offsets[start]});
+        while (!stack.empty()) {
+            pair<uint32_t, uint64_t>& top = stack.back();
+            if (top.second == g.offsets[top.first + 1]) {
+                stack.pop_back();
+                continue;
+            }
+            uint32_t next = g.targets[top.second++];
+            if (!visited[next]) {
+                visited[next] = true;
+                result.push_back(next);
+                stack.push_back({next, g.offsets[next]});
+            }
         }
-        ss << "]}";
-        return ss.str();
+        return pathJson("DFS", start, result);
     }
     
+    // The result vector doubles as the queue: head walks it front to back
     string BFSTraversal(int start) {
+        const csr::Graph& g = adjacency();
         vector<bool> visited(vertices, false);
-        queue<int> q;
-        vector<int> result;
-        
+        vector<uint32_t> result;
         visited[start] = true;
-        q.push(start);
-        
-        while (!q.empty()) {
-            int current = q.front();
-            q.pop();
-            result.push_back(current);
-            
-            for (int neighbor : adjList[current]) {
+        result.push_back(start);
+        for (size_t head = 0; head < result.size(); head++) {
+            uint32_t current = result[head];
+            for (uint64_t e = g.offsets[current]; e < g.offsets[current + 1]; e++) {
+                uint32_t neighbor = g.targets[e];
                 if (!visited[neighbor]) {
                     visited[neighbor] = true;
-                    q.push(neighbor);
+                    result.push_back(neighbor);
                 }
             }
         }
-        
-        stringstream ss;
-        ss << "{\"traversal\":\"BFS\",\"start\":" << start << ",\"path\":[";
-        for (size_t i = 0; i < result.size(); i++) {
-            if (i > 0) ss << ",";
-            ss << result[i];
-        }
-        ss << "]}";
-        return ss.str();
+        return pathJson("BFS", start, result);
     }
 };
 
@@ -105,6 +118,10 @@ int main(int argc, char* argv[]) {
     
     int vertices = stoi(argv[1]);
     string operation = argv[2];
+    if (vertices < 0) {
+        cout << "{\"error\":\"Vertex count must be non-negative\"}" << endl;
+        return 1;
+    }
     Graph graph(vertices);
     
     if (argc > 3) {
@@ -116,6 +133,10 @@ int main(int argc, char* argv[]) {
             if (pos != string::npos) {
                 int u = stoi(edge.substr(0, pos));
                 int v = stoi(edge.substr(pos + 1));
+                if (u < 0 || v < 0 || u >= vertices || v >= vertices) {
+                    cout << "{\"error\":\"Edge '" << edge << "' names a vertex outside 0.." << vertices - 1 << "\"}" << endl;
+                    return 1;
+                }
                 graph.addEdge(u, v);
             }
         }
@@ -124,17 +145,17 @@ int main(int argc, char* argv[]) {
     if (operation == "display") {
         cout << graph.display() << endl;
     }
-    else if (operation == "DFS" && argc > 4) {
-        int start = stoi(argv[4]);
-        cout << graph.DFSTraversal(start) << endl;
-    }
-    else if (operation == "BFS" && argc > 4) {
+    else if ((operation == "DFS" || operation == "BFS") && argc > 4) {
         int start = stoi(argv[4]);
-        cout << graph.BFSTraversal(start) << endl;
+        if (start < 0 || start >= vertices) {
+            cout << "{\"error\":\"Start vertex must be in 0.." << vertices - 1 << "\"}" << endl;
+            return 1;
+        }
+        cout << (operation == "DFS" ? graph.DFSTraversal(start) : graph.BFSTraversal(start)) << endl;
     }
     else {
         cout << "{\"error\":\"Invalid operation\"}" << endl;
     }
     
     return 0;
-}
\ No newline at end of file
+}
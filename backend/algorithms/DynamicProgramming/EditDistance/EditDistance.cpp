@@ -0,0 +1,400 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include <cstdio>
+#include "../../common/SequenceDP.h"
+#include "../../common/TextStream.h"
+using namespace std;
+using seqdp::INF;
+
+// Edit distance family on the shared rolling-row engine (SequenceDP.h):
+//  - levenshtein / damerau (optimal string alignment) / affine (Gotoh) models,
+//    banded to |i - j| <= w when a distance bound is given
+//  - myers: Myers' bit-vector algorithm, unit costs, 64 cells per word op
+//  - striped: Farrar-style striped layout on int32 vectors, unit costs
+//  - --align: Levenshtein edit script in linear space (Hirschberg)
+
+struct Costs {
+    int mismatch = 1;
+    int gapOpen = 2;
+    int gapExtend = 1;
+};
+
+struct LevenshteinModel {
+    using State = int;
+    const string& a;
+    const string& b;
+    int top(size_t j) const { return j; }
+    int left(size_t i) const { return i; }
+    int blocked() const { return INF; }
+    int score(int s) const { return s; }
+    int cell(size_t i, size_t j, const int*, const int* prev, const int* cur) const {
+        int sub = prev[j - 1] + (a[i - 1] != b[j - 1]);
+        return min(sub, min(prev[j], cur[j - 1]) + 1);
+    }
+};
+
+// Restricted Damerau-Levenshtein: adjacent transpositions cost 1, no
+// substring is edited twice. Needs the row two above.
+struct DamerauModel {
+    using State = int;
+    const string& a;
+    const string& b;
+    int top(size_t j) const { return j; }
+    int left(size_t i) const { return i; }
+    int blocked() const { return INF; }
+    int score(int s) const { return s; }
+    int cell(size_t i, size_t j, const int* prev2, const int* prev, const int* cur) const {
+        int best = min(prev[j - 1] + (a[i - 1] != b[j - 1]), min(prev[j], cur[j - 1]) + 1);
+        if (i > 1 && j > 1 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1]) best = min(best, prev2[j - 2] + 1);
+        return best;
+    }
+};
+
+// Gotoh: a gap of length L costs gapOpen + L * gapExtend. e tracks alignments
+// ending in a gap in a (insertion), f ending in a gap in b (deletion).
+struct AffineModel {
+    struct State { int h, e, f; };
+    const string& a;
+    const string& b;
+    Costs costs;
+    State top(size_t j) const {
+        if (j == 0) return {0, INF, INF};
+        int g = costs.gapOpen + (int)j * costs.gapExtend;
+        return {g, g, INF};
+    }
+    State left(size_t i) const {
+        int g = costs.gapOpen + (int)i * costs.gapExtend;
+        return {g, INF, g};
+    }
+    State blocked() const { return {INF, INF, INF}; }
+    int score(const State& s) const { return s.h; }
+    State cell(size_t i, size_t j, const State*, const State* prev, const State* cur) const {
+        int open = costs.gapOpen + costs.gapExtend;
+        int e = min(cur[j - 1].e + costs.gapExtend, cur[j - 1].h + open);
+        int f = min(prev[j].f + costs.gapExtend, prev[j].h + open);
+        int h = min(prev[j - 1].h + (a[i - 1] == b[j - 1] ? 0 : costs.mismatch), min(e, f));
+        return {h, e, f};
+    }
+};
+
+// Runs a model, banded when bound >= 0. Returns -1 if the distance exceeds bound.
+template <typename Model>
+int modelDistance(const Model& model, size_t m, size_t n, int bound, size_t width) {
+    if (bound < 0) return model.score(seqdp::sweepRows(model, m, n)[n]);
+    if ((m > n ? m - n : n - m) > width) return -1;
+    bool exceeded;
+    int d = model.score(seqdp::sweepRows(model, m, n, width, bound, &exceeded)[n]);
+    return exceeded || d > bound ? -1 : d;
+}
+
+// Myers (1999), block form: Pv/Mv hold the +1/-1 vertical deltas of the
+// current column, one bit per character of a. The horizontal delta leaving
+// each word is carried into the next one, which stands in for the carry of
+// the addition. score tracks D[m][j] through the delta at row m.
+int myersDistance(const string& a, const string& b) {
+    size_t m = a.size();
+    if (m == 0) return b.size();
+    seqdp::MatchMasks peq(a);
+    size_t words = peq.words;
+    vector<uint64_t> P(words, ~0ULL), M(words, 0);
+    uint64_t lastBit = 1ULL << ((m - 1) % 64);
+    int score = m;
+    for (char c : b) {
+        const uint64_t* eq = peq.mask(c);
+        int hin = 1;
+        for (size_t w = 0; w < words; w++) {
+            uint64_t Eq = eq ? eq[w] : 0;
+            uint64_t Pv = P[w], Mv = M[w];
+            uint64_t Xv = Eq | Mv;
+            if (hin < 0) Eq |= 1;
+            uint64_t Xh = (((Eq & Pv) + Pv) ^ Pv) | Eq;
+            uint64_t Ph = Mv | ~(Xh | Pv);
+            uint64_t Mh = Pv & Xh;
+            uint64_t high = w + 1 == words ? lastBit : 1ULL << 63;
+            int hout = (Ph & high) ? 1 : (Mh & high) ? -1 : 0;
+            Ph <<= 1;
+            Mh <<= 1;
+            if (hin < 0) Mh |= 1;
+            else if (hin > 0) Ph |= 1;
+            P[w] = Mh | ~(Xv | Ph);
+            M[w] = Ph & Xv;
+            hin = hout;
+        }
+        score += hin;
+    }
+    return score;
+}
+
+// Farrar's striped layout: row i of a column lives in lane i / S of vector
+// i % S, so the dependency on the row above is between vectors, not lanes.
+// Vertical (deletion) chains that cross a stripe are fixed by the lazy-F loop,
+// which usually stops after a vector or two. GCC/Clang vector extensions
+// compile to AVX2, SSE or NEON depending on the target.
+#if defined(__AVX2__)
+typedef int32_t Vec __attribute__((vector_size(32)));
+const int LANES = 8;
+#else
+typedef int32_t Vec __attribute__((vector_size(16)));
+const int LANES = 4;
+#endif
+
+inline Vec vmin(Vec x, Vec y) {
+    Vec lt = x < y;
+    return (x & lt) | (y & ~lt);
+}
+
+inline Vec laneShift(Vec v, int fill) {
+    Vec r = v;
+    for (int l = LANES - 1; l > 0; l--) r[l] = v[l - 1];
+    r[0] = fill;
+    return r;
+}
+
+inline bool anyLess(Vec x, Vec y) {
+    Vec lt = x < y;
+    int any = 0;
+    for (int l = 0; l < LANES; l++) any |= lt[l];
+    return any != 0;
+}
+
+int stripedDistance(const string& a, const string& b) {
+    size_t m = a.size(), n = b.size();
+    if (m == 0) return n;
+    if (n == 0) return m;
+    size_t S = (m + LANES - 1) / LANES;
+    vector<Vec> query(S), Hprev(S), Hcur(S);
+    for (size_t t = 0; t < S; t++) {
+        for (int l = 0; l < LANES; l++) {
+            size_t i = l * S + t;
+            query[t][l] = i < m ? (unsigned char)a[i] : -1;
+            Hprev[t][l] = i + 1;
+        }
+    }
+    Vec one = Vec{} + 1, inf = Vec{} + INF;
+
+    for (size_t j = 1; j <= n; j++) {
+        Vec c = Vec{} + (int)(unsigned char)b[j - 1];
+        Vec diag = laneShift(Hprev[S - 1], j - 1);
+        Vec F = inf;
+        F[0] = j + 1;
+        for (size_t t = 0; t < S; t++) {
+            Vec cost = (query[t] != c) & one;
+            Vec h = vmin(vmin(diag + cost, Hprev[t] + one), F);
+            diag = Hprev[t];
+            Hcur[t] = h;
+            F = h + one;
+        }
+        F = laneShift(F, INF);
+        for (size_t t = 0; anyLess(F, Hcur[t]); ) {
+            Hcur[t] = vmin(Hcur[t], F);
+            F = F + one;
+            if (++t == S) {
+                t = 0;
+                F = laneShift(F, INF);
+            }
+        }
+        swap(Hprev, Hcur);
+    }
+    return Hprev[(m - 1) % S][(m - 1) / S];
+}
+
+// Levenshtein edit script in O(m + n) memory: split a in half, take the last
+// row of the forward DP and of the DP on the reversed suffixes, cut b where
+// they sum to the minimum, recurse. Small pieces use a full table.
+void directAlign(const string& a, const string& b, string& ops) {
+    size_t m = a.size(), n = b.size();
+    vector<int> dp((m + 1) * (n + 1));
+    auto at = [&](size_t i, size_t j) -> int& { return dp[i * (n + 1) + j]; };
+    for (size_t i = 0; i <= m; i++) at(i, 0) = i;
+    for (size_t j = 0; j <= n; j++) at(0, j) = j;
+    for (size_t i = 1; i <= m; i++) {
+        for (size_t j = 1; j <= n; j++) {
+            at(i, j) = min(at(i - 1, j - 1) + (a[i - 1] != b[j - 1]), min(at(i - 1, j), at(i, j - 1)) + 1);
+        }
+    }
+    string piece;
+    size_t i = m, j = n;
+    while (i > 0 || j > 0) {
+        if (i > 0 && j > 0 && at(i, j) == at(i - 1, j - 1) + (a[i - 1] != b[j - 1])) {
+            piece.push_back(a[i - 1] == b[j - 1] ? '=' : 'X');
+            i--;
+            j--;
+        } else if (i > 0 && at(i, j) == at(i - 1, j) + 1) {
+            piece.push_back('D');
+            i--;
+        } else {
+            piece.push_back('I');
+            j--;
+        }
+    }
+    ops.append(piece.rbegin(), piece.rend());
+}
+
+void hirschbergAlign(const string& a, const string& b, string& ops) {
+    if (a.empty()) {
+        ops.append(b.size(), 'I');
+        return;
+    }
+    if (b.empty()) {
+        ops.append(a.size(), 'D');
+        return;
+    }
+    if (a.size() * b.size() <= (1 << 16) || a.size() == 1) {
+        directAlign(a, b, ops);
+        return;
+    }
+    size_t mid = a.size() / 2, n = b.size();
+    string head = a.substr(0, mid);
+    vector<int> forward = seqdp::sweepRows(LevenshteinModel{head, b}, head.size(), n);
+    string tail(a.rbegin(), a.rend() - mid), rb(b.rbegin(), b.rend());
+    vector<int> backward = seqdp::sweepRows(LevenshteinModel{tail, rb}, tail.size(), n);
+    size_t split = 0;
+    int best = INF;
+    for (size_t j = 0; j <= n; j++) {
+        if (forward[j] + backward[n - j] < best) {
+            best = forward[j] + backward[n - j];
+            split = j;
+        }
+    }
+    hirschbergAlign(head, b.substr(0, split), ops);
+    hirschbergAlign(a.substr(mid), b.substr(split), ops);
+}
+
+int runBenchmark(size_t n) {
+    mt19937 rng(5);
+    string a(n, 'a');
+    for (char& c : a) c = "acgt"[rng() & 3];
+    // b is a with ~5% point edits, the case banding is meant for
+    string b;
+    for (char c : a) {
+        unsigned r = rng() % 100;
+        if (r == 0) continue;
+        if (r == 1) b.push_back("acgt"[rng() & 3]);
+        b.push_back(r == 2 ? "acgt"[rng() & 3] : c);
+    }
+
+    struct Run { string kernel; int distance; double seconds; };
+    vector<Run> runs;
+    auto time = [&](const string& kernel, auto fn) {
+        auto start = chrono::steady_clock::now();
+        int d = fn();
+        runs.push_back({kernel, d, chrono::duration<double>(chrono::steady_clock::now() - start).count()});
+    };
+    time("levenshtein-rolling", [&] { return modelDistance(LevenshteinModel{a, b}, a.size(), b.size(), -1, 0); });
+    int exact = runs[0].distance;
+    time("levenshtein-banded", [&] { return modelDistance(LevenshteinModel{a, b}, a.size(), b.size(), exact, exact); });
+    time("myers", [&] { return myersDistance(a, b); });
+    time("striped", [&] { return stripedDistance(a, b); });
+    time("damerau-rolling", [&] { return modelDistance(DamerauModel{a, b}, a.size(), b.size(), -1, 0); });
+    time("affine-rolling", [&] { return modelDistance(AffineModel{a, b, Costs()}, a.size(), b.size(), -1, 0); });
+
+    double cells = (double)a.size() * b.size();
+    bool consistent = true;
+    cout << "{\"algorithm\":\"EditDistance\",\"mode\":\"benchmark\",\"length1\":" << a.size() << ",\"length2\":" << b.size()
+         << ",\"results\":[";
+    for (size_t r = 0; r < runs.size(); r++) {
+        if (r > 0) cout << ",";
+        if (r < 4 && runs[r].distance != exact) consistent = false;
+        cout << "{\"kernel\":\"" << runs[r].kernel << "\",\"distance\":" << runs[r].distance
+             << ",\"seconds\":" << runs[r].seconds << ",\"gcups\":" << cells / runs[r].seconds / 1e9 << "}";
+    }
+    cout << "],\"consistent\":" << (consistent ? "true" : "false") << "}" << endl;
+    return 0;
+}
+
+string readFile(const string& path) {
+    ifstream in(path, ios::binary);
+    stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+int main(int argc, char* argv[]) {
+    ios::sync_with_stdio(false);
+    vector<string> flags, args;
+    Costs costs;
+    int bound = -1;
+    // Only known flags are taken out, so input strings may start with "--";
+    // a bare "--" ends the options for strings that equal a flag name
+    bool options = true;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        bool valued = arg == "--max" || arg == "--mismatch" || arg == "--gap-open" || arg == "--gap-extend";
+        bool flag = arg == "--bench" || arg == "--files" || arg == "--align";
+        if (options && arg == "--") {
+            options = false;
+        } else if (options && valued && i + 1 < argc) {
+            int value = stoi(argv[++i]);
+            if (arg == "--max") bound = value;
+            else if (arg == "--mismatch") costs.mismatch = value;
+            else if (arg == "--gap-open") costs.gapOpen = value;
+            else costs.gapExtend = value;
+        } else if (options && flag) {
+            flags.push_back(arg);
+        } else {
+            args.push_back(arg);
+        }
+    }
+    auto has = [&](const string& f) { return find(flags.begin(), flags.end(), f) != flags.end(); };
+
+    if (has("--bench")) return runBenchmark(args.empty() ? 20000 : stoull(args[0]));
+
+    string model = args.size() >= 3 ? args[2] : "levenshtein";
+    bool known = model == "levenshtein" || model == "damerau" || model == "affine" || model == "myers" || model == "striped";
+    if (args.size() < 2 || !known) {
+        cout << "{\"error\":\"Usage: ./EditDistance [--files] [--] <string1> <string2> [levenshtein|damerau|affine|myers|striped] "
+                "[--max k] [--align] [--mismatch x --gap-open o --gap-extend e] | ./EditDistance --bench [length]\"}" << endl;
+        return 1;
+    }
+
+    string s1 = has("--files") ? readFile(args[0]) : args[0];
+    string s2 = has("--files") ? readFile(args[1]) : args[1];
+    size_t m = s1.size(), n = s2.size();
+
+    auto start = chrono::steady_clock::now();
+    int distance;
+    string ops;
+    if (model == "levenshtein") {
+        distance = modelDistance(LevenshteinModel{s1, s2}, m, n, bound, bound);
+        if (has("--align") && distance >= 0) hirschbergAlign(s1, s2, ops);
+    } else if (model == "damerau") {
+        distance = modelDistance(DamerauModel{s1, s2}, m, n, bound, bound);
+    } else if (model == "affine") {
+        // Leaving the diagonal by w costs at least one gap of length w
+        size_t width = 0;
+        if (bound >= 0) {
+            width = costs.gapExtend <= 0 ? SIZE_MAX : bound < costs.gapOpen ? 0 : (bound - costs.gapOpen) / costs.gapExtend;
+        }
+        distance = modelDistance(AffineModel{s1, s2, costs}, m, n, bound, width);
+    } else if (model == "myers") {
+        distance = myersDistance(s1, s2);
+    } else {
+        distance = stripedDistance(s1, s2);
+    }
+    if (bound >= 0 && distance > bound) distance = -1;
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    // Output JSON
+    cout << "{\"algorithm\":\"EditDistance\",\"model\":\"" << model << "\"";
+    if (!has("--files")) cout << ",\"string1\":\"" << jsonEscape(s1) << "\",\"string2\":\"" << jsonEscape(s2) << "\"";
+    cout << ",\"length1\":" << m << ",\"length2\":" << n;
+    if (model == "affine") {
+        cout << ",\"costs\":{\"mismatch\":" << costs.mismatch << ",\"gapOpen\":" << costs.gapOpen
+             << ",\"gapExtend\":" << costs.gapExtend << "}";
+    }
+    if (bound >= 0) cout << ",\"bound\":" << bound << ",\"withinBound\":" << (distance >= 0 ? "true" : "false");
+    cout << ",\"distance\":";
+    if (distance >= 0) cout << distance;
+    else cout << "null";
+    if (has("--align") && model == "levenshtein" && distance >= 0) cout << ",\"ops\":\"" << ops << "\"";
+    cout << ",\"seconds\":" << seconds << "}" << endl;
+
+    return 0;
+}
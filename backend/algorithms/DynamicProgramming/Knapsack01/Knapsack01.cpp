@@ -2,53 +2,291 @@
 #include <vector>
 #include <sstream>
 #include <algorithm>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <cstdint>
+#include "../../common/Barrier.h"
 using namespace std;
 
+// 0/1 knapsack for capacities in the millions. Nothing keeps the n x W table:
+//  - bestRow: one rolling row, f[c] = best value with weight <= c; with several
+//    threads each item's row update is split over capacity ranges
+//  - solve: Hirschberg-style reconstruction. Split the items in half, take the
+//    best row of each half, cut the capacity where f1[c] + f2[C - c] peaks and
+//    recurse. O(W) memory; pieces small enough get a table of decision bits.
+//  - subset-sum (every value == weight): reachable sums as a bitset,
+//    reach |= reach << w, 64 capacities per word op, split the same way
+
+struct Item {
+    long long value;
+    long long weight;
+};
+
+const size_t PARALLEL_MIN_CAPACITY = 1 << 16;
+const size_t DECISION_BITS = 1 << 26;
+
+vector<long long> bestRow(const vector<Item>& items, size_t lo, size_t hi, size_t C, unsigned threads) {
+    vector<long long> f(C + 1, 0);
+    if (threads <= 1 || C < PARALLEL_MIN_CAPACITY) {
+        for (size_t i = lo; i < hi; i++) {
+            size_t w = items[i].weight;
+            long long v = items[i].value;
+            for (size_t c = C; c >= w && c != (size_t)-1; c--) f[c] = max(f[c], f[c - w] + v);
+        }
+        return f;
+    }
+
+    // The in-place descending sweep is sequential, so the parallel version
+    // double-buffers: next[c] = max(cur[c], cur[c - w] + v) is independent per c
+    vector<long long> g(C + 1, 0);
+    Barrier barrier(threads);
+    vector<thread> workers;
+    size_t per = (C + threads) / threads;
+    for (unsigned t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            size_t begin = min(C + 1, t * per), end = min(C + 1, begin + per);
+            long long* cur = f.data();
+            long long* next = g.data();
+            for (size_t i = lo; i < hi; i++) {
+                size_t w = items[i].weight;
+                long long v = items[i].value;
+                for (size_t c = begin; c < end; c++) next[c] = c >= w ? max(cur[c], cur[c - w] + v) : cur[c];
+                swap(cur, next);
+                barrier.wait();
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+    if ((hi - lo) % 2 == 1) f.swap(g);
+    return f;
+}
+
+// Items [lo, hi) with capacity C: rolling row plus one decision bit per
+// (item, capacity), then walk the bits back from C
+void solveDirect(const vector<Item>& items, size_t lo, size_t hi, size_t C, vector<int>& chosen) {
+    size_t k = hi - lo, stride = (C + 64) / 64;
+    vector<long long> f(C + 1, 0);
+    vector<uint64_t> took(k * stride, 0);
+    for (size_t i = 0; i < k; i++) {
+        size_t w = items[lo + i].weight;
+        long long v = items[lo + i].value;
+        uint64_t* bits = &took[i * stride];
+        for (size_t c = C; c >= w && c != (size_t)-1; c--) {
+            if (f[c - w] + v > f[c]) {
+                f[c] = f[c - w] + v;
+                bits[c / 64] |= 1ULL << (c % 64);
+            }
+        }
+    }
+    size_t c = C;
+    for (size_t i = k; i-- > 0; ) {
+        if ((took[i * stride + c / 64] >> (c % 64)) & 1) {
+            chosen.push_back(lo + i);
+            c -= items[lo + i].weight;
+        }
+    }
+}
+
+void solve(const vector<Item>& items, size_t lo, size_t hi, size_t C, unsigned threads, vector<int>& chosen) {
+    if (lo >= hi) return;
+    if ((hi - lo) * (C + 1) <= DECISION_BITS || hi - lo == 1) {
+        solveDirect(items, lo, hi, C, chosen);
+        return;
+    }
+    size_t mid = (lo + hi) / 2, split = 0;
+    {
+        vector<long long> left = bestRow(items, lo, mid, C, threads);
+        vector<long long> right = bestRow(items, mid, hi, C, threads);
+        long long best = -1;
+        for (size_t c = 0; c <= C; c++) {
+            if (left[c] + right[C - c] > best) {
+                best = left[c] + right[C - c];
+                split = c;
+            }
+        }
+    }
+    solve(items, lo, mid, split, threads, chosen);
+    solve(items, mid, hi, C - split, threads, chosen);
+}
+
+// Bit s of the result is set if some subset of items [lo, hi) weighs exactly s
+vector<uint64_t> reachable(const vector<Item>& items, size_t lo, size_t hi, size_t C) {
+    size_t words = C / 64 + 1;
+    vector<uint64_t> reach(words, 0);
+    reach[0] = 1;
+    for (size_t i = lo; i < hi; i++) {
+        size_t w = items[i].weight, shiftWords = w / 64, shiftBits = w % 64;
+        // reach |= reach << w, high words first so sources are still unshifted
+        for (size_t k = words; k-- > shiftWords; ) {
+            uint64_t moved = reach[k - shiftWords] << shiftBits;
+            if (shiftBits && k > shiftWords) moved |= reach[k - shiftWords - 1] >> (64 - shiftBits);
+            reach[k] |= moved;
+        }
+    }
+    size_t tail = (C + 1) % 64;
+    if (tail) reach[words - 1] &= (1ULL << tail) - 1;
+    return reach;
+}
+
+inline bool bitAt(const vector<uint64_t>& bits, size_t s) { return (bits[s / 64] >> (s % 64)) & 1; }
+
+size_t highestReachable(const vector<uint64_t>& reach) {
+    for (size_t k = reach.size(); k-- > 0; ) {
+        if (reach[k]) return k * 64 + 63 - __builtin_clzll(reach[k]);
+    }
+    return 0;
+}
+
+// Picks items from [lo, hi) summing to exactly target (known to be reachable)
+void subsetSumSolve(const vector<Item>& items, size_t lo, size_t hi, size_t target, vector<int>& chosen) {
+    if (target == 0 || lo >= hi) return;
+    if (hi - lo == 1) {
+        chosen.push_back(lo);
+        return;
+    }
+    size_t mid = (lo + hi) / 2, split = 0;
+    {
+        vector<uint64_t> left = reachable(items, lo, mid, target);
+        vector<uint64_t> right = reachable(items, mid, hi, target);
+        for (size_t s = 0; s <= target; s++) {
+            if (bitAt(left, s) && bitAt(right, target - s)) {
+                split = s;
+                break;
+            }
+        }
+    }
+    subsetSumSolve(items, lo, mid, split, chosen);
+    subsetSumSolve(items, mid, hi, target - split, chosen);
+}
+
+struct Result {
+    long long maxValue = 0;
+    vector<int> selected;   // indices into the caller's item list
+    string mode;
+};
+
+Result knapsack(const vector<Item>& all, size_t C, unsigned threads) {
+    // Items heavier than the knapsack or worth nothing never help
+    vector<Item> items;
+    vector<int> original;
+    bool subsetSum = true;
+    for (size_t i = 0; i < all.size(); i++) {
+        if (all[i].weight < 0 || all[i].value <= 0 || (size_t)all[i].weight > C) continue;
+        items.push_back(all[i]);
+        original.push_back(i);
+        subsetSum = subsetSum && all[i].value == all[i].weight;
+    }
+
+    Result result;
+    vector<int> chosen;
+    if (subsetSum && !items.empty()) {
+        result.mode = "subset-sum-bitset";
+        size_t best = highestReachable(reachable(items, 0, items.size(), C));
+        subsetSumSolve(items, 0, items.size(), best, chosen);
+    } else {
+        result.mode = threads > 1 && C >= PARALLEL_MIN_CAPACITY ? "parallel-rows" : "rolling-row";
+        solve(items, 0, items.size(), C, threads, chosen);
+    }
+    for (int k : chosen) {
+        result.selected.push_back(original[k]);
+        result.maxValue += items[k].value;
+    }
+    sort(result.selected.begin(), result.selected.end());
+    return result;
+}
+
+int runBenchmark(size_t n, size_t C, unsigned threads) {
+    mt19937_64 rng(9);
+    vector<Item> items(n), sums(n);
+    for (size_t i = 0; i < n; i++) {
+        items[i].weight = 1 + rng() % (C / 8 + 1);
+        items[i].value = items[i].weight + rng() % (C / 8 + 1);
+        sums[i].weight = sums[i].value = 1 + rng() % (C / 8 + 1);
+    }
+
+    auto seconds = [](auto fn) {
+        auto start = chrono::steady_clock::now();
+        fn();
+        return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    };
+    long long rolling = 0, parallel = 0, subsetRolling = 0;
+    Result full, subset;
+    double tRolling = seconds([&] { rolling = bestRow(items, 0, n, C, 1)[C]; });
+    double tParallel = seconds([&] { parallel = bestRow(items, 0, n, C, threads)[C]; });
+    double tSolve = seconds([&] { full = knapsack(items, C, threads); });
+    double tSubsetRolling = seconds([&] { subsetRolling = bestRow(sums, 0, n, C, 1)[C]; });
+    double tSubset = seconds([&] { subset = knapsack(sums, C, threads); });
+
+    double cells = (double)n * (C + 1);
+    cout << "{\"algorithm\":\"0/1 Knapsack\",\"mode\":\"benchmark\",\"items\":" << n << ",\"capacity\":" << C
+         << ",\"threads\":" << threads << ",\"results\":["
+         << "{\"kernel\":\"rolling-row\",\"maxValue\":" << rolling << ",\"seconds\":" << tRolling
+         << ",\"cellsPerSec\":" << cells / tRolling << "},"
+         << "{\"kernel\":\"parallel-rows\",\"maxValue\":" << parallel << ",\"seconds\":" << tParallel
+         << ",\"cellsPerSec\":" << cells / tParallel << "},"
+         << "{\"kernel\":\"reconstruction\",\"maxValue\":" << full.maxValue << ",\"selected\":" << full.selected.size()
+         << ",\"seconds\":" << tSolve << "},"
+         << "{\"kernel\":\"subset-sum-rolling\",\"maxValue\":" << subsetRolling << ",\"seconds\":" << tSubsetRolling << "},"
+         << "{\"kernel\":\"subset-sum-bitset\",\"maxValue\":" << subset.maxValue << ",\"selected\":" << subset.selected.size()
+         << ",\"seconds\":" << tSubset << "}]"
+         << ",\"consistent\":"
+         << (rolling == parallel && parallel == full.maxValue && subsetRolling == subset.maxValue ? "true" : "false")
+         << "}" << endl;
+    return 0;
+}
+
 int main(int argc, char* argv[]) {
+    unsigned hardware = max(1u, thread::hardware_concurrency());
+    if (argc >= 2 && string(argv[1]) == "bench") {
+        return runBenchmark(argc >= 3 ? stoull(argv[2]) : 100, argc >= 4 ? stoull(argv[3]) : 1000000,
+                            argc >= 5 ? stoul(argv[4]) : hardware);
+    }
     if (argc < 3) {
-        cout << "{\"error\":\"Usage: ./Knapsack01 <capacity> <items>\"}" << endl;
+        cout << "{\"error\":\"Usage: ./Knapsack01 <capacity> <items> [threads] | ./Knapsack01 bench [n] [capacity] [threads]\"}" << endl;
         return 1;
     }
-    
-    int capacity = stoi(argv[1]);
+
+    long long capacity = stoll(argv[1]);
     string itemsStr = argv[2];
-    
+    unsigned threads = argc >= 4 ? stoul(argv[3]) : hardware;
+    if (capacity < 0) capacity = 0;
+
     // Parse: "4;60,10;100,20;120,30;80,15"
     stringstream ss(itemsStr);
     string token;
     getline(ss, token, ';');
     int n = stoi(token);
-    
-    vector<int> values(n), weights(n);
+
+    vector<Item> items(n);
     for (int i = 0; i < n; i++) {
         getline(ss, token, ';');
         stringstream itemSS(token);
         string val;
-        
+
         getline(itemSS, val, ',');
-        values[i] = stoi(val);
-        
+        items[i].value = stoll(val);
+
         getline(itemSS, val, ',');
-        weights[i] = stoi(val);
-    }
-    
-    vector<vector<int>> dp(n + 1, vector<int>(capacity + 1, 0));
-    
-    for (int i = 1; i <= n; i++) {
-        for (int w = 0; w <= capacity; w++) {
-            if (weights[i-1] <= w) {
-                dp[i][w] = max(dp[i-1][w], values[i-1] + dp[i-1][w - weights[i-1]]);
-            } else {
-                dp[i][w] = dp[i-1][w];
-            }
-        }
+        items[i].weight = stoll(val);
     }
-    
-    int maxValue = dp[n][capacity];
-    
+
+    auto start = chrono::steady_clock::now();
+    Result result = knapsack(items, capacity, threads);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    long long totalWeight = 0;
+    for (int i : result.selected) totalWeight += items[i].weight;
+
     // Output JSON
-    cout << "{\"algorithm\":\"0/1 Knapsack\",\"capacity\":" << capacity 
-         << ",\"items\":" << n << ",\"maxValue\":" << maxValue << "}" << endl;
-    
+    cout << "{\"algorithm\":\"0/1 Knapsack\",\"capacity\":" << capacity
+         << ",\"items\":" << n << ",\"maxValue\":" << result.maxValue
+         << ",\"mode\":\"" << result.mode << "\",\"selected\":[";
+    for (size_t k = 0; k < result.selected.size(); k++) {
+        if (k > 0) cout << ",";
+        cout << result.selected[k];
+    }
+    cout << "],\"totalWeight\":" << totalWeight << ",\"seconds\":" << seconds << "}" << endl;
+
     return 0;
 }
@@ -2,54 +2,267 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <cstdint>
+#include <cstdio>
+#include "../../common/SequenceDP.h"
+#include "../../common/Barrier.h"
+#include "../../common/TextStream.h"
 using namespace std;
+using seqdp::MatchMasks;
+using seqdp::bitStep;
 
-int main(int argc, char* argv[]) {
-    if (argc < 3) {
-        cout << "{\"error\":\"Usage: ./LCS <string1> <string2>\"}" << endl;
-        return 1;
+// LCS without the (m+1) x (n+1) table:
+//  - bitParallelRow: Hyyro's bit-vector recurrence, 64 DP cells per word op
+//  - hirschberg: linear-space reconstruction, split rows come from bitParallelRow
+//  - wavefrontLength: the same kernel tiled so anti-diagonals of tiles run on several threads
+// Only small subproblems fall back to a full table.
+
+const size_t DIRECT_CELLS = 1 << 16;
+
+// row[i] = LCS(a[0, i), b) for every i in [0, |a|]. A zero bit in V marks a
+// position where the row increases, so 64 DP cells advance per word op.
+vector<int> bitParallelRow(const string& a, const char* b, size_t n) {
+    size_t m = a.size();
+    vector<int> row(m + 1, 0);
+    if (m == 0) return row;
+    MatchMasks masks(a);
+    vector<uint64_t> V(masks.words, ~0ULL);
+    for (size_t j = 0; j < n; j++) {
+        const uint64_t* mask = masks.mask(b[j]);
+        if (!mask) continue;
+        uint64_t carry = 0, borrow = 0;
+        bitStep(V.data(), mask, 0, masks.words, carry, borrow);
     }
-    
-    string s1 = argv[1];
-    string s2 = argv[2];
-    
-    int m = s1.length();
-    int n = s2.length();
-    
-    vector<vector<int>> dp(m + 1, vector<int>(n + 1, 0));
-    
-    for (int i = 1; i <= m; i++) {
-        for (int j = 1; j <= n; j++) {
-            if (s1[i-1] == s2[j-1]) {
-                dp[i][j] = dp[i-1][j-1] + 1;
-            } else {
-                dp[i][j] = max(dp[i-1][j], dp[i][j-1]);
-            }
+    for (size_t i = 0; i < m; i++) {
+        row[i + 1] = row[i] + !((V[i / 64] >> (i % 64)) & 1);
+    }
+    return row;
+}
+
+// Full-table LCS for small pieces, appending the subsequence to out
+void directLCS(const string& a, const string& b, string& out) {
+    size_t m = a.size(), n = b.size();
+    vector<int> dp((m + 1) * (n + 1), 0);
+    auto at = [&](size_t i, size_t j) -> int& { return dp[i * (n + 1) + j]; };
+    for (size_t i = 1; i <= m; i++) {
+        for (size_t j = 1; j <= n; j++) {
+            at(i, j) = a[i - 1] == b[j - 1] ? at(i - 1, j - 1) + 1 : max(at(i - 1, j), at(i, j - 1));
         }
     }
-    
-    int lcsLength = dp[m][n];
-    
-    // Reconstruct LCS
-    string lcs = "";
-    int i = m, j = n;
+    string piece;
+    size_t i = m, j = n;
     while (i > 0 && j > 0) {
-        if (s1[i-1] == s2[j-1]) {
-            lcs = s1[i-1] + lcs;
+        if (a[i - 1] == b[j - 1]) {
+            piece.push_back(a[i - 1]);
             i--;
             j--;
-        } else if (dp[i-1][j] > dp[i][j-1]) {
+        } else if (at(i - 1, j) > at(i, j - 1)) {
             i--;
         } else {
             j--;
         }
     }
-    
+    out.append(piece.rbegin(), piece.rend());
+}
+
+// Hirschberg: split b in half, find where the optimal path crosses the middle
+// using a forward row and a backward row, then solve the two halves. O(m + n)
+// memory, and the answer is built left to right by appending.
+void hirschberg(const string& a, const string& b, string& out) {
+    if (a.empty() || b.empty()) return;
+    if (a.size() * b.size() <= DIRECT_CELLS || b.size() == 1) {
+        directLCS(a, b, out);
+        return;
+    }
+    size_t mid = b.size() / 2;
+    vector<int> forward = bitParallelRow(a, b.data(), mid);
+    string ra(a.rbegin(), a.rend());
+    string rb(b.rbegin(), b.rend() - mid);
+    vector<int> backward = bitParallelRow(ra, rb.data(), rb.size());
+
+    size_t m = a.size(), split = 0;
+    int best = -1;
+    for (size_t k = 0; k <= m; k++) {
+        int total = forward[k] + backward[m - k];
+        if (total > best) {
+            best = total;
+            split = k;
+        }
+    }
+    hirschberg(a.substr(0, split), b.substr(0, mid), out);
+    hirschberg(a.substr(split), b.substr(mid), out);
+}
+
+// Bit-parallel kernel split into tiles of (word block of a) x (chunk of b).
+// Tile (k, c) needs the carries that block k-1 produced for the same chunk, so
+// all tiles on one anti-diagonal k + c are independent and run in parallel.
+// Carries are handed over through a two-chunk ring per block boundary.
+int wavefrontLength(const string& a, const string& b, unsigned threads,
+                    size_t blockWords = 256, size_t chunk = 4096) {
+    size_t m = a.size(), n = b.size();
+    if (m == 0 || n == 0) return 0;
+    MatchMasks masks(a);
+    size_t blocks = (masks.words + blockWords - 1) / blockWords;
+    size_t chunks = (n + chunk - 1) / chunk;
+    vector<uint64_t> V(masks.words, ~0ULL);
+    // handoff[k][parity * chunk + j]: bit 0 carry, bit 1 borrow into block k
+    vector<vector<uint8_t>> handoff(blocks + 1, vector<uint8_t>(2 * chunk, 0));
+    vector<uint64_t> zeros(masks.words, 0);
+
+    auto runTile = [&](size_t k, size_t c) {
+        size_t w0 = k * blockWords, w1 = min(masks.words, w0 + blockWords);
+        size_t j0 = c * chunk, j1 = min(n, j0 + chunk);
+        const uint8_t* in = handoff[k].data() + (c & 1) * chunk;
+        uint8_t* out = handoff[k + 1].data() + (c & 1) * chunk;
+        for (size_t j = j0; j < j1; j++) {
+            const uint64_t* mask = masks.mask(b[j]);
+            uint8_t flags = k == 0 ? 0 : in[j - j0];
+            // A byte absent from a still has to ripple incoming carries upward
+            if (!mask && flags) mask = zeros.data();
+            if (mask) {
+                uint64_t carry = flags & 1, borrow = flags >> 1;
+                bitStep(V.data(), mask, w0, w1, carry, borrow);
+                flags = carry | (borrow << 1);
+            }
+            out[j - j0] = flags;
+        }
+    };
+
+    threads = max(1u, min<unsigned>(threads, min(blocks, chunks)));
+    Barrier barrier(threads);
+    vector<thread> workers;
+    for (unsigned t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            for (size_t d = 0; d < blocks + chunks - 1; d++) {
+                size_t first = d >= chunks ? d - chunks + 1 : 0;
+                size_t last = min(d, blocks - 1);
+                for (size_t k = first + t; k <= last; k += threads) runTile(k, d - k);
+                barrier.wait();
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    int length = 0;
+    for (size_t i = 0; i < m; i++) length += !((V[i / 64] >> (i % 64)) & 1);
+    return length;
+}
+
+// Classic rolling-row DP on the shared engine, used as the benchmark baseline
+struct LcsModel {
+    using State = int;
+    const string& a;
+    const string& b;
+    int top(size_t) const { return 0; }
+    int left(size_t) const { return 0; }
+    int blocked() const { return 0; }
+    int score(int s) const { return s; }
+    int cell(size_t i, size_t j, const int*, const int* prev, const int* cur) const {
+        return a[i - 1] == b[j - 1] ? prev[j - 1] + 1 : max(prev[j], cur[j - 1]);
+    }
+};
+
+int rollingLength(const string& a, const string& b) {
+    return seqdp::sweepRows(LcsModel{a, b}, a.size(), b.size())[b.size()];
+}
+
+int runBenchmark(size_t n, unsigned threads) {
+    mt19937 rng(3);
+    string a(n, 'a'), b(n, 'a');
+    for (char& c : a) c = "acgt"[rng() & 3];
+    for (char& c : b) c = "acgt"[rng() & 3];
+
+    auto time = [](auto fn, int& result) {
+        auto start = chrono::steady_clock::now();
+        result = fn();
+        return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    };
+    int rolling, bits, wave;
+    string lcs;
+    double tRolling = time([&] { return rollingLength(a, b); }, rolling);
+    double tBits = time([&] { return bitParallelRow(a, b.data(), b.size())[a.size()]; }, bits);
+    double tWave = time([&] { return wavefrontLength(a, b, threads); }, wave);
+    int reconstructed;
+    double tHirschberg = time([&] { hirschberg(a, b, lcs); return (int)lcs.size(); }, reconstructed);
+
+    double cells = (double)n * n;
+    cout << "{\"algorithm\":\"LCS\",\"mode\":\"benchmark\",\"length\":" << n << ",\"threads\":" << threads
+         << ",\"lcsLength\":" << rolling
+         << ",\"results\":["
+         << "{\"kernel\":\"rolling-row\",\"seconds\":" << tRolling << ",\"gcups\":" << cells / tRolling / 1e9 << "},"
+         << "{\"kernel\":\"bit-parallel\",\"seconds\":" << tBits << ",\"gcups\":" << cells / tBits / 1e9 << "},"
+         << "{\"kernel\":\"wavefront\",\"seconds\":" << tWave << ",\"gcups\":" << cells / tWave / 1e9 << "},"
+         << "{\"kernel\":\"hirschberg\",\"seconds\":" << tHirschberg << ",\"gcups\":" << cells / tHirschberg / 1e9 << "}]"
+         << ",\"consistent\":" << (rolling == bits && bits == wave && wave == reconstructed ? "true" : "false")
+         << "}" << endl;
+    return 0;
+}
+
+string readFile(const string& path) {
+    ifstream in(path, ios::binary);
+    stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+int main(int argc, char* argv[]) {
+    ios::sync_with_stdio(false);
+    // Only known flags are taken out, so input strings may start with "--";
+    // a bare "--" ends the options for strings that equal a flag name
+    vector<string> flags, args;
+    bool options = true;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        bool flag = arg == "--bench" || arg == "--files" || arg == "--length" || arg == "--wavefront";
+        if (options && arg == "--") options = false;
+        else if (options && flag) flags.push_back(arg);
+        else args.push_back(arg);
+    }
+    auto has = [&](const string& f) { return find(flags.begin(), flags.end(), f) != flags.end(); };
+    unsigned hardware = max(1u, thread::hardware_concurrency());
+
+    if (has("--bench")) {
+        return runBenchmark(args.size() >= 1 ? stoull(args[0]) : 20000, args.size() >= 2 ? stoul(args[1]) : hardware);
+    }
+    if (args.size() < 2) {
+        cout << "{\"error\":\"Usage: ./LCS [--files] [--length | --wavefront] [--] <string1> <string2> [threads] | ./LCS --bench [length] [threads]\"}" << endl;
+        return 1;
+    }
+
+    string s1 = has("--files") ? readFile(args[0]) : args[0];
+    string s2 = has("--files") ? readFile(args[1]) : args[1];
+    bool echo = !has("--files");
+
+    auto start = chrono::steady_clock::now();
+    int lcsLength;
+    string lcs;
+    string mode;
+    if (has("--length")) {
+        mode = "bit-parallel";
+        // Put the longer string in the bit vector: fewer iterations of the outer loop
+        lcsLength = s1.size() >= s2.size() ? bitParallelRow(s1, s2.data(), s2.size())[s1.size()]
+                                           : bitParallelRow(s2, s1.data(), s1.size())[s2.size()];
+    } else if (has("--wavefront")) {
+        mode = "wavefront";
+        lcsLength = wavefrontLength(s1, s2, args.size() >= 3 ? stoul(args[2]) : hardware);
+    } else {
+        mode = "hirschberg";
+        hirschberg(s1, s2, lcs);
+        lcsLength = lcs.size();
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
     // Output JSON
-    cout << "{\"algorithm\":\"LCS\",\"string1\":\"" << s1 
-         << "\",\"string2\":\"" << s2 
-         << "\",\"lcsLength\":" << lcsLength 
-         << ",\"lcs\":\"" << lcs << "\"}" << endl;
-    
+    cout << "{\"algorithm\":\"LCS\",\"mode\":\"" << mode << "\"";
+    if (echo) cout << ",\"string1\":\"" << jsonEscape(s1) << "\",\"string2\":\"" << jsonEscape(s2) << "\"";
+    cout << ",\"lcsLength\":" << lcsLength;
+    if (mode == "hirschberg") cout << ",\"lcs\":\"" << jsonEscape(lcs) << "\"";
+    cout << ",\"seconds\":" << seconds << "}" << endl;
+
     return 0;
 }
@@ -1,46 +1,444 @@
 #include <iostream>
 #include <vector>
 #include <sstream>
+#include <fstream>
+#include <string>
+#include <algorithm>
+#include <unordered_map>
+#include <chrono>
+#include <random>
+#include <thread>
 #include <climits>
+#include <cstdint>
+#include "../../common/Barrier.h"
 using namespace std;
 
+// Matrix chain ordering with dims p[0..n]: matrix i is p[i] x p[i+1].
+//  - exact: interval DP over flat triangular tables. cost is stored twice,
+//    row-major (i fixed, j contiguous) and column-major (j fixed, i
+//    contiguous), so the k loop reads both operands sequentially. Diagonals
+//    are evaluated in order, the cells of one diagonal split across threads.
+//  - hu-shing: the O(n log n) algorithm of Hu and Shing (optimal polygon
+//    triangulation), exact as well, for chains far too long for O(n^3).
+// Costs are 64-bit, or 128-bit when (n - 1) * max(p)^3 could overflow that.
+// The exact tables take about 20 bytes per cell and n(n + 1) / 2 cells, so
+// the interval DP is capped at MAX_EXACT_MATRICES.
+
+const size_t MAX_EXACT_MATRICES = 8000;
+
+typedef __int128 Wide;
+
+string toString(Wide v) {
+    if (v == 0) return "0";
+    bool negative = v < 0;
+    string digits;
+    while (v != 0) {
+        int d = (int)(v % 10);
+        digits.push_back('0' + (negative ? -d : d));
+        v /= 10;
+    }
+    if (negative) digits.push_back('-');
+    return string(digits.rbegin(), digits.rend());
+}
+
+struct Plan {
+    Wide cost = 0;
+    string parenthesization;
+    bool exact = true;
+    string mode;
+};
+
+// Builds "((A1A2)A3)" from a function giving the split of interval [i, j]
+template <typename SplitOf>
+string parenthesize(size_t n, SplitOf splitOf) {
+    string out;
+    // (i, j, stage): stage 0 opens and descends left, stage 1 descends right, stage 2 closes
+    struct Frame { size_t i, j; int stage; };
+    vector<Frame> stack = {{0, n - 1, 0}};
+    while (!stack.empty()) {
+        Frame& f = stack.back();
+        if (f.i == f.j) {
+            out += "A" + to_string(f.i + 1);
+            stack.pop_back();
+            continue;
+        }
+        size_t k = splitOf(f.i, f.j);
+        if (f.stage == 0) {
+            out += "(";
+            f.stage = 1;
+            stack.push_back({f.i, k, 0});
+        } else if (f.stage == 1) {
+            f.stage = 2;
+            stack.push_back({k + 1, f.j, 0});
+        } else {
+            out += ")";
+            stack.pop_back();
+        }
+    }
+    return out;
+}
+
+template <typename Cost>
+Plan intervalDP(const vector<long long>& p, unsigned threads) {
+    size_t n = p.size() - 1;
+    size_t cells = n * (n + 1) / 2;
+    vector<Cost> byRow(cells, 0), byCol(cells, 0);
+    vector<uint32_t> split(cells, 0);
+    auto rowIdx = [n](size_t i, size_t j) { return i * (2 * n - i + 1) / 2 + (j - i); };
+    auto colIdx = [](size_t i, size_t j) { return j * (j + 1) / 2 + i; };
+    for (size_t i = 0; i < n; i++) split[rowIdx(i, i)] = i;
+
+    auto evaluate = [&](size_t i, size_t j) {
+        size_t lo = i, hi = j - 1;
+        const Cost* left = &byRow[rowIdx(i, i)] - i;     // left[k] = cost(i, k)
+        const Cost* right = &byCol[colIdx(0, j)] + 1;    // right[k] = cost(k + 1, j)
+        Cost outer = (Cost)p[i] * p[j + 1];
+        Cost best = 0;
+        size_t bestK = lo;
+        for (size_t k = lo; k <= hi; k++) {
+            Cost c = left[k] + right[k] + outer * p[k + 1];
+            if (k == lo || c < best) {
+                best = c;
+                bestK = k;
+            }
+        }
+        byRow[rowIdx(i, j)] = best;
+        byCol[colIdx(i, j)] = best;
+        split[rowIdx(i, j)] = bestK;
+    };
+
+    if (threads > n / 64) threads = max<size_t>(1, n / 64);
+    if (threads <= 1) {
+        for (size_t len = 2; len <= n; len++) {
+            for (size_t i = 0; i + len <= n; i++) evaluate(i, i + len - 1);
+        }
+    } else {
+        Barrier barrier(threads);
+        vector<thread> workers;
+        for (unsigned t = 0; t < threads; t++) {
+            workers.emplace_back([&, t]() {
+                for (size_t len = 2; len <= n; len++) {
+                    size_t count = n - len + 1, per = (count + threads - 1) / threads;
+                    size_t begin = min(count, t * per), end = min(count, begin + per);
+                    for (size_t i = begin; i < end; i++) evaluate(i, i + len - 1);
+                    barrier.wait();
+                }
+            });
+        }
+        for (auto& w : workers) w.join();
+    }
+
+    Plan plan;
+    plan.cost = byRow[rowIdx(0, n - 1)];
+    plan.mode = "exact";
+    plan.parenthesization = parenthesize(n, [&](size_t i, size_t j) { return (size_t)split[rowIdx(i, j)]; });
+    return plan;
+}
+
+// a/b >= c/d for a, c >= 0 and b, d > 0: cross products while they fit,
+// otherwise the continued fractions are compared term by term
+bool ratioAtLeast(Wide a, Wide b, Wide c, Wide d) {
+    const Wide fits = (Wide)1 << 62;
+    if (a < fits && b < fits && c < fits && d < fits) return a * d >= c * b;
+    for (;;) {
+        Wide qa = a / b, qc = c / d;
+        if (qa != qc) return qa > qc;
+        a -= qa * b;
+        c -= qc * d;
+        if (c == 0) return true;
+        if (a == 0) return false;
+        // Both below 1 now: a/b >= c/d exactly when d/c >= b/a
+        swap(a, d);
+        swap(b, c);
+    }
+}
+
+// Exact Hu-Shing ordering in O(n log n). The chain is a convex polygon with
+// vertex weights p[0..n], where side (0, n) is the product and a triangle
+// (a, b, c) costs p[a] p[b] p[c]. Rotated so the lightest vertex v1 comes
+// first, a one-sweep stack finds the potential h-arcs: chords whose inner
+// vertices are all heavier than both ends. They nest into a tree, and an
+// optimal triangulation keeps some of them and fans every region left
+// between kept arcs from its lightest vertex.
+//
+// Bottom-up, every arc is a unit with keep cost N (its region fanned from
+// its lighter end) and remove coefficient D (the region's edge products
+// minus the arc's own): under a fan apex of weight t it stays exactly when
+// t > N / D, its supporting weight. Units sit in leftist heaps ordered by
+// supporting weight. At arc a, units at or above the weight of a's lighter
+// end are removed for good and folded into a; units at or above a's own
+// supporting weight then share a's fate and are tied to it. Whatever is
+// left at the root is decided against p[v1]. Ties in weight are broken by
+// index, which stands for an arbitrarily small perturbation.
+Plan huShing(const vector<long long>& p, size_t limit) {
+    size_t n = p.size() - 1, V = n + 1;
+    size_t v1 = min_element(p.begin(), p.end()) - p.begin();
+    // Positions 0..V walk the polygon from v1 back to v1
+    vector<Wide> q(V + 1), prefix(V + 1, 0);
+    for (size_t r = 0; r <= V; r++) q[r] = p[(v1 + r) % V];
+    for (size_t r = 0; r < V; r++) prefix[r + 1] = prefix[r] + q[r] * q[r + 1];
+    auto vertex = [&](size_t r) { return (v1 + r) % V; };
+    auto lighter = [&](size_t r, size_t s) { return q[r] != q[s] ? q[r] < q[s] : vertex(r) < vertex(s); };
+
+    struct Arc {
+        uint32_t i, j, lo;
+        Wide keep, remove;
+        int parent = -1, firstChild = -1, nextSibling = -1, tiedTo = -1;
+        int left = -1, right = -1, rank = 1;
+        bool removed = false;
+    };
+    vector<Arc> arcs;
+    auto above = [&](int x, int y) { return ratioAtLeast(arcs[x].keep, arcs[x].remove, arcs[y].keep, arcs[y].remove); };
+    auto rankOf = [&](int x) { return x < 0 ? 0 : arcs[x].rank; };
+    auto merge = [&](auto& self, int x, int y) -> int {
+        if (x < 0) return y;
+        if (y < 0) return x;
+        if (!above(x, y)) swap(x, y);
+        arcs[x].right = self(self, arcs[x].right, y);
+        if (rankOf(arcs[x].left) < rankOf(arcs[x].right)) swap(arcs[x].left, arcs[x].right);
+        arcs[x].rank = rankOf(arcs[x].right) + 1;
+        return x;
+    };
+    auto pop = [&](int x) { return merge(merge, arcs[x].left, arcs[x].right); };
+
+    // Sums over the sides from i on, with every child arc standing in for
+    // the sides it covers; children leave `done` for the arc that encloses them
+    vector<int> done, heaps;
+    auto enclose = [&](size_t i, int self, Wide& inner, Wide& upAtLo, size_t lo) {
+        int heap = -1;
+        while (!done.empty() && arcs[done.back()].i >= i) {
+            int c = done.back();
+            done.pop_back();
+            Arc& child = arcs[c];
+            Wide base = q[child.i] * q[child.j];
+            inner -= prefix[child.j] - prefix[child.i] - base;
+            if (child.i == lo || child.j == lo) upAtLo = base;
+            child.parent = self;
+            if (self >= 0) {
+                child.nextSibling = arcs[self].firstChild;
+                arcs[self].firstChild = c;
+            }
+            heap = merge(merge, heap, heaps[c]);
+        }
+        return heap;
+    };
+
+    vector<size_t> stack = {0};
+    for (size_t k = 1; k <= V; k++) {
+        while (stack.size() >= 2 && lighter(k, stack.back())) {
+            stack.pop_back();
+            size_t i = stack.back();
+            if (i == 0 || k == V) continue;   // arcs at v1 change nothing
+            int a = arcs.size();
+            arcs.push_back(Arc());
+            heaps.push_back(-1);
+            size_t lo = lighter(i, k) ? i : k;
+            Wide inner = prefix[k] - prefix[i];
+            Wide upAtLo = lo == i ? q[i] * q[i + 1] : q[k - 1] * q[k];
+            int heap = enclose(i, a, inner, upAtLo, lo);
+            Arc& arc = arcs[a];
+            arc.i = i;
+            arc.j = k;
+            arc.lo = lo;
+            Wide w = q[lo];
+            arc.keep = w * (inner - upAtLo);
+            arc.remove = inner - q[i] * q[k];
+            while (heap >= 0 && ratioAtLeast(arcs[heap].keep, arcs[heap].remove, w, 1)) {
+                int x = heap;
+                heap = pop(x);
+                arcs[x].removed = true;
+                arcs[a].keep += w * arcs[x].remove;
+                arcs[a].remove += arcs[x].remove;
+            }
+            while (heap >= 0 && above(heap, a)) {
+                int x = heap;
+                heap = pop(x);
+                arcs[x].tiedTo = a;
+                arcs[a].keep += arcs[x].keep;
+                arcs[a].remove += arcs[x].remove;
+            }
+            heaps[a] = merge(merge, heap, a);
+            done.push_back(a);
+        }
+        stack.push_back(k);
+    }
+
+    // The root region is fanned from v1; the arcs still open are decided now
+    Wide inner = prefix[V], unused = 0;
+    int heap = enclose(0, -1, inner, unused, 0);
+    Wide w = q[0];
+    Wide cost = w * (inner - q[0] * q[1] - q[V - 1] * q[V]);
+    vector<char> kept(arcs.size(), 0);
+    while (heap >= 0) {
+        int x = heap;
+        heap = pop(x);
+        if (ratioAtLeast(arcs[x].keep, arcs[x].remove, w, 1)) {
+            arcs[x].removed = true;
+            cost += w * arcs[x].remove;
+        } else {
+            kept[x] = 1;
+            cost += arcs[x].keep;
+        }
+    }
+
+    Plan plan;
+    plan.cost = cost;
+    plan.mode = "hu-shing";
+    if (n > limit) return plan;
+
+    // Fates follow the arc each one was tied to, which is always created later
+    vector<uint32_t> apexOf(arcs.size());
+    for (int a = (int)arcs.size() - 1; a >= 0; a--) {
+        if (arcs[a].tiedTo >= 0) kept[a] = kept[arcs[a].tiedTo];
+        int up = arcs[a].parent;
+        apexOf[a] = kept[a] ? arcs[a].lo : up >= 0 ? apexOf[up] : 0;
+    }
+    // Every side belongs to the innermost arc around it (-1: the root region)
+    vector<int> owner(V, -1);
+    for (int a = 0; a < (int)arcs.size(); a++) {
+        int c = arcs[a].firstChild;
+        for (size_t k = arcs[a].i; k < arcs[a].j;) {
+            if (c >= 0 && arcs[c].i == k) {
+                k = arcs[c].j;
+                c = arcs[c].nextSibling;
+            } else {
+                owner[k++] = a;
+            }
+        }
+    }
+
+    // apex[(a, b)] = third vertex of the triangle on diagonal or side (a, b), a < b
+    unordered_map<uint64_t, uint32_t> apex;
+    apex.reserve(2 * V);
+    auto triangle = [&](size_t u, size_t r, size_t s) {
+        size_t x[3] = {vertex(u), vertex(r), vertex(s)};
+        if (x[0] == x[1] || x[0] == x[2]) return;   // the apex lies on this edge
+        sort(x, x + 3);
+        apex[(uint64_t)x[0] * V + x[2]] = x[1];
+    };
+    for (size_t k = 0; k < V; k++) triangle(owner[k] < 0 ? 0 : apexOf[owner[k]], k, k + 1);
+    for (int a = 0; a < (int)arcs.size(); a++) {
+        if (kept[a]) triangle(arcs[a].parent < 0 ? 0 : apexOf[arcs[a].parent], arcs[a].i, arcs[a].j);
+    }
+    // Interval [i, j] of matrices is polygon chord (i, j + 1); its apex k+1 splits it
+    plan.parenthesization = parenthesize(n, [&](size_t i, size_t j) {
+        return (size_t)apex[(uint64_t)i * V + j + 1] - 1;
+    });
+    return plan;
+}
+
+Plan solve(const vector<long long>& p, const string& mode, unsigned threads) {
+    if (mode == "hu-shing") return huShing(p, 100000);
+    size_t n = p.size() - 1;
+    long long maxDim = *max_element(p.begin(), p.end());
+    // Every parenthesization costs at most (n - 1) * max(p)^3
+    Wide bound = (Wide)maxDim * maxDim * maxDim * (Wide)(n > 1 ? n - 1 : 1);
+    if (bound < (Wide)LLONG_MAX) return intervalDP<long long>(p, threads);
+    Plan plan = intervalDP<Wide>(p, threads);
+    plan.mode += "-128";
+    return plan;
+}
+
+int runBenchmark(size_t n, unsigned threads) {
+    mt19937_64 rng(13);
+    vector<long long> p(n + 1);
+    for (long long& d : p) d = 10 + rng() % 1000;
+
+    auto timed = [](auto fn, Plan& plan) {
+        auto start = chrono::steady_clock::now();
+        plan = fn();
+        return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    };
+    Plan seq, par, hu, hl;
+    double tSeq = timed([&] { return intervalDP<long long>(p, 1); }, seq);
+    double tPar = timed([&] { return intervalDP<long long>(p, threads); }, par);
+    double tHu = timed([&] { return huShing(p, 0); }, hu);
+    // Hu-Shing alone on a chain a thousand times longer
+    vector<long long> longChain(1000 * n + 1);
+    for (long long& d : longChain) d = 10 + rng() % 1000;
+    double tLong = timed([&] { return huShing(longChain, 0); }, hl);
+
+    cout << "{\"algorithm\":\"Matrix Chain Multiplication\",\"mode\":\"benchmark\",\"matrices\":" << n
+         << ",\"threads\":" << threads << ",\"results\":["
+         << "{\"kernel\":\"exact\",\"cost\":\"" << toString(seq.cost) << "\",\"seconds\":" << tSeq << "},"
+         << "{\"kernel\":\"exact-parallel\",\"cost\":\"" << toString(par.cost) << "\",\"seconds\":" << tPar << "},"
+         << "{\"kernel\":\"hu-shing\",\"cost\":\"" << toString(hu.cost) << "\",\"seconds\":" << tHu << "},"
+         << "{\"kernel\":\"hu-shing\",\"matrices\":" << longChain.size() - 1 << ",\"cost\":\"" << toString(hl.cost)
+         << "\",\"seconds\":" << tLong << "}]"
+         << ",\"consistent\":" << (seq.cost == par.cost && hu.cost == seq.cost ? "true" : "false")
+         << "}" << endl;
+    return 0;
+}
+
 int main(int argc, char* argv[]) {
+    unsigned hardware = max(1u, thread::hardware_concurrency());
+    if (argc >= 2 && string(argv[1]) == "bench") {
+        size_t n = argc >= 3 ? stoull(argv[2]) : 1000;
+        if (n < 2 || n > MAX_EXACT_MATRICES) {
+            cout << "{\"error\":\"Benchmark needs 2 to " << MAX_EXACT_MATRICES << " matrices\"}" << endl;
+            return 1;
+        }
+        return runBenchmark(n, argc >= 4 ? stoul(argv[3]) : hardware);
+    }
     if (argc < 2) {
-        cout << "{\"error\":\"Usage: ./MatrixChainMultiplication <dimensions>\"}" << endl;
+        cout << "{\"error\":\"Usage: ./MatrixChainMultiplication <dimensions | --file path> [exact|hu-shing] [threads] | ./MatrixChainMultiplication bench [n] [threads]\"}" << endl;
         return 1;
     }
-    
-    string dimsStr = argv[1];
-    
+
+    int arg = 1;
+    string dimsStr;
+    if (string(argv[1]) == "--file" && argc >= 3) {
+        ifstream in(argv[2]);
+        stringstream all;
+        all << in.rdbuf();
+        dimsStr = all.str();
+        replace(dimsStr.begin(), dimsStr.end(), '\n', ',');
+        replace(dimsStr.begin(), dimsStr.end(), ' ', ',');
+        arg = 3;
+    } else {
+        dimsStr = argv[1];
+        arg = 2;
+    }
+    string mode = argc > arg ? argv[arg] : "exact";
+    unsigned threads = argc > arg + 1 ? stoul(argv[arg + 1]) : hardware;
+
     // Parse: "40,20,30,10,30"
     stringstream ss(dimsStr);
-    vector<int> dims;
+    vector<long long> dims;
     string val;
-    
+
     while (getline(ss, val, ',')) {
-        dims.push_back(stoi(val));
-    }
-    
-    int n = dims.size() - 1;
-    vector<vector<int>> dp(n, vector<int>(n, 0));
-    
-    for (int len = 2; len <= n; len++) {
-        for (int i = 0; i < n - len + 1; i++) {
-            int j = i + len - 1;
-            dp[i][j] = INT_MAX;
-            
-            for (int k = i; k < j; k++) {
-                int cost = dp[i][k] + dp[k+1][j] + dims[i] * dims[k+1] * dims[j+1];
-                dp[i][j] = min(dp[i][j], cost);
-            }
-        }
+        if (!val.empty()) dims.push_back(stoll(val));
+    }
+
+    if (dims.size() < 2 || (mode != "exact" && mode != "hu-shing") ||
+        *min_element(dims.begin(), dims.end()) <= 0) {
+        cout << "{\"error\":\"Need at least two positive dimensions and mode exact or hu-shing\"}" << endl;
+        return 1;
+    }
+
+    size_t n = dims.size() - 1;
+    // Costs are bounded by (n - 1) * max(p)^3, which has to fit the 128-bit type
+    long double maxDim = *max_element(dims.begin(), dims.end());
+    if (maxDim * maxDim * maxDim * (long double)max<size_t>(n - 1, 1) >= 1e38L) {
+        cout << "{\"error\":\"Dimensions too large: costs could overflow 128 bits\"}" << endl;
+        return 1;
     }
-    
-    int minCost = dp[0][n-1];
-    
+    if (mode == "exact" && n > MAX_EXACT_MATRICES) {
+        cout << "{\"error\":\"Exact mode is limited to " << MAX_EXACT_MATRICES
+             << " matrices (its tables grow as n^2); use hu-shing for longer chains\"}" << endl;
+        return 1;
+    }
+    auto start = chrono::steady_clock::now();
+    Plan plan = n == 1 ? Plan{0, "A1", true, mode} : solve(dims, mode, threads);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
     // Output JSON
-    cout << "{\"algorithm\":\"Matrix Chain Multiplication\",\"matrices\":" << n 
-         << ",\"minMultiplications\":" << minCost << "}" << endl;
-    
+    cout << "{\"algorithm\":\"Matrix Chain Multiplication\",\"matrices\":" << n
+         << ",\"minMultiplications\":" << toString(plan.cost)
+         << ",\"mode\":\"" << plan.mode << "\",\"exact\":" << (plan.exact ? "true" : "false");
+    if (!plan.parenthesization.empty()) cout << ",\"parenthesization\":\"" << plan.parenthesization << "\"";
+    cout << ",\"seconds\":" << seconds << "}" << endl;
+
     return 0;
 }
@@ -1,51 +1,47 @@
 #include <iostream>
 #include <vector>
-#include <queue>
 #include <sstream>
 #include <string>
+#include "../../common/GraphFile.h"
+#include "../../common/TextStream.h"
 using namespace std;
 
 int main(int argc, char* argv[]) {
     if (argc < 4) {
-        cout << "{\"error\":\"Usage: ./BFS <vertices> <edges> <start>\"}" << endl;
+        cout << "{\"error\":\"Usage: ./BFS <vertices> <edges> <start> | ./BFS --graph file.bin <start>\"}" << endl;
         return 1;
     }
     
-    int vertices = stoi(argv[1]);
-    string edgesStr = argv[2];
-    int start = stoi(argv[3]);
-    
-    vector<vector<int>> adj(vertices);
-    
     // Parse edges: "0,1;0,2;1,3"
-    stringstream ss(edgesStr);
-    string edge;
-    while (getline(ss, edge, ';')) {
-        size_t pos = edge.find(',');
-        if (pos != string::npos) {
-            int u = stoi(edge.substr(0, pos));
-            int v = stoi(edge.substr(pos + 1));
-            adj[u].push_back(v);
-            adj[v].push_back(u);
-        }
+    csr::GraphInput input;
+    string error;
+    if (!input.open(argv, false, error)) {
+        cout << "{\"error\":\"" << jsonEscape(error) << "\"}" << endl;
+        return 1;
     }
-    
-    vector<bool> visited(vertices, false);
-    queue<int> q;
-    vector<int> path;
-    
-    visited[start] = true;
-    q.push(start);
-    
-    while (!q.empty()) {
-        int v = q.front();
-        q.pop();
-        path.push_back(v);
-        
-        for (int u : adj[v]) {
+    int vertices = input.vertices();
+    int start = stoi(argv[3]);
+    if (vertices < 1 || start < 0 || start >= vertices) {
+        cout << "{\"error\":\"Start vertex must be in 0..vertices-1\"}" << endl;
+        return 1;
+    }
+    csr::Graph g = input.graph(csr::Undirected);
+    
+    // The path vector doubles as the queue: vertices are appended when
+    // discovered and dequeued by advancing head
+    vector<char> visited(vertices, 0);
+    vector<uint32_t> path;
+    path.reserve(vertices);
+    visited[start] = 1;
+    path.push_back(start);
+    
+    for (size_t head = 0; head < path.size(); head++) {
+        uint32_t v = path[head];
+        for (uint64_t e = g.offsets[v]; e < g.offsets[v + 1]; e++) {
+            uint32_t u = g.targets[e];
             if (!visited[u]) {
-                visited[u] = true;
-                q.push(u);
+                visited[u] = 1;
+                path.push_back(u);
             }
         }
     }
@@ -1,69 +1,69 @@
 #include <iostream>
 #include <vector>
 #include <sstream>
+#include <string>
 #include <climits>
+#include "../../common/GraphFile.h"
+#include "../../common/TextStream.h"
 using namespace std;
 
-struct Edge {
-    int u, v, weight;
-};
+// Rounds relax every edge grouped by source vertex, so each round is one
+// sequential sweep of the CSR arrays; a round that changes nothing ends
+// the search early.
 
 int main(int argc, char* argv[]) {
     if (argc < 4) {
-        cout << "{\"error\":\"Usage: ./BellmanFord <vertices> <edges> <source>\"}" << endl;
+        cout << "{\"error\":\"Usage: ./BellmanFord <vertices> <edges> <source> | ./BellmanFord --graph file.bin <source>\"}" << endl;
         return 1;
     }
     
-    int vertices = stoi(argv[1]);
-    string edgesStr = argv[2];
-    int source = stoi(argv[3]);
-    
-    vector<Edge> edges;
-    
     // Parse edges: "0,1,4;0,2,1;1,2,2;1,3,5"
-    stringstream ss(edgesStr);
-    string edge;
-    while (getline(ss, edge, ';')) {
-        stringstream edgeSS(edge);
-        string val;
-        
-        getline(edgeSS, val, ',');
-        int u = stoi(val);
-        
-        getline(edgeSS, val, ',');
-        int v = stoi(val);
-        
-        getline(edgeSS, val, ',');
-        int w = stoi(val);
-        
-        edges.push_back({u, v, w});
+    csr::GraphInput input;
+    string error;
+    if (!input.open(argv, true, error)) {
+        cout << "{\"error\":\"" << jsonEscape(error) << "\"}" << endl;
+        return 1;
+    }
+    int vertices = input.vertices();
+    int source = stoi(argv[3]);
+    if (vertices < 1 || source < 0 || source >= vertices) {
+        cout << "{\"error\":\"Source vertex must be in 0..vertices-1\"}" << endl;
+        return 1;
     }
+    csr::Graph g = input.graph(csr::Forward);
     
-    vector<int> dist(vertices, INT_MAX);
+    vector<long long> dist(vertices, LLONG_MAX);
     dist[source] = 0;
     
-    for (int i = 0; i < vertices - 1; i++) {
-        for (auto& e : edges) {
-            if (dist[e.u] != INT_MAX && dist[e.u] + e.weight < dist[e.v]) {
-                dist[e.v] = dist[e.u] + e.weight;
+    // One round; with apply == false it only reports whether any edge could relax
+    auto relaxAll = [&](bool apply) {
+        bool changed = false;
+        for (int u = 0; u < vertices; u++) {
+            if (dist[u] == LLONG_MAX) continue;
+            for (uint64_t e = g.offsets[u]; e < g.offsets[u + 1]; e++) {
+                long long candidate = dist[u] + g.weights[e];
+                if (candidate < dist[g.targets[e]]) {
+                    if (!apply) return true;
+                    dist[g.targets[e]] = candidate;
+                    changed = true;
+                }
             }
         }
-    }
+        return changed;
+    };
     
-    bool hasNegativeCycle = false;
-    for (auto& e : edges) {
-        if (dist[e.u] != INT_MAX && dist[e.u] + e.weight < dist[e.v]) {
-            hasNegativeCycle = true;
-            break;
-        }
+    for (int i = 0; i < vertices - 1; i++) {
+        if (!relaxAll(true)) break;
     }
     
+    bool hasNegativeCycle = relaxAll(false);
+    
     cout << "{\"algorithm\":\"Bellman-Ford\",\"source\":" << source 
          << ",\"hasNegativeCycle\":" << (hasNegativeCycle ? "true" : "false")
          << ",\"distances\":[";
     for (int i = 0; i < vertices; i++) {
         if (i > 0) cout << ",";
-        if (dist[i] == INT_MAX) cout << "null";
+        if (dist[i] == LLONG_MAX) cout << "null";
         else cout << dist[i];
     }
     cout << "]}" << endl;
@@ -0,0 +1,205 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include "../../common/GraphFile.h"
+#include "../../common/PointToPoint.h"
+#include "../../common/ContractionHierarchy.h"
+#include "../../common/TextStream.h"
+using namespace std;
+
+// Contraction hierarchies (common/ContractionHierarchy.h): preprocess a
+// weighted graph once, then answer point-to-point queries with two small
+// upward searches. A hierarchy can be built in memory for a single query,
+// or written with --build and mapped back with --ch for every later query.
+// bench compares preprocessing time and query latency against Dijkstra.
+
+double since(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+// Grids with weights 100..149 per step. The road-like variant drops a fifth
+// of the local streets and adds arterials every 16 rows and columns that
+// are three times faster, so a few routes carry most long trips.
+csr::Graph grid(uint32_t side, bool roadLike) {
+    mt19937 rng(49);
+    csr::EdgeList list;
+    list.n = side * side;
+    list.hasWeights = true;
+    for (uint32_t r = 0; r < side; r++) {
+        for (uint32_t c = 0; c < side; c++) {
+            uint32_t v = r * side + c;
+            for (int down = 0; down < 2; down++) {
+                if (down ? r + 1 >= side : c + 1 >= side) continue;
+                bool arterial = roadLike && (down ? c % 16 == 0 : r % 16 == 0);
+                int32_t weight = 100 + rng() % 50;
+                if (roadLike && !arterial && rng() % 5 == 0) continue;
+                list.from.push_back(v);
+                list.to.push_back(down ? v + side : v + 1);
+                list.weight.push_back(arterial ? weight / 3 : weight);
+            }
+        }
+    }
+    return csr::build(list, csr::Undirected);
+}
+
+int runBenchmark(uint32_t side, uint32_t queries) {
+    cout << "{\"algorithm\":\"Contraction Hierarchies\",\"mode\":\"benchmark\",\"side\":" << side << ",\"queries\":" << queries
+         << ",\"results\":[";
+    for (int roadLike = 0; roadLike < 2; roadLike++) {
+        csr::Graph g = grid(side, roadLike);
+        auto start = chrono::steady_clock::now();
+        ch::BuildStats stats;
+        ch::Hierarchy h = ch::build(g, stats);
+        double buildSeconds = since(start);
+
+        mt19937 rng(490 + roadLike);
+        vector<pair<uint32_t, uint32_t>> pairs(queries);
+        for (auto& q : pairs) q = {(uint32_t)(rng() % g.n), (uint32_t)(rng() % g.n)};
+
+        sssp::Labels labels(g.n);
+        sssp::QuadQueue queue(0);
+        vector<int64_t> reference(queries);
+        uint64_t dijkstraSettled = 0;
+        start = chrono::steady_clock::now();
+        for (uint32_t q = 0; q < queries; q++) {
+            sssp::Route route = sssp::astar(g, pairs[q].first, pairs[q].second, sssp::ZeroPotential(), labels, queue);
+            reference[q] = route.distance;
+            dijkstraSettled += route.settled;
+        }
+        double dijkstraSeconds = since(start);
+
+        ch::Query query(g.n);
+        uint64_t settled = 0, stalled = 0;
+        bool consistent = true;
+        start = chrono::steady_clock::now();
+        for (uint32_t q = 0; q < queries; q++) {
+            sssp::Route route = query.run(h, pairs[q].first, pairs[q].second, false);
+            settled += route.settled;
+            stalled += query.stalled;
+            consistent = consistent && route.distance == reference[q];
+        }
+        double querySeconds = since(start);
+
+        // Unpacking is timed separately; every path must add up to its distance
+        start = chrono::steady_clock::now();
+        uint64_t pathVertices = 0;
+        for (uint32_t q = 0; q < queries; q++) {
+            sssp::Route route = query.run(h, pairs[q].first, pairs[q].second);
+            pathVertices += route.path.size();
+            int64_t length = 0;
+            for (size_t i = 1; i < route.path.size(); i++) {
+                int64_t best = sssp::unreachable;
+                for (uint64_t e = g.offsets[route.path[i - 1]]; e < g.offsets[route.path[i - 1] + 1]; e++) {
+                    if (g.targets[e] == route.path[i]) best = min<int64_t>(best, g.weights[e]);
+                }
+                length = best == sssp::unreachable ? best : length + best;
+                if (best == sssp::unreachable) break;
+            }
+            if (route.distance != sssp::unreachable) consistent = consistent && length == route.distance;
+        }
+        double pathSeconds = since(start);
+
+        double per = max<uint32_t>(queries, 1);
+        cout << (roadLike ? "," : "") << "{\"graph\":\"" << (roadLike ? "road-like" : "grid") << "\",\"vertices\":" << g.n
+             << ",\"arcs\":" << stats.originalArcs << ",\"shortcuts\":" << stats.shortcuts << ",\"upArcs\":" << h.up[0].m + h.up[1].m
+             << ",\"buildSeconds\":" << buildSeconds << ",\"dijkstraAvgSettled\":" << dijkstraSettled / per
+             << ",\"dijkstraAvgMicroseconds\":" << 1e6 * dijkstraSeconds / per << ",\"avgSettled\":" << settled / per
+             << ",\"avgStalled\":" << stalled / per << ",\"avgMicroseconds\":" << 1e6 * querySeconds / per
+             << ",\"avgMicrosecondsWithPath\":" << 1e6 * pathSeconds / per << ",\"avgPathVertices\":" << pathVertices / per
+             << ",\"speedup\":" << dijkstraSeconds / max(querySeconds, 1e-12) << ",\"consistent\":" << (consistent ? "true" : "false")
+             << "}";
+    }
+    cout << "]}" << endl;
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    ios::sync_with_stdio(false);
+    bool directed = false;
+    string buildPath, chPath;
+    uint32_t settleLimit = 1000;
+    vector<char*> args = {argv[0]};
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--directed") directed = true;
+        else if (arg == "--build" && i + 1 < argc) buildPath = argv[++i];
+        else if (arg == "--ch" && i + 1 < argc) chPath = argv[++i];
+        else if (arg == "--witness-limit" && i + 1 < argc) settleLimit = max(1ul, stoul(argv[++i]));
+        else args.push_back(argv[i]);
+    }
+    if (args.size() >= 2 && string(args[1]) == "bench") {
+        return runBenchmark(args.size() >= 3 ? stoul(args[2]) : 200, args.size() >= 4 ? stoul(args[3]) : 1000);
+    }
+    size_t needed = !chPath.empty() ? 3 : !buildPath.empty() ? 3 : 5;
+    if (args.size() < needed) {
+        cout << "{\"error\":\"Usage: ./ContractionHierarchy <vertices> <edges> <source> <target> | ./ContractionHierarchy --graph file.bin"
+                " <source> <target> [--directed] [--witness-limit k] | ./ContractionHierarchy --graph file.bin --build out.ch [--directed]"
+                " | ./ContractionHierarchy --ch file.ch <source> <target> | ./ContractionHierarchy bench [side] [queries]\"}" << endl;
+        return 1;
+    }
+
+    string error;
+    ch::Hierarchy h;
+    ch::BuildStats stats;
+    double buildSeconds = 0;
+    size_t at = 1;
+    if (!chPath.empty()) {
+        if (!ch::load(chPath, h, error)) {
+            cout << "{\"error\":\"" << jsonEscape(error) << "\"}" << endl;
+            return 1;
+        }
+    } else {
+        // Parse edges: "0,1,4;0,2,1;1,2,2;1,3,5;2,3,8"
+        csr::GraphInput input;
+        if (!input.open(args.data(), true, error)) {
+            cout << "{\"error\":\"" << jsonEscape(error) << "\"}" << endl;
+            return 1;
+        }
+        csr::Graph g = input.graph(directed ? csr::Forward : csr::Undirected);
+        if (!sssp::nonNegative(g)) {
+            cout << "{\"error\":\"Contraction hierarchies need non-negative edge weights\"}" << endl;
+            return 1;
+        }
+        auto start = chrono::steady_clock::now();
+        h = ch::build(g, stats, settleLimit);
+        buildSeconds = since(start);
+        at = 3;
+    }
+
+    if (!buildPath.empty()) {
+        if (!ch::save(h, buildPath, error)) {
+            cout << "{\"error\":\"" << jsonEscape(error) << "\"}" << endl;
+            return 1;
+        }
+        cout << "{\"algorithm\":\"Contraction Hierarchies\",\"file\":\"" << jsonEscape(buildPath) << "\",\"vertices\":" << h.n
+             << ",\"arcs\":" << stats.originalArcs << ",\"shortcuts\":" << stats.shortcuts << ",\"upArcs\":" << h.up[0].m + h.up[1].m
+             << ",\"witnessSearches\":" << stats.witnessSearches << ",\"directed\":" << (h.symmetric ? "false" : "true")
+             << ",\"seconds\":" << buildSeconds << "}" << endl;
+        return 0;
+    }
+
+    long long source = stoll(args[at]), target = stoll(args[at + 1]);
+    if (source < 0 || target < 0 || source >= h.n || target >= h.n) {
+        cout << "{\"error\":\"Source and target must be in 0..vertices-1\"}" << endl;
+        return 1;
+    }
+    auto start = chrono::steady_clock::now();
+    ch::Query query(h.n);
+    sssp::Route route = query.run(h, source, target);
+    double querySeconds = since(start);
+
+    // Output JSON
+    cout << "{\"algorithm\":\"Contraction Hierarchies\",\"source\":" << source << ",\"target\":" << target << ",\"distance\":";
+    if (route.distance == sssp::unreachable) cout << "null";
+    else cout << route.distance;
+    cout << ",\"path\":[";
+    for (size_t i = 0; i < route.path.size(); i++) cout << (i > 0 ? "," : "") << route.path[i];
+    cout << "],\"directed\":" << (h.symmetric ? "false" : "true") << ",\"upArcs\":" << h.up[0].m + h.up[1].m;
+    if (chPath.empty()) cout << ",\"shortcuts\":" << stats.shortcuts << ",\"buildSeconds\":" << buildSeconds;
+    cout << ",\"settled\":" << route.settled << ",\"stalled\":" << query.stalled << ",\"querySeconds\":" << querySeconds << "}" << endl;
+
+    return 0;
+}
@@ -2,47 +2,57 @@
 #include <vector>
 #include <sstream>
 #include <string>
+#include <utility>
+#include "../../common/GraphFile.h"
+#include "../../common/TextStream.h"
 using namespace std;
 
-void dfsUtil(vector<vector<int>>& adj, int v, vector<bool>& visited, vector<int>& path) {
-    visited[v] = true;
-    path.push_back(v);
+// Preorder DFS with an explicit stack of (vertex, next edge) frames, so deep
+// graphs cannot overflow the call stack; visits in the recursive order
+void dfs(const csr::Graph& g, uint32_t start, vector<char>& visited, vector<uint32_t>& path) {
+    vector<pair<uint32_t, uint64_t>> stack = {{start, g.offsets[start]}};
+    visited[start] = 1;
+    path.push_back(start);
     
-    for (int u : adj[v]) {
+    while (!stack.empty()) {
+        auto& [v, e] = stack.back();
+        if (e == g.offsets[v + 1]) {
+            stack.pop_back();
+            continue;
+        }
+        uint32_t u = g.targets[e++];
         if (!visited[u]) {
-            dfsUtil(adj, u, visited, path);
+            visited[u] = 1;
+            path.push_back(u);
+            stack.push_back({u, g.offsets[u]});
         }
     }
 }
 
 int main(int argc, char* argv[]) {
     if (argc < 4) {
-        cout << "{\"error\":\"Usage: ./DFS <vertices> <edges> <start>\"}" << endl;
+        cout << "{\"error\":\"Usage: ./DFS <vertices> <edges> <start> | ./DFS --graph file.bin <start>\"}" << endl;
         return 1;
     }
     
-    int vertices = stoi(argv[1]);
-    string edgesStr = argv[2];
-    int start = stoi(argv[3]);
-    
-    vector<vector<int>> adj(vertices);
-    
     // Parse edges: "0,1;0,2;1,3"
-    stringstream ss(edgesStr);
-    string edge;
-    while (getline(ss, edge, ';')) {
-        size_t pos = edge.find(',');
-        if (pos != string::npos) {
-            int u = stoi(edge.substr(0, pos));
-            int v = stoi(edge.substr(pos + 1));
-            adj[u].push_back(v);
-            adj[v].push_back(u);
-        }
+    csr::GraphInput input;
+    string error;
+    if (!input.open(argv, false, error)) {
+        cout << "{\"error\":\"" << jsonEscape(error) << "\"}" << endl;
+        return 1;
+    }
+    int vertices = input.vertices();
+    int start = stoi(argv[3]);
+    if (vertices < 1 || start < 0 || start >= vertices) {
+        cout << "{\"error\":\"Start vertex must be in 0..vertices-1\"}" << endl;
+        return 1;
     }
+    csr::Graph g = input.graph(csr::Undirected);
     
-    vector<bool> visited(vertices, false);
-    vector<int> path;
-    dfsUtil(adj, start, visited, path);
+    vector<char> visited(vertices, 0);
+    vector<uint32_t> path;
+    dfs(g, start, visited, path);
     
     // Output JSON
     cout << "{\"algorithm\":\"DFS\",\"start\":" << start << ",\"path\":[";
@@ -0,0 +1,186 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <algorithm>
+#include "../../common/GraphFile.h"
+#include "../../common/ShortestPath.h"
+#include "../../common/DeltaStepping.h"
+#include "../../common/TextStream.h"
+using namespace std;
+
+// Single-source shortest paths by parallel delta-stepping
+// (common/DeltaStepping.h). Edges are undirected unless --directed is given;
+// --delta sets the bucket width (chosen from the weights by default) and
+// --check also runs Dijkstra and compares every distance.
+// bench [vertices] [threads] times it against Dijkstra on a grid and on a
+// random graph of the given size, for 1, 2, 4 .. threads.
+
+double since(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+// Road-like grid (4-neighbour, weights 1..1000) or a random sparse graph
+// with average degree 8; both undirected
+csr::Graph synthetic(const string& kind, uint32_t vertices) {
+    mt19937_64 rng(50);
+    csr::EdgeList list;
+    list.hasWeights = true;
+    if (kind == "grid") {
+        uint32_t side = max(1.0, sqrt((double)vertices));
+        list.n = side * side;
+        for (uint32_t r = 0; r < side; r++) {
+            for (uint32_t c = 0; c < side; c++) {
+                uint32_t v = r * side + c;
+                if (c + 1 < side) {
+                    list.from.push_back(v);
+                    list.to.push_back(v + 1);
+                    list.weight.push_back(1 + rng() % 1000);
+                }
+                if (r + 1 < side) {
+                    list.from.push_back(v);
+                    list.to.push_back(v + side);
+                    list.weight.push_back(1 + rng() % 1000);
+                }
+            }
+        }
+    } else {
+        list.n = vertices;
+        for (uint64_t i = 0; i < 4 * (uint64_t)vertices; i++) {
+            list.from.push_back(rng() % vertices);
+            list.to.push_back(rng() % vertices);
+            list.weight.push_back(1 + rng() % 1000);
+        }
+    }
+    return csr::build(list, csr::Undirected);
+}
+
+int runBenchmark(uint32_t vertices, unsigned maxThreads) {
+    cout << "{\"algorithm\":\"Delta-Stepping\",\"mode\":\"benchmark\",\"hardwareThreads\":" << thread::hardware_concurrency()
+         << ",\"results\":[";
+    bool firstGraph = true;
+    for (const char* kind : {"grid", "random"}) {
+        csr::Graph g = synthetic(kind, vertices);
+        uint32_t source = g.n / 2;
+        sssp::Tree tree;
+        sssp::dijkstra<sssp::RadixQueue>(g, source, tree);   // warm-up
+        auto start = chrono::steady_clock::now();
+        sssp::dijkstra<sssp::QuadQueue>(g, source, tree);
+        double quadSeconds = since(start);
+        start = chrono::steady_clock::now();
+        sssp::dijkstra<sssp::RadixQueue>(g, source, tree);
+        double radixSeconds = since(start);
+        double bestDijkstra = min(quadSeconds, radixSeconds);
+
+        cout << (firstGraph ? "" : ",") << "{\"graph\":\"" << kind << "\",\"vertices\":" << g.n << ",\"arcs\":" << g.m
+             << ",\"dijkstra4arySeconds\":" << quadSeconds << ",\"dijkstraRadixSeconds\":" << radixSeconds << ",\"runs\":[";
+        firstGraph = false;
+        int64_t autoDelta = sssp::chooseDelta(g);
+        double singleSeconds = 0;
+        bool firstRun = true;
+        auto measure = [&](unsigned threads, int64_t delta) {
+            auto built = chrono::steady_clock::now();
+            sssp::DeltaStepping engine(g, delta, threads);
+            double splitSeconds = since(built);
+            vector<int64_t> dist;
+            start = chrono::steady_clock::now();
+            engine.run(source, dist);
+            double seconds = since(start);
+            if (threads == 1 && delta == autoDelta) singleSeconds = seconds;
+            cout << (firstRun ? "" : ",") << "{\"threads\":" << threads << ",\"delta\":" << engine.stats.delta
+                 << ",\"buckets\":" << engine.stats.buckets << ",\"rounds\":" << engine.stats.rounds
+                 << ",\"expansions\":" << engine.stats.expansions << ",\"relaxations\":" << engine.stats.relaxations
+                 << ",\"splitSeconds\":" << splitSeconds << ",\"seconds\":" << seconds
+                 << ",\"speedupVsOneThread\":" << singleSeconds / max(seconds, 1e-12)
+                 << ",\"speedupVsDijkstra\":" << bestDijkstra / max(seconds, 1e-12)
+                 << ",\"identical\":" << (dist == tree.dist ? "true" : "false") << "}";
+            firstRun = false;
+        };
+        for (unsigned threads = 1; threads <= maxThreads; threads *= 2) measure(threads, autoDelta);
+        if ((maxThreads & (maxThreads - 1)) != 0) measure(maxThreads, autoDelta);
+        // How sensitive the choice of delta is, at the full thread count
+        for (int64_t delta : {autoDelta / 8, autoDelta * 8}) {
+            if (delta > 0) measure(maxThreads, delta);
+        }
+        cout << "]}";
+    }
+    cout << "]}" << endl;
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    ios::sync_with_stdio(false);
+    bool directed = false, withList = true, check = false;
+    unsigned threads = max(1u, thread::hardware_concurrency());
+    long long delta = 0;
+    vector<char*> args = {argv[0]};
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--directed") directed = true;
+        else if (arg == "--no-list") withList = false;
+        else if (arg == "--check") check = true;
+        else if (arg == "--threads" && i + 1 < argc) threads = max(1, stoi(argv[++i]));
+        else if (arg == "--delta" && i + 1 < argc) delta = stoll(argv[++i]);
+        else args.push_back(argv[i]);
+    }
+    if (args.size() >= 2 && string(args[1]) == "bench") {
+        return runBenchmark(args.size() >= 3 ? stoul(args[2]) : 1000000, args.size() >= 4 ? max(1, stoi(args[3])) : threads);
+    }
+    if (args.size() < 4) {
+        cout << "{\"error\":\"Usage: ./DeltaStepping <vertices> <edges> <source> | ./DeltaStepping --graph file.bin <source>"
+                " [--directed] [--threads k] [--delta d] [--check] [--no-list] | ./DeltaStepping bench [vertices] [threads]\"}" << endl;
+        return 1;
+    }
+
+    // Parse edges: "0,1,4;0,2,1;1,2,2;1,3,5;2,3,8"
+    csr::GraphInput input;
+    string error;
+    if (!input.open(args.data(), true, error)) {
+        cout << "{\"error\":\"" << jsonEscape(error) << "\"}" << endl;
+        return 1;
+    }
+    int vertices = input.vertices();
+    int source = stoi(args[3]);
+    if (vertices < 1 || source < 0 || source >= vertices) {
+        cout << "{\"error\":\"Source vertex must be in 0..vertices-1\"}" << endl;
+        return 1;
+    }
+    csr::Graph g = input.graph(directed ? csr::Forward : csr::Undirected);
+    if (!sssp::nonNegative(g)) {
+        cout << "{\"error\":\"Delta-stepping needs non-negative edge weights; use Bellman-Ford\"}" << endl;
+        return 1;
+    }
+
+    auto start = chrono::steady_clock::now();
+    sssp::DeltaStepping engine(g, delta, threads);
+    vector<int64_t> dist;
+    engine.run(source, dist);
+    double seconds = since(start);
+
+    // Output JSON
+    cout << "{\"algorithm\":\"Delta-Stepping\",\"source\":" << source;
+    if (withList) {
+        cout << ",\"distances\":[";
+        for (int i = 0; i < vertices; i++) {
+            if (i > 0) cout << ",";
+            if (dist[i] == sssp::unreachable) cout << "null";
+            else cout << dist[i];
+        }
+        cout << "]";
+    }
+    cout << ",\"directed\":" << (directed ? "true" : "false") << ",\"threads\":" << threads << ",\"delta\":" << engine.stats.delta
+         << ",\"deltaChosen\":" << (delta <= 0 ? "true" : "false") << ",\"buckets\":" << engine.stats.buckets
+         << ",\"rounds\":" << engine.stats.rounds << ",\"relaxations\":" << engine.stats.relaxations;
+    if (check) {
+        sssp::Tree tree;
+        auto started = chrono::steady_clock::now();
+        sssp::dijkstra<sssp::QuadQueue>(g, source, tree);
+        double dijkstraSeconds = since(started);
+        cout << ",\"matchesDijkstra\":" << (tree.dist == dist ? "true" : "false") << ",\"dijkstraSeconds\":" << dijkstraSeconds;
+    }
+    cout << ",\"seconds\":" << seconds << "}" << endl;
+
+    return 0;
+}
@@ -1,73 +1,176 @@
 #include <iostream>
 #include <vector>
 #include <queue>
-#include <sstream>
+#include <string>
+#include <chrono>
+#include <random>
 #include <climits>
+#include "../../common/GraphFile.h"
+#include "../../common/ShortestPath.h"
+#include "../../common/TextStream.h"
 using namespace std;
 
-typedef pair<int, int> pii;
+// Dijkstra over the shared engine in common/ShortestPath.h. Edges are
+// undirected unless --directed is given; --heap picks the priority queue
+// (binary, 4ary, indexed or radix) and --target adds the reconstructed path.
+// bench [side] runs every queue on a side x side grid with random weights.
 
-int main(int argc, char* argv[]) {
-    if (argc < 4) {
-        cout << "{\"error\":\"Usage: ./Dijkstra <vertices> <edges> <source>\"}" << endl;
-        return 1;
-    }
-    
-    int vertices = stoi(argv[1]);
-    string edgesStr = argv[2];
-    int source = stoi(argv[3]);
-    
-    vector<vector<pii>> adj(vertices);
-    
-    // Parse edges: "0,1,4;0,2,1;1,2,2;1,3,5;2,3,8"
-    stringstream ss(edgesStr);
-    string edge;
-    while (getline(ss, edge, ';')) {
-        stringstream edgeSS(edge);
-        string val;
-        
-        getline(edgeSS, val, ',');
-        int u = stoi(val);
-        
-        getline(edgeSS, val, ',');
-        int v = stoi(val);
-        
-        getline(edgeSS, val, ',');
-        int w = stoi(val);
-        
-        adj[u].push_back({v, w});
-        adj[v].push_back({u, w});
-    }
-    
-    vector<int> dist(vertices, INT_MAX);
-    priority_queue<pii, vector<pii>, greater<pii>> pq;
-    
+// The previous implementation, kept for the benchmark: it never recognises
+// an outdated queue entry, so every one re-scans its vertex's edges
+long long legacyDijkstra(const csr::Graph& g, uint32_t source, vector<long long>& dist) {
+    dist.assign(g.n, LLONG_MAX);
+    priority_queue<pair<long long, uint32_t>, vector<pair<long long, uint32_t>>, greater<pair<long long, uint32_t>>> pq;
+    long long scans = 0;
     dist[source] = 0;
     pq.push({0, source});
-    
     while (!pq.empty()) {
-        int u = pq.top().second;
+        uint32_t u = pq.top().second;
         pq.pop();
-        
-        for (auto& edge : adj[u]) {
-            int v = edge.first;
-            int weight = edge.second;
-            
-            if (dist[u] + weight < dist[v]) {
-                dist[v] = dist[u] + weight;
+        scans++;
+        for (uint64_t e = g.offsets[u]; e < g.offsets[u + 1]; e++) {
+            uint32_t v = g.targets[e];
+            if (dist[u] + g.weights[e] < dist[v]) {
+                dist[v] = dist[u] + g.weights[e];
                 pq.push({dist[v], v});
             }
         }
     }
-    
+    return scans;
+}
+
+// Road-like grid: 4-neighbour, undirected, weights 1..maxWeight
+csr::Graph grid(uint32_t side, uint32_t maxWeight) {
+    mt19937 rng(47);
+    csr::EdgeList list;
+    list.n = side * side;
+    list.hasWeights = true;
+    for (uint32_t r = 0; r < side; r++) {
+        for (uint32_t c = 0; c < side; c++) {
+            uint32_t v = r * side + c;
+            if (c + 1 < side) {
+                list.from.push_back(v);
+                list.to.push_back(v + 1);
+                list.weight.push_back(1 + rng() % maxWeight);
+            }
+            if (r + 1 < side) {
+                list.from.push_back(v);
+                list.to.push_back(v + side);
+                list.weight.push_back(1 + rng() % maxWeight);
+            }
+        }
+    }
+    return csr::build(list, csr::Undirected);
+}
+
+int runBenchmark(uint32_t side, uint32_t maxWeight) {
+    csr::Graph g = grid(side, maxWeight);
+    uint32_t source = (side / 2) * side + side / 2;
+    auto timed = [](auto fn) {
+        auto start = chrono::steady_clock::now();
+        fn();
+        return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    };
+    vector<long long> legacy;
+    long long scans = 0;
+    legacyDijkstra(g, source, legacy);   // warm-up: fault in the graph and the arrays
+    double tLegacy = timed([&] { scans = legacyDijkstra(g, source, legacy); });
+    cout << "{\"algorithm\":\"Dijkstra\",\"mode\":\"benchmark\",\"vertices\":" << g.n << ",\"arcs\":" << g.m
+         << ",\"results\":[{\"heap\":\"legacy\",\"vertexScans\":" << scans << ",\"seconds\":" << tLegacy << "}";
+    bool consistent = true;
+    for (const char* heap : {"binary", "4ary", "indexed", "radix"}) {
+        sssp::Tree tree;
+        double seconds = timed([&] { sssp::dijkstra(heap, g, source, tree); });
+        for (uint32_t v = 0; v < g.n; v++) consistent = consistent && tree.dist[v] == legacy[v];
+        cout << ",{\"heap\":\"" << heap << "\",\"settled\":" << tree.settled << ",\"pushes\":" << tree.pushes
+             << ",\"staleSkipped\":" << tree.stale << ",\"seconds\":" << seconds << "}";
+    }
+    cout << "],\"consistent\":" << (consistent ? "true" : "false") << "}" << endl;
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    ios::sync_with_stdio(false);
+    bool directed = false, withList = true;
+    string heap = "4ary";
+    long long target = -1;
+    vector<char*> args = {argv[0]};
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--directed") directed = true;
+        else if (arg == "--no-list") withList = false;
+        else if (arg == "--heap" && i + 1 < argc) heap = argv[++i];
+        else if (arg == "--target" && i + 1 < argc) target = stoll(argv[++i]);
+        else args.push_back(argv[i]);
+    }
+    if (args.size() >= 2 && string(args[1]) == "bench") {
+        return runBenchmark(args.size() >= 3 ? stoul(args[2]) : 1000, args.size() >= 4 ? stoul(args[3]) : 1000);
+    }
+    if (args.size() < 4) {
+        cout << "{\"error\":\"Usage: ./Dijkstra <vertices> <edges> <source> | ./Dijkstra --graph file.bin <source>"
+                " [--directed] [--heap binary|4ary|indexed|radix] [--target t] [--no-list] | ./Dijkstra bench [side] [maxWeight]\"}" << endl;
+        return 1;
+    }
+
+    // Parse edges: "0,1,4;0,2,1;1,2,2;1,3,5;2,3,8"
+    csr::GraphInput input;
+    string error;
+    if (!input.open(args.data(), true, error)) {
+        cout << "{\"error\":\"" << jsonEscape(error) << "\"}" << endl;
+        return 1;
+    }
+    int vertices = input.vertices();
+    int source = stoi(args[3]);
+    if (vertices < 1 || source < 0 || source >= vertices) {
+        cout << "{\"error\":\"Source vertex must be in 0..vertices-1\"}" << endl;
+        return 1;
+    }
+    if (target >= vertices) {
+        cout << "{\"error\":\"Target vertex must be in 0..vertices-1\"}" << endl;
+        return 1;
+    }
+    csr::Graph g = input.graph(directed ? csr::Forward : csr::Undirected);
+    if (!sssp::nonNegative(g)) {
+        cout << "{\"error\":\"Dijkstra needs non-negative edge weights; use Bellman-Ford\"}" << endl;
+        return 1;
+    }
+
+    // Without --target every vertex is settled; with it the search stops
+    // as soon as the target is, so only its path is reported
+    auto start = chrono::steady_clock::now();
+    sssp::Tree tree;
+    if (!sssp::dijkstra(heap, g, source, tree, target < 0 ? sssp::noVertex : (uint32_t)target)) {
+        cout << "{\"error\":\"Unknown heap '" << jsonEscape(heap) << "'\"}" << endl;
+        return 1;
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
     // Output JSON
-    cout << "{\"algorithm\":\"Dijkstra\",\"source\":" << source << ",\"distances\":[";
-    for (int i = 0; i < vertices; i++) {
-        if (i > 0) cout << ",";
-        if (dist[i] == INT_MAX) cout << "null";
-        else cout << dist[i];
+    cout << "{\"algorithm\":\"Dijkstra\",\"source\":" << source;
+    if (target >= 0) {
+        cout << ",\"target\":" << target << ",\"distance\":";
+        if (tree.dist[target] == sssp::unreachable) cout << "null";
+        else cout << tree.dist[target];
+        cout << ",\"path\":[";
+        vector<uint32_t> path = tree.pathTo(target);
+        for (size_t i = 0; i < path.size(); i++) cout << (i > 0 ? "," : "") << path[i];
+        cout << "]";
+    } else if (withList) {
+        cout << ",\"distances\":[";
+        for (int i = 0; i < vertices; i++) {
+            if (i > 0) cout << ",";
+            if (tree.dist[i] == sssp::unreachable) cout << "null";
+            else cout << tree.dist[i];
+        }
+        cout << "],\"predecessors\":[";
+        for (int i = 0; i < vertices; i++) {
+            if (i > 0) cout << ",";
+            if (tree.pred[i] == sssp::noVertex) cout << -1;
+            else cout << tree.pred[i];
+        }
+        cout << "]";
     }
-    cout << "]}" << endl;
-    
+    cout << ",\"directed\":" << (directed ? "true" : "false") << ",\"heap\":\"" << heap << "\",\"settled\":" << tree.settled
+         << ",\"staleSkipped\":" << tree.stale << ",\"seconds\":" << seconds << "}" << endl;
+
     return 0;
 }
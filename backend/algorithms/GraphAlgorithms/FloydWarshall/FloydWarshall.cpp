@@ -1,61 +1,63 @@
 #include <iostream>
 #include <vector>
 #include <sstream>
+#include <string>
 #include <climits>
+#include "../../common/GraphFile.h"
+#include "../../common/TextStream.h"
 using namespace std;
 
 int main(int argc, char* argv[]) {
     if (argc < 3) {
-        cout << "{\"error\":\"Usage: ./FloydWarshall <vertices> <edges>\"}" << endl;
+        cout << "{\"error\":\"Usage: ./FloydWarshall <vertices> <edges> | ./FloydWarshall --graph file.bin\"}" << endl;
         return 1;
     }
     
-    int vertices = stoi(argv[1]);
-    string edgesStr = argv[2];
-    
-    vector<vector<int>> dist(vertices, vector<int>(vertices, INT_MAX));
-    
-    for (int i = 0; i < vertices; i++) {
-        dist[i][i] = 0;
+    // Parse edges: "0,1,4;0,2,1;1,2,2"
+    csr::GraphInput input;
+    string error;
+    if (!input.open(argv, true, error)) {
+        cout << "{\"error\":\"" << jsonEscape(error) << "\"}" << endl;
+        return 1;
     }
+    int vertices = input.vertices();
+    if (vertices > 30000) {
+        cout << "{\"error\":\"Floyd-Warshall keeps a dense matrix; " << vertices << " vertices is too many\"}" << endl;
+        return 1;
+    }
+    csr::Graph g = input.graph(csr::Forward);
     
-    // Parse edges: "0,1,4;0,2,1;1,2,2"
-    stringstream ss(edgesStr);
-    string edge;
-    while (getline(ss, edge, ';')) {
-        stringstream edgeSS(edge);
-        string val;
-        
-        getline(edgeSS, val, ',');
-        int u = stoi(val);
-        
-        getline(edgeSS, val, ',');
-        int v = stoi(val);
-        
-        getline(edgeSS, val, ',');
-        int w = stoi(val);
-        
-        dist[u][v] = w;
+    // Flat row-major matrix; a repeated edge keeps the last weight given
+    size_t n = vertices;
+    const long long INF = LLONG_MAX;
+    vector<long long> dist(n * n, INF);
+    for (size_t i = 0; i < n; i++) {
+        dist[i * n + i] = 0;
+        for (uint64_t e = g.offsets[i]; e < g.offsets[i + 1]; e++) {
+            dist[i * n + g.targets[e]] = g.weights[e];
+        }
     }
     
-    for (int k = 0; k < vertices; k++) {
-        for (int i = 0; i < vertices; i++) {
-            for (int j = 0; j < vertices; j++) {
-                if (dist[i][k] != INT_MAX && dist[k][j] != INT_MAX) {
-                    dist[i][j] = min(dist[i][j], dist[i][k] + dist[k][j]);
-                }
+    for (size_t k = 0; k < n; k++) {
+        const long long* rowK = &dist[k * n];
+        for (size_t i = 0; i < n; i++) {
+            long long ik = dist[i * n + k];
+            if (ik == INF) continue;
+            long long* rowI = &dist[i * n];
+            for (size_t j = 0; j < n; j++) {
+                if (rowK[j] != INF && ik + rowK[j] < rowI[j]) rowI[j] = ik + rowK[j];
             }
         }
     }
     
     cout << "{\"algorithm\":\"Floyd-Warshall\",\"distances\":[";
-    for (int i = 0; i < vertices; i++) {
+    for (size_t i = 0; i < n; i++) {
         if (i > 0) cout << ",";
         cout << "[";
-        for (int j = 0; j < vertices; j++) {
+        for (size_t j = 0; j < n; j++) {
             if (j > 0) cout << ",";
-            if (dist[i][j] == INT_MAX) cout << "null";
-            else cout << dist[i][j];
+            if (dist[i * n + j] == INF) cout << "null";
+            else cout << dist[i * n + j];
         }
         cout << "]";
     }
@@ -0,0 +1,297 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <random>
+#include <cstdlib>
+#include <cstdio>
+#include "../../common/GraphFile.h"
+#include "../../common/TextStream.h"
+using namespace std;
+
+// Writes binary graph files (common/GraphFile.h) for --graph:
+//  - from the argv edge format: <vertices> <edges> <out.bin>
+//  - from edge-list text: --text path|- <out.bin>, one "u v [w]" per line
+//    (spaces, tabs or commas; '#' and '%' lines are comments), or with
+//    --dimacs the 9th DIMACS challenge format ("p sp n m", "a u v w",
+//    1-based ids). --coords adds "x y" per vertex, or DIMACS "v id x y".
+// --undirected stores every edge both ways, which is what BFS, DFS,
+// Dijkstra and Prims read; without it the file keeps the given directions.
+// --info file.bin [--verify] reports a file's header (and checks it fully).
+
+double since(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+// Tokens of one text line
+struct LineScanner {
+    const char* p;
+    const char* end;
+
+    bool separator(char c) const { return c == ' ' || c == '\t' || c == ',' || c == '\r'; }
+
+    bool integer(long long& value) {
+        while (p < end && separator(*p)) p++;
+        bool negative = p < end && *p == '-';
+        if (negative || (p < end && *p == '+')) p++;
+        if (p == end || *p < '0' || *p > '9') return false;
+        value = 0;
+        while (p < end && *p >= '0' && *p <= '9') value = value * 10 + (*p++ - '0');
+        if (negative) value = -value;
+        return true;
+    }
+
+    bool real(double& value) {
+        while (p < end && separator(*p)) p++;
+        char buffer[64];
+        size_t len = 0;
+        while (p < end && !separator(*p) && len + 1 < sizeof(buffer)) buffer[len++] = *p++;
+        buffer[len] = '\0';
+        char* stop;
+        value = strtod(buffer, &stop);
+        return len > 0 && *stop == '\0';
+    }
+};
+
+// Calls record(lineNumber, scanner) for every line that is not blank or a
+// comment; stops early when record returns false
+template <typename Record>
+bool forEachLine(const string& path, Record record, string& error) {
+    MappedText text;
+    if (!text.open(path, error)) return false;
+    const char* p = text.data;
+    const char* end = text.data + text.size;
+    size_t lineNumber = 0;
+    while (p < end) {
+        const char* lineEnd = static_cast<const char*>(memchr(p, '\n', end - p));
+        if (!lineEnd) lineEnd = end;
+        lineNumber++;
+        const char* first = p;
+        while (first < lineEnd && (*first == ' ' || *first == '\t' || *first == '\r')) first++;
+        if (first < lineEnd && *first != '#' && *first != '%' && !record(lineNumber, LineScanner{first, lineEnd})) return false;
+        p = lineEnd + 1;
+    }
+    return true;
+}
+
+bool readEdgeText(const string& path, bool weighted, bool dimacs, long long vertices, csr::EdgeList& list, string& error) {
+    long long maxId = -1;
+    list.hasWeights = weighted;
+    bool ok = forEachLine(path, [&](size_t line, LineScanner scan) {
+        auto fail = [&](const string& why) {
+            error = path + ":" + to_string(line) + ": " + why;
+            return false;
+        };
+        long long u, v, w = 0;
+        if (dimacs) {
+            char kind = *scan.p++;
+            if (kind == 'c') return true;
+            if (kind == 'p') {
+                while (scan.p < scan.end && *scan.p == ' ') scan.p++;
+                while (scan.p < scan.end && *scan.p >= 'a' && *scan.p <= 'z') scan.p++;
+                if (!scan.integer(v)) return fail("malformed problem line");
+                if (vertices < 0) vertices = v;
+                return true;
+            }
+            if (kind != 'a' || !scan.integer(u) || !scan.integer(v) || (weighted && !scan.integer(w))) return fail("malformed arc");
+            u--;
+            v--;
+        } else if (!scan.integer(u) || !scan.integer(v) || (weighted && !scan.integer(w))) {
+            return fail(weighted ? "expected u v w" : "expected u v");
+        }
+        if (u < 0 || v < 0 || u >= INT32_MAX || v >= INT32_MAX) return fail("vertex id out of range");
+        if (w < INT32_MIN || w > INT32_MAX) return fail("weight does not fit in 32 bits");
+        maxId = max(maxId, max(u, v));
+        list.from.push_back(u);
+        list.to.push_back(v);
+        if (weighted) list.weight.push_back(w);
+        return true;
+    }, error);
+    if (!ok) return false;
+    if (vertices < 0) vertices = maxId + 1;
+    if (maxId >= vertices) {
+        error = "Edge list names vertex " + to_string(maxId) + " but the graph has " + to_string(vertices) + " vertices";
+        return false;
+    }
+    list.n = vertices;
+    return true;
+}
+
+bool readCoords(const string& path, bool dimacs, uint32_t n, vector<double>& coords, string& error) {
+    coords.assign((size_t)n * 2, 0);
+    size_t next = 0;
+    bool ok = forEachLine(path, [&](size_t line, LineScanner scan) {
+        long long id = next;
+        if (dimacs) {
+            char kind = *scan.p++;
+            if (kind != 'v') return true;
+            if (!scan.integer(id)) id = -1;
+            id--;
+        }
+        double x, y;
+        if (id < 0 || id >= n || !scan.real(x) || !scan.real(y)) {
+            error = path + ":" + to_string(line) + ": expected " + (dimacs ? "v id x y" : "x y") + " for a vertex of the graph";
+            return false;
+        }
+        coords[2 * id] = x;
+        coords[2 * id + 1] = y;
+        next++;
+        return true;
+    }, error);
+    if (ok && next != n) {
+        error = path + " has coordinates for " + to_string(next) + " of " + to_string(n) + " vertices";
+        return false;
+    }
+    return ok;
+}
+
+void printSummary(const csr::Graph& g, const string& path) {
+    cout << "\"file\":\"" << jsonEscape(path) << "\",\"version\":" << csr::fileVersion << ",\"vertices\":" << g.n
+         << ",\"arcs\":" << g.m << ",\"weighted\":" << (g.weighted() ? "true" : "false")
+         << ",\"symmetric\":" << (g.symmetric ? "true" : "false") << ",\"coordinates\":" << (g.coords ? "true" : "false");
+}
+
+int runInfo(const string& path, bool check) {
+    auto start = chrono::steady_clock::now();
+    csr::Graph g;
+    string error;
+    if (!csr::load(path, g, error)) {
+        cout << "{\"error\":\"" << jsonEscape(error) << "\"}" << endl;
+        return 1;
+    }
+    double loadSeconds = since(start);
+    cout << "{\"algorithm\":\"Graph File\",";
+    printSummary(g, path);
+    cout << ",\"loadSeconds\":" << loadSeconds;
+    bool valid = true;
+    if (check) {
+        start = chrono::steady_clock::now();
+        valid = csr::verify(g, error);
+        cout << ",\"valid\":" << (valid ? "true" : "false") << ",\"verifySeconds\":" << since(start);
+        if (!valid) cout << ",\"error\":\"" << jsonEscape(error) << "\"";
+    }
+    cout << "}" << endl;
+    return valid ? 0 : 1;
+}
+
+// Random graph written both as argv-format text and as a graph file, then
+// read back each way: parse + build against mapping + one full pass
+int runBenchmark(const string& path, uint32_t n, uint32_t degree) {
+    mt19937_64 rng(46);
+    csr::EdgeList list;
+    list.n = n;
+    list.hasWeights = true;
+    string text;
+    for (uint64_t e = 0; e < (uint64_t)n * degree; e++) {
+        uint32_t u = rng() % n, v = rng() % n, w = 1 + rng() % 1000;
+        text += to_string(u) + "," + to_string(v) + "," + to_string(w) + ";";
+        list.from.push_back(u);
+        list.to.push_back(v);
+        list.weight.push_back(w);
+    }
+    string error;
+    if (!csr::save(csr::build(list, csr::Forward), path, error)) {
+        cout << "{\"error\":\"" << jsonEscape(error) << "\"}" << endl;
+        return 1;
+    }
+    auto sweep = [](const csr::Graph& g) {
+        long long sum = 0;
+        for (uint64_t e = 0; e < g.m; e++) sum += g.targets[e] + g.weights[e];
+        return sum;
+    };
+
+    auto start = chrono::steady_clock::now();
+    csr::EdgeList parsed;
+    parsed.n = n;
+    csr::parseEdges(text, true, parsed, error);
+    csr::Graph built = csr::build(parsed, csr::Forward);
+    double tParse = since(start);
+    start = chrono::steady_clock::now();
+    csr::Graph mapped;
+    csr::load(path, mapped, error);
+    double tLoad = since(start);
+    start = chrono::steady_clock::now();
+    long long a = sweep(built);
+    double tSweepBuilt = since(start);
+    start = chrono::steady_clock::now();
+    long long b = sweep(mapped);
+    double tSweepMapped = since(start);
+
+    cout << "{\"algorithm\":\"Graph File\",\"mode\":\"benchmark\",\"vertices\":" << n << ",\"arcs\":" << mapped.m
+         << ",\"textBytes\":" << text.size() << ",\"results\":["
+         << "{\"kernel\":\"argv-parse+build\",\"seconds\":" << tParse << ",\"sweepSeconds\":" << tSweepBuilt << "},"
+         << "{\"kernel\":\"mmap-load\",\"seconds\":" << tLoad << ",\"sweepSeconds\":" << tSweepMapped << "}]"
+         << ",\"consistent\":" << (a == b ? "true" : "false") << "}" << endl;
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    ios::sync_with_stdio(false);
+    bool weighted = false, undirected = false, dimacs = false, check = false;
+    long long vertices = -1;
+    string coordsPath;
+    vector<string> args;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--weighted") weighted = true;
+        else if (arg == "--undirected") undirected = true;
+        else if (arg == "--dimacs") dimacs = weighted = true;
+        else if (arg == "--verify") check = true;
+        else if (arg == "--vertices" && i + 1 < argc) vertices = stoll(argv[++i]);
+        else if (arg == "--coords" && i + 1 < argc) coordsPath = argv[++i];
+        else args.push_back(arg);
+    }
+    if (!args.empty() && args[0] == "bench") {
+        if (args.size() < 2) {
+            cout << "{\"error\":\"Usage: ./GraphConvert bench <out.bin> [vertices] [degree]\"}" << endl;
+            return 1;
+        }
+        return runBenchmark(args[1], args.size() >= 3 ? stoul(args[2]) : 1000000, args.size() >= 4 ? stoul(args[3]) : 8);
+    }
+    if (args.size() == 2 && args[0] == "--info") return runInfo(args[1], check);
+    if (args.size() < 3) {
+        cout << "{\"error\":\"Usage: ./GraphConvert <vertices> <edges> <out.bin> [--weighted] [--undirected]"
+                " | ./GraphConvert --text path|- <out.bin> [--vertices n] [--weighted] [--undirected] [--dimacs] [--coords path]"
+                " | ./GraphConvert --info file.bin [--verify] | ./GraphConvert bench <out.bin> [vertices] [degree]\"}" << endl;
+        return 1;
+    }
+
+    auto start = chrono::steady_clock::now();
+    csr::EdgeList list;
+    string error;
+    bool ok;
+    if (args[0] == "--text") {
+        ok = readEdgeText(args[1], weighted, dimacs, vertices, list, error);
+    } else {
+        long long n = stoll(args[0]);
+        ok = n >= 0 && n <= INT32_MAX;
+        if (!ok) error = "Vertex count must be in 0..2147483647";
+        list.n = n;
+        ok = ok && csr::parseEdges(args[1], weighted, list, error);
+    }
+    vector<double> coords;
+    if (ok && !coordsPath.empty()) ok = readCoords(coordsPath, dimacs, list.n, coords, error);
+    if (!ok) {
+        cout << "{\"error\":\"" << jsonEscape(error) << "\"}" << endl;
+        return 1;
+    }
+    double readSeconds = since(start);
+
+    start = chrono::steady_clock::now();
+    csr::Graph g = csr::build(list, undirected ? csr::Undirected : csr::Forward);
+    if (!coords.empty()) g.coords = coords.data();
+    double buildSeconds = since(start);
+    start = chrono::steady_clock::now();
+    if (!csr::save(g, args[2], error)) {
+        cout << "{\"error\":\"" << jsonEscape(error) << "\"}" << endl;
+        return 1;
+    }
+    double writeSeconds = since(start);
+
+    cout << "{\"algorithm\":\"Graph Convert\",";
+    printSummary(g, args[2]);
+    cout << ",\"edges\":" << list.size() << ",\"readSeconds\":" << readSeconds << ",\"buildSeconds\":" << buildSeconds
+         << ",\"writeSeconds\":" << writeSeconds << "}" << endl;
+
+    return 0;
+}
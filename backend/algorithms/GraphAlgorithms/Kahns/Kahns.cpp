@@ -1,55 +1,45 @@
 #include <iostream>
 #include <vector>
-#include <queue>
 #include <sstream>
+#include <string>
+#include "../../common/GraphFile.h"
+#include "../../common/TextStream.h"
 using namespace std;
 
 int main(int argc, char* argv[]) {
     if (argc < 3) {
-        cout << "{\"error\":\"Usage: ./Kahns <vertices> <edges>\"}" << endl;
+        cout << "{\"error\":\"Usage: ./Kahns <vertices> <edges> | ./Kahns --graph file.bin\"}" << endl;
         return 1;
     }
     
-    int vertices = stoi(argv[1]);
-    string edgesStr = argv[2];
-    
-    vector<vector<int>> adj(vertices);
-    vector<int> indegree(vertices, 0);
-    
     // Parse edges: "0,1;0,2;1,3;2,3"
-    stringstream ss(edgesStr);
-    string edge;
-    while (getline(ss, edge, ';')) {
-        stringstream edgeSS(edge);
-        string val;
-        
-        getline(edgeSS, val, ',');
-        int u = stoi(val);
-        
-        getline(edgeSS, val, ',');
-        int v = stoi(val);
-        
-        adj[u].push_back(v);
-        indegree[v]++;
+    csr::GraphInput input;
+    string error;
+    if (!input.open(argv, false, error)) {
+        cout << "{\"error\":\"" << jsonEscape(error) << "\"}" << endl;
+        return 1;
     }
+    int vertices = input.vertices();
+    csr::Graph g = input.graph(csr::Forward);
+    
+    vector<uint32_t> indegree(vertices, 0);
+    for (uint64_t e = 0; e < g.m; e++) indegree[g.targets[e]]++;
     
-    queue<int> q;
+    // order doubles as the FIFO queue
+    vector<uint32_t> order;
+    order.reserve(vertices);
     for (int i = 0; i < vertices; i++) {
         if (indegree[i] == 0) {
-            q.push(i);
+            order.push_back(i);
         }
     }
     
-    vector<int> order;
-    while (!q.empty()) {
-        int u = q.front();
-        q.pop();
-        order.push_back(u);
-        
-        for (int v : adj[u]) {
-            indegree[v]--;
-            if (indegree[v] == 0) {
-                q.push(v);
+    for (size_t head = 0; head < order.size(); head++) {
+        uint32_t u = order[head];
+        for (uint64_t e = g.offsets[u]; e < g.offsets[u + 1]; e++) {
+            uint32_t v = g.targets[e];
+            if (--indegree[v] == 0) {
+                order.push_back(v);
             }
         }
     }
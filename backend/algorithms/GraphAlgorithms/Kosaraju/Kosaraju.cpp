@@ -1,75 +1,88 @@
 #include <iostream>
 #include <vector>
-#include <stack>
 #include <sstream>
+#include <string>
+#include <utility>
+#include <algorithm>
+#include "../../common/GraphFile.h"
+#include "../../common/TextStream.h"
 using namespace std;
 
-void dfs1(int u, vector<vector<int>>& adj, vector<bool>& visited, stack<int>& st) {
-    visited[u] = true;
-    for (int v : adj[u]) {
-        if (!visited[v]) {
-            dfs1(v, adj, visited, st);
+// Both passes use an explicit stack of (vertex, next edge) frames. The first
+// records finish order on the graph, the second collects one component per
+// root on the reverse graph, taking roots in decreasing finish time.
+
+void finishOrder(const csr::Graph& g, uint32_t u, vector<char>& visited, vector<uint32_t>& finished) {
+    vector<pair<uint32_t, uint64_t>> stack = {{u, g.offsets[u]}};
+    visited[u] = 1;
+    while (!stack.empty()) {
+        auto& [v, e] = stack.back();
+        if (e == g.offsets[v + 1]) {
+            finished.push_back(v);
+            stack.pop_back();
+            continue;
+        }
+        uint32_t w = g.targets[e++];
+        if (!visited[w]) {
+            visited[w] = 1;
+            stack.push_back({w, g.offsets[w]});
         }
     }
-    st.push(u);
 }
 
-void dfs2(int u, vector<vector<int>>& adj, vector<bool>& visited, vector<int>& component) {
-    visited[u] = true;
-    component.push_back(u);
-    for (int v : adj[u]) {
-        if (!visited[v]) {
-            dfs2(v, adj, visited, component);
+void collect(const csr::Graph& reverse, uint32_t u, vector<char>& visited, vector<uint32_t>& component) {
+    vector<uint32_t> stack = {u};
+    visited[u] = 1;
+    while (!stack.empty()) {
+        uint32_t v = stack.back();
+        stack.pop_back();
+        component.push_back(v);
+        for (uint64_t e = reverse.offsets[v]; e < reverse.offsets[v + 1]; e++) {
+            uint32_t w = reverse.targets[e];
+            if (!visited[w]) {
+                visited[w] = 1;
+                stack.push_back(w);
+            }
         }
     }
 }
 
 int main(int argc, char* argv[]) {
     if (argc < 3) {
-        cout << "{\"error\":\"Usage: ./Kosaraju <vertices> <edges>\"}" << endl;
+        cout << "{\"error\":\"Usage: ./Kosaraju <vertices> <edges> | ./Kosaraju --graph file.bin\"}" << endl;
         return 1;
     }
     
-    int vertices = stoi(argv[1]);
-    string edgesStr = argv[2];
-    
-    vector<vector<int>> adj(vertices), radj(vertices);
-    
     // Parse edges: "0,1;1,2;2,0;1,3;3,4"
-    stringstream ss(edgesStr);
-    string edge;
-    while (getline(ss, edge, ';')) {
-        stringstream edgeSS(edge);
-        string val;
-        
-        getline(edgeSS, val, ',');
-        int u = stoi(val);
-        
-        getline(edgeSS, val, ',');
-        int v = stoi(val);
-        
-        adj[u].push_back(v);
-        radj[v].push_back(u);
+    csr::GraphInput input;
+    string error;
+    if (!input.open(argv, false, error)) {
+        cout << "{\"error\":\"" << jsonEscape(error) << "\"}" << endl;
+        return 1;
     }
+    int vertices = input.vertices();
+    csr::Graph g = input.graph(csr::Forward);
+    csr::Graph reverse = input.graph(csr::Reverse);
     
-    vector<bool> visited(vertices, false);
-    stack<int> st;
+    vector<char> visited(vertices, 0);
+    vector<uint32_t> finished;
+    finished.reserve(vertices);
     
     for (int i = 0; i < vertices; i++) {
         if (!visited[i]) {
-            dfs1(i, adj, visited, st);
+            finishOrder(g, i, visited, finished);
         }
     }
     
-    fill(visited.begin(), visited.end(), false);
+    fill(visited.begin(), visited.end(), 0);
     int sccCount = 0;
+    vector<uint32_t> component;
     
-    while (!st.empty()) {
-        int u = st.top();
-        st.pop();
+    for (size_t i = finished.size(); i-- > 0;) {
+        uint32_t u = finished[i];
         if (!visited[u]) {
-            vector<int> component;
-            dfs2(u, radj, visited, component);
+            component.clear();
+            collect(reverse, u, visited, component);
             sccCount++;
         }
     }
@@ -2,32 +2,29 @@
 #include <vector>
 #include <algorithm>
 #include <sstream>
+#include <string>
+#include "../../common/GraphFile.h"
+#include "../../common/TextStream.h"
 using namespace std;
 
-struct Edge {
-    int u, v, weight;
-};
-
-bool compare(Edge a, Edge b) {
-    return a.weight < b.weight;
-}
-
 class DSU {
-    vector<int> parent, rank;
+    vector<uint32_t> parent, rank;
 public:
-    DSU(int n) {
-        parent.resize(n);
-        rank.resize(n, 0);
-        for (int i = 0; i < n; i++) parent[i] = i;
+    DSU(uint32_t n) : parent(n), rank(n, 0) {
+        for (uint32_t i = 0; i < n; i++) parent[i] = i;
     }
     
-    int find(int x) {
-        if (parent[x] != x) parent[x] = find(parent[x]);
-        return parent[x];
+    // Path halving keeps lookups iterative
+    uint32_t find(uint32_t x) {
+        while (parent[x] != x) {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
     }
     
-    bool unite(int x, int y) {
-        int px = find(x), py = find(y);
+    bool unite(uint32_t x, uint32_t y) {
+        uint32_t px = find(x), py = find(y);
         if (px == py) return false;
         if (rank[px] < rank[py]) swap(px, py);
         parent[py] = px;
@@ -38,43 +35,33 @@ public:
 
 int main(int argc, char* argv[]) {
     if (argc < 3) {
-        cout << "{\"error\":\"Usage: ./Kruskal <vertices> <edges>\"}" << endl;
+        cout << "{\"error\":\"Usage: ./Kruskal <vertices> <edges> | ./Kruskal --graph file.bin\"}" << endl;
         return 1;
     }
     
-    int vertices = stoi(argv[1]);
-    string edgesStr = argv[2];
-    
-    vector<Edge> edges;
-    
     // Parse edges: "0,1,4;0,2,1;1,2,2;1,3,5"
-    stringstream ss(edgesStr);
-    string edge;
-    while (getline(ss, edge, ';')) {
-        stringstream edgeSS(edge);
-        string val;
-        
-        getline(edgeSS, val, ',');
-        int u = stoi(val);
-        
-        getline(edgeSS, val, ',');
-        int v = stoi(val);
-        
-        getline(edgeSS, val, ',');
-        int w = stoi(val);
-        
-        edges.push_back({u, v, w});
+    csr::GraphInput input;
+    string error;
+    if (!input.open(argv, true, error)) {
+        cout << "{\"error\":\"" << jsonEscape(error) << "\"}" << endl;
+        return 1;
     }
+    int vertices = input.vertices();
+    csr::EdgeList list = input.edges();
     
-    sort(edges.begin(), edges.end(), compare);
+    // Kruskal works on the edge list itself: sort edge ids by weight and
+    // read endpoints from the SoA arrays
+    vector<uint32_t> order(list.size());
+    for (size_t e = 0; e < order.size(); e++) order[e] = e;
+    stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return list.weight[a] < list.weight[b]; });
     
     DSU dsu(vertices);
-    int mstWeight = 0;
+    long long mstWeight = 0;
     int edgeCount = 0;
     
-    for (auto& e : edges) {
-        if (dsu.unite(e.u, e.v)) {
-            mstWeight += e.weight;
+    for (uint32_t e : order) {
+        if (dsu.unite(list.from[e], list.to[e])) {
+            mstWeight += list.weight[e];
             edgeCount++;
         }
     }
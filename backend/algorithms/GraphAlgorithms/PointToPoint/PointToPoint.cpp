@@ -0,0 +1,224 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include "../../common/GraphFile.h"
+#include "../../common/PointToPoint.h"
+#include "../../common/TextStream.h"
+using namespace std;
+
+// Shortest path between one source and one target, by early-stopping
+// Dijkstra, bidirectional Dijkstra, A* on vertex coordinates (graph files
+// converted with --coords) and ALT. Every method's distance and settled
+// count are reported so the searches can be compared on the same query.
+// ALT landmarks are chosen on the fly, or precomputed once with
+// --build-landmarks and passed back as --alt file for every later query.
+
+double since(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+struct Engine {
+    csr::Graph g, reverse;
+    sssp::Labels forward, backward;
+    sssp::QuadQueue forwardQueue{0}, backwardQueue{0};
+    sssp::Landmarks marks;
+    double scale = 0;
+
+    Engine(const csr::Graph& graph, const csr::Graph& transposed)
+        : g(graph), reverse(transposed), forward(graph.n), backward(graph.n) {
+        if (g.coords) scale = sssp::euclideanScale(g);
+    }
+
+    bool run(const string& method, uint32_t s, uint32_t t, sssp::Route& route) {
+        if (method == "dijkstra") route = sssp::astar(g, s, t, sssp::ZeroPotential(), forward, forwardQueue);
+        else if (method == "bidirectional") route = sssp::bidirectional(g, reverse, s, t, forward, backward, forwardQueue, backwardQueue);
+        else if (method == "astar" && g.coords) route = sssp::astar(g, s, t, sssp::EuclideanPotential(g.coords, scale, t), forward, forwardQueue);
+        else if (method == "alt" && marks.count) route = sssp::astar(g, s, t, sssp::LandmarkPotential{marks, t}, forward, forwardQueue);
+        else return false;
+        return true;
+    }
+
+    vector<string> methods() const {
+        vector<string> all = {"dijkstra", "bidirectional"};
+        if (g.coords) all.push_back("astar");
+        if (marks.count) all.push_back("alt");
+        return all;
+    }
+};
+
+// Grid with coordinates; each step costs 100..149 so straight-line distance
+// is a useful bound, like travel times on a road grid
+int runBenchmark(uint32_t side, uint32_t queries, uint32_t landmarks) {
+    mt19937 rng(48);
+    csr::EdgeList list;
+    list.n = side * side;
+    list.hasWeights = true;
+    vector<double> coords(2 * (size_t)list.n);
+    for (uint32_t r = 0; r < side; r++) {
+        for (uint32_t c = 0; c < side; c++) {
+            uint32_t v = r * side + c;
+            coords[2 * v] = c;
+            coords[2 * v + 1] = r;
+            if (c + 1 < side) {
+                list.from.push_back(v);
+                list.to.push_back(v + 1);
+                list.weight.push_back(100 + rng() % 50);
+            }
+            if (r + 1 < side) {
+                list.from.push_back(v);
+                list.to.push_back(v + side);
+                list.weight.push_back(100 + rng() % 50);
+            }
+        }
+    }
+    csr::Graph g = csr::build(list, csr::Undirected);
+    g.coords = coords.data();
+    Engine engine(g, g);
+    auto start = chrono::steady_clock::now();
+    engine.marks = sssp::chooseLandmarks(g, g, landmarks);
+    double landmarkSeconds = since(start);
+
+    vector<pair<uint32_t, uint32_t>> pairs(queries);
+    for (auto& q : pairs) q = {(uint32_t)(rng() % g.n), (uint32_t)(rng() % g.n)};
+    vector<int64_t> reference;
+    bool consistent = true;
+    cout << "{\"algorithm\":\"Point-to-Point\",\"mode\":\"benchmark\",\"vertices\":" << g.n << ",\"arcs\":" << g.m
+         << ",\"queries\":" << queries << ",\"landmarks\":" << engine.marks.count << ",\"landmarkSeconds\":" << landmarkSeconds
+         << ",\"results\":[";
+    vector<string> methods = engine.methods();
+    double baseSettled = 0, baseSeconds = 0;
+    for (size_t m = 0; m < methods.size(); m++) {
+        uint64_t settled = 0;
+        start = chrono::steady_clock::now();
+        for (size_t q = 0; q < pairs.size(); q++) {
+            sssp::Route route;
+            engine.run(methods[m], pairs[q].first, pairs[q].second, route);
+            settled += route.settled;
+            if (m == 0) reference.push_back(route.distance);
+            else consistent = consistent && route.distance == reference[q];
+        }
+        double seconds = since(start);
+        double avgSettled = (double)settled / max<uint32_t>(queries, 1);
+        if (m == 0) {
+            baseSettled = avgSettled;
+            baseSeconds = seconds;
+        }
+        cout << (m > 0 ? "," : "") << "{\"method\":\"" << methods[m] << "\",\"avgSettled\":" << avgSettled
+             << ",\"avgMilliseconds\":" << 1000 * seconds / max<uint32_t>(queries, 1)
+             << ",\"settledVsDijkstra\":" << avgSettled / max(baseSettled, 1.0)
+             << ",\"speedup\":" << baseSeconds / max(seconds, 1e-12) << "}";
+    }
+    cout << "],\"consistent\":" << (consistent ? "true" : "false") << "}" << endl;
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    ios::sync_with_stdio(false);
+    bool directed = false;
+    string method = "all", altPath, buildPath;
+    uint32_t landmarkCount = 8;
+    vector<char*> args = {argv[0]};
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--directed") directed = true;
+        else if (arg == "--method" && i + 1 < argc) method = argv[++i];
+        else if (arg == "--landmarks" && i + 1 < argc) landmarkCount = stoul(argv[++i]);
+        else if (arg == "--alt" && i + 1 < argc) altPath = argv[++i];
+        else if (arg == "--build-landmarks" && i + 1 < argc) buildPath = argv[++i];
+        else args.push_back(argv[i]);
+    }
+    if (args.size() >= 2 && string(args[1]) == "bench") {
+        return runBenchmark(args.size() >= 3 ? stoul(args[2]) : 1000, args.size() >= 4 ? stoul(args[3]) : 100,
+                            args.size() >= 5 ? stoul(args[4]) : 16);
+    }
+    if (args.size() < (buildPath.empty() ? 5u : 3u)) {
+        cout << "{\"error\":\"Usage: ./PointToPoint <vertices> <edges> <source> <target> | ./PointToPoint --graph file.bin <source> <target>"
+                " [--method all|dijkstra|bidirectional|astar|alt] [--directed] [--landmarks k] [--alt file.alt]"
+                " | ./PointToPoint --graph file.bin --build-landmarks out.alt [--landmarks k] [--directed]"
+                " | ./PointToPoint bench [side] [queries] [landmarks]\"}" << endl;
+        return 1;
+    }
+
+    // Parse edges: "0,1,4;0,2,1;1,2,2;1,3,5;2,3,8"
+    csr::GraphInput input;
+    string error;
+    if (!input.open(args.data(), true, error)) {
+        cout << "{\"error\":\"" << jsonEscape(error) << "\"}" << endl;
+        return 1;
+    }
+    csr::Graph g = input.graph(directed ? csr::Forward : csr::Undirected);
+    if (!sssp::nonNegative(g)) {
+        cout << "{\"error\":\"Shortest-path queries need non-negative edge weights\"}" << endl;
+        return 1;
+    }
+    Engine engine(g, g.symmetric ? g : input.graph(csr::Reverse));
+
+    if (!buildPath.empty()) {
+        auto start = chrono::steady_clock::now();
+        engine.marks = sssp::chooseLandmarks(engine.g, engine.reverse, landmarkCount);
+        double seconds = since(start);
+        if (!sssp::saveLandmarks(engine.marks, engine.g, buildPath, error)) {
+            cout << "{\"error\":\"" << jsonEscape(error) << "\"}" << endl;
+            return 1;
+        }
+        cout << "{\"algorithm\":\"ALT Landmarks\",\"file\":\"" << jsonEscape(buildPath) << "\",\"landmarks\":[";
+        for (uint32_t i = 0; i < engine.marks.count; i++) cout << (i > 0 ? "," : "") << engine.marks.ids[i];
+        cout << "],\"directed\":" << (engine.g.symmetric ? "false" : "true") << ",\"seconds\":" << seconds << "}" << endl;
+        return 0;
+    }
+
+    long long source = stoll(args[3]), target = stoll(args[4]);
+    if (source < 0 || target < 0 || source >= g.n || target >= g.n) {
+        cout << "{\"error\":\"Source and target must be in 0..vertices-1\"}" << endl;
+        return 1;
+    }
+    double landmarkSeconds = 0;
+    if (!altPath.empty()) {
+        if (!sssp::loadLandmarks(altPath, engine.g, engine.marks, error)) {
+            cout << "{\"error\":\"" << jsonEscape(error) << "\"}" << endl;
+            return 1;
+        }
+    } else if (method == "all" || method == "alt") {
+        auto start = chrono::steady_clock::now();
+        engine.marks = sssp::chooseLandmarks(engine.g, engine.reverse, landmarkCount);
+        landmarkSeconds = since(start);
+    }
+    vector<string> methods = engine.methods();
+    if (method != "all") {
+        if (find(methods.begin(), methods.end(), method) == methods.end()) {
+            cout << "{\"error\":\"Method '" << method << "' is unknown or unavailable"
+                 << (method == "astar" ? " (A* needs a graph file with coordinates)" : "") << "\"}" << endl;
+            return 1;
+        }
+        methods = {method};
+    }
+
+    // Output JSON
+    cout << "{\"algorithm\":\"Point-to-Point\",\"source\":" << source << ",\"target\":" << target << ",\"results\":[";
+    sssp::Route first;
+    bool consistent = true;
+    for (size_t m = 0; m < methods.size(); m++) {
+        sssp::Route route;
+        auto start = chrono::steady_clock::now();
+        engine.run(methods[m], source, target, route);
+        double seconds = since(start);
+        if (m == 0) first = route;
+        else consistent = consistent && route.distance == first.distance;
+        cout << (m > 0 ? "," : "") << "{\"method\":\"" << methods[m] << "\",\"distance\":";
+        if (route.distance == sssp::unreachable) cout << "null";
+        else cout << route.distance;
+        cout << ",\"settled\":" << route.settled << ",\"seconds\":" << seconds << "}";
+    }
+    cout << "],\"distance\":";
+    if (first.distance == sssp::unreachable) cout << "null";
+    else cout << first.distance;
+    cout << ",\"path\":[";
+    for (size_t i = 0; i < first.path.size(); i++) cout << (i > 0 ? "," : "") << first.path[i];
+    cout << "],\"directed\":" << (directed ? "true" : "false") << ",\"landmarks\":" << engine.marks.count
+         << ",\"landmarkSeconds\":" << landmarkSeconds << ",\"consistent\":" << (consistent ? "true" : "false") << "}" << endl;
+
+    return 0;
+}
@@ -2,49 +2,36 @@
 #include <vector>
 #include <queue>
 #include <sstream>
-#include <climits>
+#include <string>
+#include "../../common/GraphFile.h"
+#include "../../common/TextStream.h"
 using namespace std;
 
-struct Edge {
-    int to, weight;
-};
-
 int main(int argc, char* argv[]) {
     if (argc < 3) {
-        cout << "{\"error\":\"Usage: ./Prims <vertices> <edges>\"}" << endl;
+        cout << "{\"error\":\"Usage: ./Prims <vertices> <edges> | ./Prims --graph file.bin\"}" << endl;
         return 1;
     }
     
-    int vertices = stoi(argv[1]);
-    string edgesStr = argv[2];
-    
-    vector<vector<Edge>> adj(vertices);
-    
     // Parse edges: "0,1,4;0,2,1;1,2,2;1,3,5"
-    stringstream ss(edgesStr);
-    string edge;
-    while (getline(ss, edge, ';')) {
-        stringstream edgeSS(edge);
-        string val;
-        
-        getline(edgeSS, val, ',');
-        int u = stoi(val);
-        
-        getline(edgeSS, val, ',');
-        int v = stoi(val);
-        
-        getline(edgeSS, val, ',');
-        int w = stoi(val);
-        
-        adj[u].push_back({v, w});
-        adj[v].push_back({u, w});
+    csr::GraphInput input;
+    string error;
+    if (!input.open(argv, true, error)) {
+        cout << "{\"error\":\"" << jsonEscape(error) << "\"}" << endl;
+        return 1;
+    }
+    int vertices = input.vertices();
+    if (vertices < 1) {
+        cout << "{\"error\":\"Need at least one vertex\"}" << endl;
+        return 1;
     }
+    csr::Graph g = input.graph(csr::Undirected);
     
     // Prim's algorithm
-    vector<bool> inMST(vertices, false);
+    vector<char> inMST(vertices, 0);
     priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> pq;
     
-    int mstWeight = 0;
+    long long mstWeight = 0;
     int edgeCount = 0;
     
     pq.push({0, 0}); // {weight, vertex}
@@ -55,13 +42,14 @@ int main(int argc, char* argv[]) {
         
         if (inMST[u]) continue;
         
-        inMST[u] = true;
+        inMST[u] = 1;
         mstWeight += weight;
         edgeCount++;
         
-        for (auto& [v, w] : adj[u]) {
+        for (uint64_t e = g.offsets[u]; e < g.offsets[u + 1]; e++) {
+            int v = g.targets[e];
             if (!inMST[v]) {
-                pq.push({w, v});
+                pq.push({g.weights[e], v});
             }
         }
     }
@@ -1,62 +1,63 @@
 #include <iostream>
 #include <vector>
-#include <stack>
 #include <sstream>
+#include <string>
+#include <utility>
+#include "../../common/GraphFile.h"
+#include "../../common/TextStream.h"
 using namespace std;
 
-void dfs(int u, vector<vector<int>>& adj, vector<bool>& visited, stack<int>& st) {
-    visited[u] = true;
-    for (int v : adj[u]) {
-        if (!visited[v]) {
-            dfs(v, adj, visited, st);
+// Appends u's DFS postorder to finished, with an explicit stack of
+// (vertex, next edge) frames instead of recursion
+void dfs(const csr::Graph& g, uint32_t u, vector<char>& visited, vector<uint32_t>& finished) {
+    vector<pair<uint32_t, uint64_t>> stack = {{u, g.offsets[u]}};
+    visited[u] = 1;
+    while (!stack.empty()) {
+        auto& [v, e] = stack.back();
+        if (e == g.offsets[v + 1]) {
+            finished.push_back(v);
+            stack.pop_back();
+            continue;
+        }
+        uint32_t w = g.targets[e++];
+        if (!visited[w]) {
+            visited[w] = 1;
+            stack.push_back({w, g.offsets[w]});
         }
     }
-    st.push(u);
 }
 
 int main(int argc, char* argv[]) {
     if (argc < 3) {
-        cout << "{\"error\":\"Usage: ./TopologicalSort <vertices> <edges>\"}" << endl;
+        cout << "{\"error\":\"Usage: ./TopologicalSort <vertices> <edges> | ./TopologicalSort --graph file.bin\"}" << endl;
         return 1;
     }
     
-    int vertices = stoi(argv[1]);
-    string edgesStr = argv[2];
-    
-    vector<vector<int>> adj(vertices);
-    
     // Parse edges: "0,1;0,2;1,3;2,3"
-    stringstream ss(edgesStr);
-    string edge;
-    while (getline(ss, edge, ';')) {
-        stringstream edgeSS(edge);
-        string val;
-        
-        getline(edgeSS, val, ',');
-        int u = stoi(val);
-        
-        getline(edgeSS, val, ',');
-        int v = stoi(val);
-        
-        adj[u].push_back(v);
+    csr::GraphInput input;
+    string error;
+    if (!input.open(argv, false, error)) {
+        cout << "{\"error\":\"" << jsonEscape(error) << "\"}" << endl;
+        return 1;
     }
+    int vertices = input.vertices();
+    csr::Graph g = input.graph(csr::Forward);
     
-    vector<bool> visited(vertices, false);
-    stack<int> st;
+    vector<char> visited(vertices, 0);
+    vector<uint32_t> finished;
+    finished.reserve(vertices);
     
     for (int i = 0; i < vertices; i++) {
         if (!visited[i]) {
-            dfs(i, adj, visited, st);
+            dfs(g, i, visited, finished);
         }
     }
     
+    // Reverse postorder
     cout << "{\"algorithm\":\"Topological Sort\",\"order\":[";
-    bool first = true;
-    while (!st.empty()) {
-        if (!first) cout << ",";
-        cout << st.top();
-        st.pop();
-        first = false;
+    for (size_t i = finished.size(); i-- > 0;) {
+        cout << finished[i];
+        if (i > 0) cout << ",";
     }
     cout << "]}" << endl;
     
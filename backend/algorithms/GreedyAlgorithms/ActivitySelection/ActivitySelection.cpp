@@ -2,66 +2,193 @@
 #include <vector>
 #include <algorithm>
 #include <sstream>
+#include <string>
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include "../../common/NumberStream.h"
+#include "../../common/IntervalSchedule.h"
+#include "../../common/TextStream.h"
 using namespace std;
 
-struct Activity {
-    int start, finish, index;
-};
+// Activities occupy [start, finish). Modes:
+//  - select (default): earliest-finish greedy, the most activities that fit
+//  - --weighted: maximum total weight instead (sort + predecessor DP)
+//  - --rooms: the fewest rooms that hold every activity (min-heap sweep)
+//  - --stream path|-: the greedy over input already sorted by finish (ties
+//    by start), printing picks as they are found without storing anything
+// --file path|- reads large inputs (start,finish[,weight] per record) for the
+// first three modes.
 
-bool compare(Activity a, Activity b) {
-    return a.finish < b.finish;
+typedef intervals::Interval Activity;
+
+vector<size_t> selectGreedy(vector<Activity>& activities) {
+    stable_sort(activities.begin(), activities.end(), intervals::byFinish);
+    vector<size_t> selected;
+    long long lastFinish = 0;
+    for (size_t i = 0; i < activities.size(); i++) {
+        if (selected.empty() || activities[i].start >= lastFinish) {
+            selected.push_back(i);
+            lastFinish = activities[i].finish;
+        }
+    }
+    return selected;
 }
 
-int main(int argc, char* argv[]) {
-    if (argc < 2) {
-        cout << "{\"error\":\"Usage: ./ActivitySelection <activities>\"}" << endl;
+// O(1) memory: input must already be sorted by finish, then start. The start
+// order only matters for empty activities, which [s, s) after [s - 1, s)
+// would otherwise lose.
+int runStream(const string& path, bool withList) {
+    NumberStream in;
+    string error;
+    if (!in.open(path, error)) {
+        cout << "{\"error\":\"" << jsonEscape(error) << "\"}" << endl;
         return 1;
     }
-    
-    string activitiesStr = argv[1];
-    
-    // Parse: "6;1,3;2,5;0,6;5,7;8,9;5,9"
-    stringstream ss(activitiesStr);
-    string token;
-    getline(ss, token, ';');
-    int n = stoi(token);
-    
+    auto start = chrono::steady_clock::now();
+    cout << "{\"algorithm\":\"Activity Selection\",\"mode\":\"stream\"";
+    if (withList) cout << ",\"selected\":[";
+    long long s, f, lastFinish = 0, prevStart = 0, prevFinish = 0;
+    size_t index = 0, count = 0;
+    bool sorted = true;
+    while (in.next(s) && in.next(f)) {
+        if (index > 0 && (f < prevFinish || (f == prevFinish && s < prevStart))) {
+            sorted = false;
+            break;
+        }
+        prevStart = s;
+        prevFinish = f;
+        if (count == 0 || s >= lastFinish) {
+            if (withList) cout << (count > 0 ? "," : "") << index;
+            count++;
+            lastFinish = f;
+        }
+        index++;
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    if (withList) cout << "]";
+    cout << ",\"totalActivities\":" << index << ",\"selectedCount\":" << count << ",\"bytesRead\":" << in.bytes()
+         << ",\"seconds\":" << seconds;
+    if (!sorted) cout << ",\"error\":\"Input is not sorted by finish, then start, at activity " << index << "\"";
+    cout << "}" << endl;
+    return sorted ? 0 : 1;
+}
+
+int runBenchmark(size_t n) {
+    mt19937_64 rng(9);
     vector<Activity> activities(n);
-    for (int i = 0; i < n; i++) {
-        getline(ss, token, ';');
-        stringstream actSS(token);
-        string val;
-        
-        getline(actSS, val, ',');
-        activities[i].start = stoi(val);
-        
-        getline(actSS, val, ',');
-        activities[i].finish = stoi(val);
-        
-        activities[i].index = i;
+    for (size_t i = 0; i < n; i++) {
+        long long s = rng() % (10 * n);
+        activities[i] = {s, s + 1 + (long long)(rng() % 100), 1 + (long long)(rng() % 1000), (long long)i};
     }
-    
-    sort(activities.begin(), activities.end(), compare);
-    
-    vector<int> selected;
-    selected.push_back(activities[0].index);
-    int lastFinish = activities[0].finish;
-    
-    for (int i = 1; i < n; i++) {
-        if (activities[i].start >= lastFinish) {
-            selected.push_back(activities[i].index);
-            lastFinish = activities[i].finish;
+    auto timed = [](auto fn) {
+        auto start = chrono::steady_clock::now();
+        fn();
+        return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    };
+    vector<Activity> copy = activities;
+    vector<size_t> selected, chosen;
+    vector<uint32_t> room;
+    long long weight = 0;
+    size_t rooms = 0;
+    double tSelect = timed([&] { selected = selectGreedy(copy); });
+    copy = activities;
+    double tWeighted = timed([&] { weight = intervals::weightedSchedule(copy, chosen); });
+    double tRooms = timed([&] { rooms = intervals::assignRooms(activities, room); });
+    cout << "{\"algorithm\":\"Activity Selection\",\"mode\":\"benchmark\",\"activities\":" << n << ",\"results\":["
+         << "{\"kernel\":\"select\",\"selectedCount\":" << selected.size() << ",\"seconds\":" << tSelect << "},"
+         << "{\"kernel\":\"weighted\",\"totalWeight\":" << weight << ",\"selectedCount\":" << chosen.size()
+         << ",\"seconds\":" << tWeighted << "},"
+         << "{\"kernel\":\"rooms\",\"rooms\":" << rooms << ",\"seconds\":" << tRooms << "}]}" << endl;
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    ios::sync_with_stdio(false);
+    string mode = "select";
+    bool withList = true;
+    vector<string> args;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--weighted") mode = "weighted";
+        else if (arg == "--rooms") mode = "rooms";
+        else if (arg == "--no-list") withList = false;
+        else args.push_back(arg);
+    }
+    if (!args.empty() && args[0] == "bench") return runBenchmark(args.size() >= 2 ? stoull(args[1]) : 1000000);
+    if (args.size() >= 2 && args[0] == "--stream") return runStream(args[1], withList);
+    if (args.empty() || ((args[0] == "--file" || args[0] == "--stream") && args.size() < 2)) {
+        cout << "{\"error\":\"Usage: ./ActivitySelection <activities | --file path|-> [--weighted | --rooms] [--no-list]"
+                " | ./ActivitySelection --stream path|- [--no-list] | ./ActivitySelection bench [n]\"}" << endl;
+        return 1;
+    }
+
+    // Records are start,finish or, with --weighted, start,finish,weight
+    int fields = mode == "weighted" ? 3 : 2;
+    vector<Activity> activities;
+    if (args[0] == "--file") {
+        NumberStream in;
+        string error;
+        if (!in.open(args[1], error)) {
+            cout << "{\"error\":\"" << jsonEscape(error) << "\"}" << endl;
+            return 1;
+        }
+        long long f[3] = {0, 0, 1};
+        for (;;) {
+            int got = 0;
+            while (got < fields && in.next(f[got])) got++;
+            if (got < fields) break;
+            activities.push_back({f[0], f[1], f[2], (long long)activities.size()});
+        }
+    } else {
+        // Parse: "6;1,3;2,5;0,6;5,7;8,9;5,9"
+        stringstream ss(args[0]);
+        string token;
+        getline(ss, token, ';');
+        int n = stoi(token);
+        for (int i = 0; i < n; i++) {
+            getline(ss, token, ';');
+            stringstream actSS(token);
+            string val;
+            long long f[3] = {0, 0, 1};
+            for (int k = 0; k < fields; k++) {
+                getline(actSS, val, ',');
+                f[k] = stoll(val);
+            }
+            activities.push_back({f[0], f[1], f[2], i});
         }
     }
-    
+
+    size_t n = activities.size();
+    auto start = chrono::steady_clock::now();
+    vector<size_t> picked;
+    vector<uint32_t> room;
+    long long totalWeight = 0;
+    size_t rooms = 0;
+    if (mode == "select") picked = selectGreedy(activities);
+    else if (mode == "weighted") totalWeight = intervals::weightedSchedule(activities, picked);
+    else rooms = intervals::assignRooms(activities, room);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
     // Output JSON
-    cout << "{\"algorithm\":\"Activity Selection\",\"totalActivities\":" << n 
-         << ",\"selectedCount\":" << selected.size() << ",\"selected\":[";
-    for (size_t i = 0; i < selected.size(); i++) {
-        if (i > 0) cout << ",";
-        cout << selected[i];
+    cout << "{\"algorithm\":\"Activity Selection\",\"mode\":\"" << mode << "\",\"totalActivities\":" << n;
+    if (mode == "rooms") {
+        cout << ",\"rooms\":" << rooms;
+        if (withList) {
+            cout << ",\"room\":[";
+            for (size_t i = 0; i < n; i++) cout << (i > 0 ? "," : "") << room[i];
+            cout << "]";
+        }
+    } else {
+        cout << ",\"selectedCount\":" << picked.size();
+        if (mode == "weighted") cout << ",\"totalWeight\":" << totalWeight;
+        if (withList) {
+            cout << ",\"selected\":[";
+            for (size_t i = 0; i < picked.size(); i++) cout << (i > 0 ? "," : "") << activities[picked[i]].id;
+            cout << "]";
+        }
     }
-    cout << "]}" << endl;
-    
+    cout << ",\"seconds\":" << seconds << "}" << endl;
+
     return 0;
 }
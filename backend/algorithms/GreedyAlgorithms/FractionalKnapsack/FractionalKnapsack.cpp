@@ -1,68 +1,361 @@
 #include <iostream>
+#include <iomanip>
 #include <vector>
 #include <algorithm>
 #include <sstream>
+#include <string>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <cstdint>
+#include "../../common/NumberStream.h"
+#include "../../common/TextStream.h"
 using namespace std;
 
+// Fractional knapsack. Every item whose value/weight ratio beats some
+// threshold is taken whole, the items at the threshold fill what is left
+// (one of them possibly in part), and everything below is skipped, so the
+// threshold can be found by selection instead of sorting:
+//  - sort: order all items by ratio and fill (O(n log n)); also produces the
+//    step-by-step trace the visualizer shows
+//  - select: quickselect on ratio. Partition around a random pivot into
+//    better / equal / worse; if the better items alone overflow the
+//    capacity, recurse into them, else take them and go on with the rest.
+//    Expected O(n).
+//  - parallel: the same rounds with each partition counted and compacted by
+//    threads, finishing sequentially once the range is small
+// Ratios are never divided: a/b vs c/d compares a*d with c*b, exact in 64
+// bits for the 31-bit values and weights accepted here.
+
+const long long MAX_FIELD = (1LL << 31) - 1;
+
 struct Item {
-    int value, weight;
-    double ratio;
-    int index;
+    long long value, weight;
+};
+
+// Sign of ratio(a) - ratio(b)
+inline int compareRatio(const Item& a, const Item& b) {
+    long long l = a.value * b.weight, r = b.value * a.weight;
+    return (l > r) - (l < r);
+}
+
+struct Fill {
+    vector<uint32_t> whole;     // items taken completely
+    long long partial = -1;     // item taken in part, if any
+    double fraction = 0;
+    long long partialValue = 0, wholeValue = 0, usedWeight = 0;
+
+    double value() const { return wholeValue + (partial >= 0 ? fraction * partialValue : 0.0); }
+
+    void take(const vector<Item>& items, uint32_t i) {
+        whole.push_back(i);
+        wholeValue += items[i].value;
+        usedWeight += items[i].weight;
+    }
+    // Takes as much of i as fits; true once the knapsack is full
+    bool fillWith(const vector<Item>& items, uint32_t i, long long& capacity) {
+        if (capacity == 0) return true;
+        if (items[i].weight <= capacity) {
+            take(items, i);
+            capacity -= items[i].weight;
+            return capacity == 0;
+        }
+        partial = i;
+        fraction = (double)capacity / items[i].weight;
+        partialValue = items[i].value;
+        usedWeight += capacity;
+        capacity = 0;
+        return true;
+    }
+};
+
+struct Step {
+    uint32_t index;
+    double fraction, totalValue;
 };
 
-bool compare(Item a, Item b) {
-    return a.ratio > b.ratio;
+Fill sortFill(const vector<Item>& items, long long capacity, vector<Step>* trace) {
+    vector<uint32_t> order(items.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = i;
+    stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        if (items[a].weight == 0 || items[b].weight == 0) return items[a].weight == 0 && items[b].weight != 0;
+        return compareRatio(items[a], items[b]) > 0;
+    });
+    Fill fill;
+    bool full = false;
+    for (uint32_t i : order) {
+        double f = 0;
+        if (!full && items[i].weight == 0) {
+            fill.take(items, i);
+            f = 1;
+        } else if (!full) {
+            size_t before = fill.whole.size();
+            full = fill.fillWith(items, i, capacity);
+            f = fill.whole.size() > before ? 1 : fill.partial == (long long)i ? fill.fraction : 0;
+        }
+        if (trace) trace->push_back({i, f, fill.value()});
+    }
+    return fill;
+}
+
+// Three-way partition of idx[lo, hi) around pivot: [lo, a) better,
+// [a, b) equal, [b, hi) worse. Returns the weight of the better part.
+long long partition3(const vector<Item>& items, vector<uint32_t>& idx, size_t lo, size_t hi, const Item& pivot,
+                     size_t& a, size_t& b) {
+    long long better = 0;
+    size_t i = lo, lt = lo, gt = hi;
+    while (i < gt) {
+        int c = compareRatio(items[idx[i]], pivot);
+        if (c > 0) {
+            better += items[idx[i]].weight;
+            swap(idx[i++], idx[lt++]);
+        } else if (c < 0) {
+            swap(idx[i], idx[--gt]);
+        } else {
+            i++;
+        }
+    }
+    a = lt;
+    b = gt;
+    return better;
+}
+
+// Continues a fill over candidates idx (all of positive weight)
+void selectInto(const vector<Item>& items, vector<uint32_t>& idx, long long capacity, Fill& fill, mt19937_64& rng) {
+    size_t lo = 0, hi = idx.size();
+    while (lo < hi && capacity > 0) {
+        Item pivot = items[idx[lo + rng() % (hi - lo)]];
+        size_t a, b;
+        long long better = partition3(items, idx, lo, hi, pivot, a, b);
+        if (better > capacity) {
+            hi = a;
+            continue;
+        }
+        for (size_t k = lo; k < a; k++) fill.take(items, idx[k]);
+        capacity -= better;
+        for (size_t k = a; k < b; k++) {
+            if (fill.fillWith(items, idx[k], capacity)) return;
+        }
+        lo = b;
+    }
+}
+
+// Zero-weight items cost nothing and are always taken
+Fill prepare(const vector<Item>& items, vector<uint32_t>& idx) {
+    Fill fill;
+    for (size_t i = 0; i < items.size(); i++) {
+        if (items[i].weight == 0) fill.take(items, i);
+        else idx.push_back(i);
+    }
+    return fill;
+}
+
+Fill selectFill(const vector<Item>& items, long long capacity) {
+    vector<uint32_t> idx;
+    Fill fill = prepare(items, idx);
+    mt19937_64 rng(42);
+    selectInto(items, idx, capacity, fill, rng);
+    return fill;
+}
+
+Fill parallelFill(const vector<Item>& items, long long capacity, unsigned threads) {
+    vector<uint32_t> cur;
+    Fill fill = prepare(items, cur);
+    mt19937_64 rng(42);
+    vector<uint32_t> next;
+    struct Counts { size_t better = 0, equal = 0, worse = 0; long long betterWeight = 0, equalWeight = 0; };
+    vector<Counts> counts(threads);
+
+    auto run = [&](auto body) {
+        vector<thread> workers;
+        size_t per = (cur.size() + threads - 1) / threads;
+        for (unsigned t = 0; t < threads; t++) {
+            workers.emplace_back([&, t]() { body(t, min(cur.size(), t * per), min(cur.size(), (t + 1) * per)); });
+        }
+        for (auto& w : workers) w.join();
+    };
+    // Copies the class-c elements of cur (1 better, 0 equal, -1 worse) to out, keeping order
+    auto compact = [&](const Item& pivot, int c, vector<uint32_t>& out) {
+        vector<size_t> offset(threads + 1, 0);
+        for (unsigned t = 0; t < threads; t++) {
+            offset[t + 1] = offset[t] + (c > 0 ? counts[t].better : c == 0 ? counts[t].equal : counts[t].worse);
+        }
+        out.resize(offset[threads]);
+        run([&](unsigned t, size_t from, size_t to) {
+            size_t w = offset[t];
+            for (size_t k = from; k < to; k++) {
+                if (compareRatio(items[cur[k]], pivot) == c) out[w++] = cur[k];
+            }
+        });
+    };
+
+    while (cur.size() > (size_t(1) << 16) && capacity > 0) {
+        Item pivot = items[cur[rng() % cur.size()]];
+        run([&](unsigned t, size_t from, size_t to) {
+            Counts c;
+            for (size_t k = from; k < to; k++) {
+                const Item& it = items[cur[k]];
+                int r = compareRatio(it, pivot);
+                if (r > 0) c.better++, c.betterWeight += it.weight;
+                else if (r == 0) c.equal++, c.equalWeight += it.weight;
+                else c.worse++;
+            }
+            counts[t] = c;
+        });
+        long long betterWeight = 0, equalWeight = 0;
+        for (auto& c : counts) betterWeight += c.betterWeight, equalWeight += c.equalWeight;
+
+        if (betterWeight > capacity) {
+            compact(pivot, 1, next);
+            cur.swap(next);
+            continue;
+        }
+        compact(pivot, 1, next);
+        for (uint32_t i : next) fill.take(items, i);
+        capacity -= betterWeight;
+        if (equalWeight >= capacity) {
+            compact(pivot, 0, next);
+            for (uint32_t i : next) {
+                if (fill.fillWith(items, i, capacity)) break;
+            }
+            return fill;
+        }
+        compact(pivot, 0, next);
+        for (uint32_t i : next) fill.take(items, i);
+        capacity -= equalWeight;
+        compact(pivot, -1, next);
+        cur.swap(next);
+    }
+    selectInto(items, cur, capacity, fill, rng);
+    return fill;
+}
+
+Fill solve(const vector<Item>& items, long long capacity, const string& mode, unsigned threads, vector<Step>* trace) {
+    if (mode == "select") return selectFill(items, capacity);
+    if (mode == "parallel") return parallelFill(items, capacity, max(1u, threads));
+    return sortFill(items, capacity, trace);
+}
+
+int runBenchmark(size_t n, unsigned threads) {
+    mt19937_64 rng(3);
+    vector<Item> items(n);
+    long long total = 0;
+    for (Item& it : items) {
+        it = {1 + (long long)(rng() % 1000000), 1 + (long long)(rng() % 1000000)};
+        total += it.weight;
+    }
+    long long capacity = total / 3;
+    auto timed = [](auto fn) {
+        auto start = chrono::steady_clock::now();
+        fn();
+        return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    };
+    Fill bySort, bySelect, byParallel;
+    double tSort = timed([&] { bySort = sortFill(items, capacity, nullptr); });
+    double tSelect = timed([&] { bySelect = selectFill(items, capacity); });
+    double tParallel = timed([&] { byParallel = parallelFill(items, capacity, threads); });
+    auto same = [&](const Fill& f) { return abs(f.value() - bySort.value()) <= 1e-9 * bySort.value() + 1e-6; };
+    cout << setprecision(15) << "{\"algorithm\":\"Fractional Knapsack\",\"mode\":\"benchmark\",\"items\":" << n
+         << ",\"capacity\":" << capacity << ",\"threads\":" << threads << ",\"results\":["
+         << "{\"kernel\":\"sort\",\"maxValue\":" << bySort.value() << ",\"seconds\":" << tSort << "},"
+         << "{\"kernel\":\"select\",\"maxValue\":" << bySelect.value() << ",\"seconds\":" << tSelect << "},"
+         << "{\"kernel\":\"parallel\",\"maxValue\":" << byParallel.value() << ",\"seconds\":" << tParallel << "}]"
+         << ",\"consistent\":" << (same(bySelect) && same(byParallel) ? "true" : "false") << "}" << endl;
+    return 0;
 }
 
 int main(int argc, char* argv[]) {
-    if (argc < 3) {
-        cout << "{\"error\":\"Usage: ./FractionalKnapsack <capacity> <items>\"}" << endl;
+    ios::sync_with_stdio(false);
+    unsigned threads = max(1u, thread::hardware_concurrency());
+    bool withList = true;
+    vector<string> args;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--no-list") withList = false;
+        else args.push_back(arg);
+    }
+    if (!args.empty() && args[0] == "bench") {
+        return runBenchmark(args.size() >= 2 ? stoull(args[1]) : 5000000, args.size() >= 3 ? stoul(args[2]) : threads);
+    }
+    if (args.size() < 2 || (args[1] == "--file" && args.size() < 3)) {
+        cout << "{\"error\":\"Usage: ./FractionalKnapsack <capacity> <items | --file path|-> [sort|select|parallel] "
+                "[threads] [--no-list] | ./FractionalKnapsack bench [n] [threads]\"}" << endl;
         return 1;
     }
-    
-    int capacity = stoi(argv[1]);
-    string itemsStr = argv[2];
-    
-    // Parse: "3;60,10;100,20;120,30"
-    stringstream ss(itemsStr);
-    string token;
-    getline(ss, token, ';');
-    int n = stoi(token);
-    
-    vector<Item> items(n);
-    for (int i = 0; i < n; i++) {
+
+    long long capacity = stoll(args[0]);
+    vector<Item> items;
+    size_t next;
+    if (args[1] == "--file") {
+        NumberStream in;
+        string error;
+        if (!in.open(args[2], error)) {
+            cout << "{\"error\":\"" << jsonEscape(error) << "\"}" << endl;
+            return 1;
+        }
+        Item it;
+        while (in.next(it.value) && in.next(it.weight)) items.push_back(it);
+        next = 3;
+    } else {
+        // Parse: "3;60,10;100,20;120,30"
+        stringstream ss(args[1]);
+        string token;
         getline(ss, token, ';');
-        stringstream itemSS(token);
-        string val;
-        
-        getline(itemSS, val, ',');
-        items[i].value = stoi(val);
-        
-        getline(itemSS, val, ',');
-        items[i].weight = stoi(val);
-        
-        items[i].ratio = (double)items[i].value / items[i].weight;
-        items[i].index = i;
-    }
-    
-    sort(items.begin(), items.end(), compare);
-    
-    double totalValue = 0.0;
-    int remainingCapacity = capacity;
-    
-    for (int i = 0; i < n; i++) {
-        if (remainingCapacity >= items[i].weight) {
-            totalValue += items[i].value;
-            remainingCapacity -= items[i].weight;
-        } else {
-            totalValue += items[i].value * ((double)remainingCapacity / items[i].weight);
-            break;
+        int n = stoi(token);
+        for (int i = 0; i < n; i++) {
+            getline(ss, token, ';');
+            stringstream itemSS(token);
+            string val;
+            Item it;
+            getline(itemSS, val, ',');
+            it.value = stoll(val);
+            getline(itemSS, val, ',');
+            it.weight = stoll(val);
+            items.push_back(it);
         }
+        next = 2;
+    }
+    string mode = args.size() > next ? args[next] : "sort";
+    if (args.size() > next + 1) threads = max(1, stoi(args[next + 1]));
+
+    bool valid = capacity >= 0 && (mode == "sort" || mode == "select" || mode == "parallel");
+    for (const Item& it : items) {
+        valid = valid && it.value >= 0 && it.value <= MAX_FIELD && it.weight >= 0 && it.weight <= MAX_FIELD;
     }
-    
+    if (!valid) {
+        cout << "{\"error\":\"Values, weights and capacity must be non-negative (values and weights below 2^31); "
+                "mode is sort, select or parallel\"}" << endl;
+        return 1;
+    }
+
+    vector<Step> trace;
+    auto start = chrono::steady_clock::now();
+    Fill fill = solve(items, capacity, mode, threads, withList ? &trace : nullptr);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
     // Output JSON
-    cout << "{\"algorithm\":\"Fractional Knapsack\",\"capacity\":" << capacity 
-         << ",\"items\":" << n << ",\"maxValue\":" << totalValue << "}" << endl;
-    
+    size_t n = items.size();
+    cout << setprecision(15) << "{\"algorithm\":\"Fractional Knapsack\",\"capacity\":" << capacity
+         << ",\"items\":" << n << ",\"maxValue\":" << fill.value() << ",\"mode\":\"" << mode << "\""
+         << ",\"usedWeight\":" << fill.usedWeight << ",\"wholeItems\":" << fill.whole.size();
+    if (fill.partial >= 0) cout << ",\"partialItem\":" << fill.partial << ",\"partialFraction\":" << fill.fraction;
+    if (withList) {
+        sort(fill.whole.begin(), fill.whole.end());
+        cout << ",\"taken\":[";
+        for (size_t i = 0; i < fill.whole.size(); i++) cout << (i > 0 ? "," : "") << fill.whole[i];
+        cout << "]";
+        if (mode == "sort") {
+            cout << ",\"trace\":[";
+            for (size_t k = 0; k < trace.size(); k++) {
+                const Item& it = items[trace[k].index];
+                cout << (k > 0 ? "," : "") << "{\"index\":" << trace[k].index << ",\"value\":" << it.value
+                     << ",\"weight\":" << it.weight << ",\"fraction\":" << trace[k].fraction
+                     << ",\"totalValue\":" << trace[k].totalValue << "}";
+            }
+            cout << "]";
+        }
+    }
+    cout << ",\"threads\":" << threads << ",\"seconds\":" << seconds << "}" << endl;
+
     return 0;
 }
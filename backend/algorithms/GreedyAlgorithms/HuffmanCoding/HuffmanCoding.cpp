@@ -1,76 +1,425 @@
 #include <iostream>
-#include <queue>
-#include <unordered_map>
+#include <vector>
 #include <string>
+#include <queue>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include "../../common/TextStream.h"
 using namespace std;
 
-struct Node {
-    char ch;
-    int freq;
-    Node *left, *right;
-    
-    Node(char c, int f) : ch(c), freq(f), left(nullptr), right(nullptr) {}
+// Canonical, length-limited Huffman codec. Codes are at most MAX_CODE_LEN bits
+// so one TABLE_BITS lookup always resolves a symbol; each table entry also
+// holds a second symbol when both codes fit in the peeked bits, so common
+// short codes decode two at a time. Bits are packed LSB-first through a 64-bit
+// buffer, which is why codes are stored bit-reversed.
+
+const int MAX_CODE_LEN = 12;
+const int TABLE_BITS = MAX_CODE_LEN;
+const size_t BLOCK_SIZE = 1 << 20;
+const size_t MAX_PAYLOAD = BLOCK_SIZE * MAX_CODE_LEN / 8;   // every symbol at the longest code
+const char STREAM_MAGIC[4] = {'A', 'V', 'H', 'F'};
+
+struct HuffmanCode {
+    uint8_t length[256];
+    uint16_t code[256];   // bit-reversed canonical code, ready for LSB-first output
 };
 
-struct Compare {
-    bool operator()(Node* a, Node* b) {
-        return a->freq > b->freq;
+struct DecodeEntry {
+    uint8_t symbol[2];
+    uint8_t firstLength;
+    uint8_t totalLength;
+    uint8_t count;
+};
+
+// Huffman code lengths from symbol frequencies, using index-based nodes
+void buildLengths(const uint64_t freq[256], uint8_t length[256]) {
+    memset(length, 0, 256);
+    vector<uint64_t> weight;
+    vector<int> parent;
+    typedef pair<uint64_t, int> Item;
+    priority_queue<Item, vector<Item>, greater<Item>> pq;
+    for (int s = 0; s < 256; s++) {
+        if (freq[s]) {
+            pq.push({freq[s], (int)weight.size()});
+            weight.push_back(freq[s]);
+            parent.push_back(-1);
+        }
+    }
+    int leaves = weight.size();
+    if (leaves == 0) return;
+    if (leaves == 1) {
+        for (int s = 0; s < 256; s++) if (freq[s]) length[s] = 1;
+        return;
+    }
+    while (pq.size() > 1) {
+        Item a = pq.top(); pq.pop();
+        Item b = pq.top(); pq.pop();
+        int node = weight.size();
+        weight.push_back(a.first + b.first);
+        parent.push_back(-1);
+        parent[a.second] = node;
+        parent[b.second] = node;
+        pq.push({a.first + b.first, node});
+    }
+    // Depth of each leaf = number of parent hops to the root
+    vector<int> depth(weight.size(), 0);
+    for (int node = weight.size() - 2; node >= 0; node--) depth[node] = depth[parent[node]] + 1;
+    for (int s = 0, leaf = 0; s < 256; s++) {
+        if (freq[s]) length[s] = min(depth[leaf++], 255);
+    }
+
+    // Limit lengths: clamp, then lengthen the longest codes below the limit
+    // until the Kraft sum fits again
+    int64_t kraft = 0;
+    const int64_t full = 1 << MAX_CODE_LEN;
+    for (int s = 0; s < 256; s++) {
+        if (length[s] > MAX_CODE_LEN) length[s] = MAX_CODE_LEN;
+        if (length[s]) kraft += full >> length[s];
+    }
+    while (kraft > full) {
+        int pick = -1;
+        for (int s = 0; s < 256; s++) {
+            if (length[s] && length[s] < MAX_CODE_LEN && (pick < 0 || length[s] > length[pick])) pick = s;
+        }
+        kraft -= full >> (length[pick] + 1);
+        length[pick]++;
+    }
+}
+
+uint16_t reverseBits(uint16_t code, int length) {
+    uint16_t r = 0;
+    for (int i = 0; i < length; i++) r = (r << 1) | ((code >> i) & 1);
+    return r;
+}
+
+// Canonical assignment: symbols ordered by (length, symbol) get consecutive codes
+void assignCodes(HuffmanCode& hc) {
+    int count[MAX_CODE_LEN + 1] = {0};
+    for (int s = 0; s < 256; s++) count[hc.length[s]]++;
+    count[0] = 0;
+    uint16_t next[MAX_CODE_LEN + 2] = {0};
+    uint16_t code = 0;
+    for (int len = 1; len <= MAX_CODE_LEN; len++) {
+        code = (code + count[len - 1]) << 1;
+        next[len] = code;
+    }
+    for (int s = 0; s < 256; s++) {
+        int len = hc.length[s];
+        hc.code[s] = len ? reverseBits(next[len]++, len) : 0;
+    }
+}
+
+vector<DecodeEntry> buildDecodeTable(const HuffmanCode& hc) {
+    vector<DecodeEntry> table(1 << TABLE_BITS);
+    for (auto& e : table) e = {{0, 0}, 0, 0, 0};
+    for (int s = 0; s < 256; s++) {
+        int len = hc.length[s];
+        if (!len) continue;
+        for (uint32_t fill = hc.code[s]; fill < table.size(); fill += 1u << len) {
+            table[fill] = {{(uint8_t)s, 0}, (uint8_t)len, (uint8_t)len, 1};
+        }
+    }
+    // Second symbol: decode the bits left over after the first code
+    vector<DecodeEntry> single(table);
+    for (uint32_t i = 0; i < table.size(); i++) {
+        DecodeEntry& e = table[i];
+        if (!e.count) continue;
+        const DecodeEntry& next = single[i >> e.firstLength];
+        if (next.count && e.firstLength + next.firstLength <= TABLE_BITS) {
+            e.symbol[1] = next.symbol[0];
+            e.totalLength = e.firstLength + next.firstLength;
+            e.count = 2;
+        }
+    }
+    return table;
+}
+
+// Encode one block into `out`: code lengths (nibble-packed), payload size, payload
+void encodeBlock(const unsigned char* data, size_t n, vector<unsigned char>& out) {
+    uint64_t freq[256] = {0};
+    for (size_t i = 0; i < n; i++) freq[data[i]]++;
+    HuffmanCode hc;
+    buildLengths(freq, hc.length);
+    assignCodes(hc);
+
+    auto put32 = [&](uint32_t v) { for (int k = 0; k < 4; k++) out.push_back(v >> (8 * k)); };
+    put32(n);
+    for (int s = 0; s < 256; s += 2) out.push_back(hc.length[s] | (hc.length[s + 1] << 4));
+    size_t sizeAt = out.size();
+    put32(0);
+    size_t payloadStart = out.size();
+
+    uint64_t buffer = 0;
+    int bits = 0;
+    for (size_t i = 0; i < n; i++) {
+        unsigned char c = data[i];
+        buffer |= (uint64_t)hc.code[c] << bits;
+        bits += hc.length[c];
+        if (bits >= 32) {
+            put32((uint32_t)buffer);
+            buffer >>= 32;
+            bits -= 32;
+        }
+    }
+    while (bits > 0) {
+        out.push_back(buffer & 0xFF);
+        buffer >>= 8;
+        bits -= 8;
+    }
+    uint32_t payload = out.size() - payloadStart;
+    for (int k = 0; k < 4; k++) out[sizeAt + k] = payload >> (8 * k);
+}
+
+// Decode one block's payload into `out`; returns false on corrupt input
+bool decodeBlock(const uint8_t lengths[256], const unsigned char* payload, size_t payloadSize,
+                 size_t rawLength, vector<unsigned char>& out) {
+    HuffmanCode hc;
+    memcpy(hc.length, lengths, 256);
+    assignCodes(hc);
+    vector<DecodeEntry> table = buildDecodeTable(hc);
+
+    size_t start = out.size();
+    out.resize(start + rawLength);
+    unsigned char* dst = out.data() + start;
+    size_t produced = 0, pos = 0;
+    uint64_t buffer = 0;
+    int bits = 0;
+    const uint32_t mask = (1u << TABLE_BITS) - 1;
+    while (produced < rawLength) {
+        while (bits <= 56) {
+            if (pos < payloadSize) buffer |= (uint64_t)payload[pos] << bits;
+            pos++;
+            bits += 8;
+        }
+        const DecodeEntry& e = table[buffer & mask];
+        if (!e.count) return false;
+        dst[produced++] = e.symbol[0];
+        if (e.count == 2 && produced < rawLength) {
+            dst[produced++] = e.symbol[1];
+            buffer >>= e.totalLength;
+            bits -= e.totalLength;
+        } else {
+            buffer >>= e.firstLength;
+            bits -= e.firstLength;
+        }
     }
+    return true;
+}
+
+struct CodecReport {
+    size_t inputBytes = 0;
+    size_t outputBytes = 0;
+    double seconds = 0;
 };
 
-void generateCodes(Node* root, string code, unordered_map<char, string>& codes) {
-    if (!root) return;
-    
-    if (!root->left && !root->right) {
-        codes[root->ch] = code;
+bool encodeStream(FILE* in, FILE* out, CodecReport& report) {
+    auto start = chrono::steady_clock::now();
+    vector<unsigned char> block(BLOCK_SIZE), encoded;
+    fwrite(STREAM_MAGIC, 1, 4, out);
+    report.outputBytes = 4;
+    size_t got;
+    while ((got = fread(block.data(), 1, BLOCK_SIZE, in)) > 0) {
+        encoded.clear();
+        encodeBlock(block.data(), got, encoded);
+        fwrite(encoded.data(), 1, encoded.size(), out);
+        report.inputBytes += got;
+        report.outputBytes += encoded.size();
     }
-    
-    generateCodes(root->left, code + "0", codes);
-    generateCodes(root->right, code + "1", codes);
+    const unsigned char end[4] = {0, 0, 0, 0};
+    fwrite(end, 1, 4, out);
+    report.outputBytes += 4;
+    report.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return !ferror(out);
+}
+
+bool decodeStream(FILE* in, FILE* out, CodecReport& report, string& error) {
+    auto start = chrono::steady_clock::now();
+    char magic[4];
+    if (fread(magic, 1, 4, in) != 4 || memcmp(magic, STREAM_MAGIC, 4) != 0) {
+        error = "Not a Huffman stream";
+        return false;
+    }
+    report.inputBytes = 4;
+    vector<unsigned char> payload, decoded;
+    auto get32 = [&](uint32_t& v) {
+        unsigned char b[4];
+        if (fread(b, 1, 4, in) != 4) return false;
+        v = b[0] | (b[1] << 8) | (b[2] << 16) | ((uint32_t)b[3] << 24);
+        report.inputBytes += 4;
+        return true;
+    };
+    while (true) {
+        uint32_t rawLength, payloadSize;
+        if (!get32(rawLength)) {
+            error = "Truncated stream";
+            return false;
+        }
+        if (rawLength == 0) break;
+        unsigned char packed[128];
+        uint8_t lengths[256];
+        if (fread(packed, 1, 128, in) != 128 || !get32(payloadSize)) {
+            error = "Truncated block header";
+            return false;
+        }
+        // Lengths index fixed-size tables and sizes drive allocations, so a
+        // header the encoder could not have written is rejected up front
+        uint64_t kraft = 0;
+        bool valid = rawLength <= BLOCK_SIZE && payloadSize <= MAX_PAYLOAD;
+        for (int s = 0; s < 256; s += 2) {
+            lengths[s] = packed[s / 2] & 0xF;
+            lengths[s + 1] = packed[s / 2] >> 4;
+        }
+        for (int s = 0; s < 256 && valid; s++) {
+            valid = lengths[s] <= MAX_CODE_LEN;
+            if (valid && lengths[s]) kraft += 1u << (MAX_CODE_LEN - lengths[s]);
+        }
+        if (!valid || kraft > (1u << MAX_CODE_LEN)) {
+            error = "Corrupt block header";
+            return false;
+        }
+        payload.resize(payloadSize);
+        if (fread(payload.data(), 1, payloadSize, in) != payloadSize) {
+            error = "Truncated block payload";
+            return false;
+        }
+        report.inputBytes += 128 + payloadSize;
+        decoded.clear();
+        if (!decodeBlock(lengths, payload.data(), payloadSize, rawLength, decoded)) {
+            error = "Corrupt block payload";
+            return false;
+        }
+        fwrite(decoded.data(), 1, decoded.size(), out);
+        report.outputBytes += decoded.size();
+    }
+    report.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return !ferror(out);
+}
+
+void printReport(FILE* to, const string& mode, const CodecReport& r) {
+    double mb = (mode == "encode" ? r.inputBytes : r.outputBytes) / 1e6;
+    fprintf(to, "{\"algorithm\":\"Huffman Coding\",\"mode\":\"%s\",\"inputBytes\":%zu,\"outputBytes\":%zu,"
+                "\"seconds\":%g,\"mbPerSec\":%g}\n",
+            mode.c_str(), r.inputBytes, r.outputBytes, r.seconds, r.seconds > 0 ? mb / r.seconds : 0.0);
+}
+
+int runCodec(const string& mode, const string& inPath, const string& outPath) {
+    FILE* in = inPath == "-" ? stdin : fopen(inPath.c_str(), "rb");
+    FILE* out = outPath == "-" ? stdout : fopen(outPath.c_str(), "wb");
+    // The report goes to stderr when stdout carries the data
+    FILE* reportTo = outPath == "-" ? stderr : stdout;
+    if (!in || !out) {
+        fprintf(reportTo, "{\"error\":\"Cannot open %s\"}\n", jsonEscape(!in ? inPath : outPath).c_str());
+        return 1;
+    }
+    CodecReport report;
+    string error;
+    bool ok = mode == "encode" ? encodeStream(in, out, report) : decodeStream(in, out, report, error);
+    if (in != stdin) fclose(in);
+    if (out != stdout) ok = fclose(out) == 0 && ok;
+    else fflush(stdout);
+    if (!ok) {
+        fprintf(reportTo, "{\"error\":\"%s\"}\n", error.empty() ? "Write failed" : error.c_str());
+        return 1;
+    }
+    printReport(reportTo, mode, report);
+    return 0;
+}
+
+// In-memory encode/decode throughput on Zipf-distributed bytes
+int runBenchmark(size_t megabytes) {
+    size_t n = megabytes << 20;
+    vector<unsigned char> data(n);
+    vector<double> weights(64);
+    for (int k = 0; k < 64; k++) weights[k] = 1.0 / (k + 1);
+    discrete_distribution<int> zipf(weights.begin(), weights.end());
+    mt19937 rng(5);
+    for (auto& c : data) c = 32 + zipf(rng);
+
+    vector<unsigned char> encoded, decoded;
+    auto t0 = chrono::steady_clock::now();
+    for (size_t off = 0; off < n; off += BLOCK_SIZE) {
+        encodeBlock(data.data() + off, min(BLOCK_SIZE, n - off), encoded);
+    }
+    auto t1 = chrono::steady_clock::now();
+    bool decodedAll = true;
+    for (size_t pos = 0; pos < encoded.size(); ) {
+        uint32_t rawLength, payloadSize;
+        memcpy(&rawLength, &encoded[pos], 4);
+        uint8_t lengths[256];
+        for (int s = 0; s < 256; s += 2) {
+            lengths[s] = encoded[pos + 4 + s / 2] & 0xF;
+            lengths[s + 1] = encoded[pos + 4 + s / 2] >> 4;
+        }
+        memcpy(&payloadSize, &encoded[pos + 132], 4);
+        decodedAll = decodeBlock(lengths, &encoded[pos + 136], payloadSize, rawLength, decoded) && decodedAll;
+        pos += 136 + payloadSize;
+    }
+    auto t2 = chrono::steady_clock::now();
+    double encodeSec = chrono::duration<double>(t1 - t0).count();
+    double decodeSec = chrono::duration<double>(t2 - t1).count();
+
+    cout << "{\"algorithm\":\"Huffman Coding\",\"mode\":\"benchmark\",\"bytes\":" << n
+         << ",\"encodedBytes\":" << encoded.size()
+         << ",\"compressionRatio\":" << (double)encoded.size() / n
+         << ",\"encodeMbPerSec\":" << n / 1e6 / encodeSec
+         << ",\"decodeMbPerSec\":" << n / 1e6 / decodeSec
+         << ",\"roundTrip\":" << (decodedAll && decoded == data ? "true" : "false") << "}" << endl;
+    return 0;
 }
 
 int main(int argc, char* argv[]) {
+    if (argc >= 4 && (string(argv[1]) == "encode" || string(argv[1]) == "decode")) {
+        return runCodec(argv[1], argv[2], argv[3]);
+    }
+    if (argc >= 2 && string(argv[1]) == "bench") {
+        return runBenchmark(argc >= 3 ? stoull(argv[2]) : 64);
+    }
     if (argc < 2) {
-        cout << "{\"error\":\"Usage: ./HuffmanCoding <text>\"}" << endl;
+        cout << "{\"error\":\"Usage: ./HuffmanCoding <text> | ./HuffmanCoding encode|decode <in|-> <out|-> | ./HuffmanCoding bench [megabytes]\"}" << endl;
         return 1;
     }
-    
+
     string text = argv[1];
-    
-    unordered_map<char, int> freq;
-    for (char ch : text) {
+
+    uint64_t freq[256] = {0};
+    for (unsigned char ch : text) {
         freq[ch]++;
     }
-    
-    priority_queue<Node*, vector<Node*>, Compare> pq;
-    for (auto& p : freq) {
-        pq.push(new Node(p.first, p.second));
-    }
-    
-    while (pq.size() > 1) {
-        Node* left = pq.top(); pq.pop();
-        Node* right = pq.top(); pq.pop();
-        
-        Node* parent = new Node('\0', left->freq + right->freq);
-        parent->left = left;
-        parent->right = right;
-        pq.push(parent);
-    }
-    
-    Node* root = pq.top();
-    unordered_map<char, string> codes;
-    generateCodes(root, "", codes);
-    
+
+    HuffmanCode hc;
+    buildLengths(freq, hc.length);
+    assignCodes(hc);
+
     int originalBits = text.length() * 8;
     int compressedBits = 0;
-    for (char ch : text) {
-        compressedBits += codes[ch].length();
+    for (unsigned char ch : text) {
+        compressedBits += hc.length[ch];
     }
-    
+
     // Output JSON
-    cout << "{\"algorithm\":\"Huffman Coding\",\"originalSize\":" << originalBits 
-         << ",\"compressedSize\":" << compressedBits 
-         << ",\"compressionRatio\":" << (double)compressedBits / originalBits << "}" << endl;
-    
+    cout << "{\"algorithm\":\"Huffman Coding\",\"originalSize\":" << originalBits
+         << ",\"compressedSize\":" << compressedBits
+         << ",\"compressionRatio\":" << (originalBits ? (double)compressedBits / originalBits : 0.0)
+         << ",\"codes\":{";
+    bool first = true;
+    for (int s = 0; s < 256; s++) {
+        if (!hc.length[s]) continue;
+        if (!first) cout << ",";
+        first = false;
+        string key;
+        if (s == '"' || s == '\\') key = string("\\") + (char)s;
+        else if (s < 0x20) { char buf[8]; snprintf(buf, sizeof(buf), "\\u%04x", s); key = buf; }
+        else key = string(1, (char)s);
+        // Print the canonical code MSB-first, as it would be read
+        cout << "\"" << key << "\":\"";
+        for (int b = 0; b < hc.length[s]; b++) cout << ((hc.code[s] >> b) & 1);
+        cout << "\"";
+    }
+    cout << "}}" << endl;
+
     return 0;
 }
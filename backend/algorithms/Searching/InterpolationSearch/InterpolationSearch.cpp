@@ -0,0 +1,84 @@
+#include <iostream>
+#include <vector>
+#include <sstream>
+#include <cmath>
+using namespace std;
+
+// Interpolation search guesses the probe position from the key value instead
+// of always halving, which needs O(log log n) probes on uniform keys. On skewed
+// data the guess can be poor, so after maxInterpolations probes we fall back
+// to bisection and keep the O(log n) worst case of Binary Search.
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        cout << "{\"error\":\"Usage: interpolation_search_steps <array> <target>\"}";
+        return 1;
+    }
+
+    string arrayStr = argv[1];
+    vector<long long> arr;
+    stringstream ss(arrayStr);
+    string num;
+
+    while (getline(ss, num, ',')) {
+        arr.push_back(stoll(num));
+    }
+
+    long long target = stoll(argv[2]);
+    int n = arr.size();
+    int left = 0, right = n - 1;
+    int stepNum = 1;
+    int maxInterpolations = 2 * (int)ceil(log2(max(n, 2)));
+    int interpolations = 0;
+    bool found = false;
+    int foundIndex = -1;
+    vector<string> steps;
+
+    while (left <= right && target >= arr[left] && target <= arr[right]) {
+        int mid;
+        string phase;
+        if (arr[right] == arr[left]) {
+            mid = left;
+            phase = "interpolate";
+        } else if (interpolations < maxInterpolations) {
+            long double fraction = (long double)(target - arr[left]) / (long double)(arr[right] - arr[left]);
+            mid = left + (int)(fraction * (right - left));
+            phase = "interpolate";
+            interpolations++;
+        } else {
+            mid = left + (right - left) / 2;
+            phase = "bisect";
+        }
+
+        string step = "{\"stepNumber\":" + to_string(stepNum++) +
+                      ",\"phase\":\"" + phase + "\"" +
+                      ",\"left\":" + to_string(left) +
+                      ",\"right\":" + to_string(right) +
+                      ",\"mid\":" + to_string(mid) +
+                      ",\"comparison\":\"arr[" + to_string(mid) + "] = " + to_string(arr[mid]);
+
+        if (arr[mid] == target) {
+            step += " == " + to_string(target) + " ✓\",\"status\":\"found\"}";
+            steps.push_back(step);
+            found = true;
+            foundIndex = mid;
+            break;
+        } else if (arr[mid] < target) {
+            step += " < " + to_string(target) + " → Search right part\",\"status\":\"continue\"}";
+            left = mid + 1;
+        } else {
+            step += " > " + to_string(target) + " → Search left part\",\"status\":\"continue\"}";
+            right = mid - 1;
+        }
+        steps.push_back(step);
+    }
+
+    cout << "{\"algorithm\":\"Interpolation Search\",\"found\":" << (found ? "true" : "false")
+         << ",\"foundIndex\":" << foundIndex
+         << ",\"totalComparisons\":" << steps.size() << ",\"steps\":[";
+    for (size_t i = 0; i < steps.size(); i++) {
+        if (i > 0) cout << ",";
+        cout << steps[i];
+    }
+    cout << "]}";
+    return 0;
+}
@@ -1,115 +1,139 @@
 #include <iostream>
 #include <vector>
 #include <sstream>
+#include <string>
 #include <cmath>
 using namespace std;
 
+// Elements of one 64-byte cache line; "cache" block sizes are rounded to this
+const int CACHE_LINE_INTS = 64 / sizeof(int);
+
+// Block summary built once per array and reused by every query on it: the
+// jump phase scans the compact blockMax array instead of striding through arr.
+struct JumpIndex {
+    int blockSize;
+    vector<int> blockMax; // blockMax[b] = arr[min((b+1)*blockSize, n) - 1]
+
+    JumpIndex(const vector<int>& arr, int blockSize) : blockSize(blockSize) {
+        int n = arr.size();
+        for (int end = blockSize; end - blockSize < n; end += blockSize) {
+            blockMax.push_back(arr[min(end, n) - 1]);
+        }
+    }
+};
+
+int chooseBlockSize(const string& option, int n) {
+    int root = max(1, (int)sqrt(n));
+    if (option.empty()) return root;
+    if (option == "cache") {
+        // Keep whole cache lines per block, as close to sqrt(n) as possible
+        return max(CACHE_LINE_INTS, (root / CACHE_LINE_INTS) * CACHE_LINE_INTS);
+    }
+    return max(1, stoi(option));
+}
+
+// One traced pass: steps are emitted while searching and the comparison count
+// falls out of the same walk.
+int search(const vector<int>& arr, const JumpIndex& index, int target, string& steps, int& comparisons) {
+    int n = arr.size();
+    int blocks = index.blockMax.size();
+    int stepNum = 1;
+    int b = 0;
+    comparisons = 0;
+
+    auto addStep = [&](const string& phase, int blockStart, int blockEnd, int checkIndex,
+                       const string& comparison, const string& status) {
+        if (!steps.empty()) steps += ",";
+        steps += "{\"stepNumber\":" + to_string(stepNum++) +
+                 ",\"phase\":\"" + phase + "\"" +
+                 ",\"blockStart\":" + to_string(blockStart) +
+                 ",\"blockEnd\":" + to_string(blockEnd) +
+                 ",\"checkIndex\":" + to_string(checkIndex) +
+                 ",\"comparison\":\"" + comparison + "\"" +
+                 ",\"status\":\"" + status + "\"}";
+    };
+
+    // Jump phase
+    while (b < blocks && index.blockMax[b] < target) {
+        comparisons++;
+        int blockStart = b * index.blockSize;
+        int blockEnd = min(blockStart + index.blockSize, n) - 1;
+        addStep("jump", blockStart, blockEnd, blockEnd,
+                "arr[" + to_string(blockEnd) + "] = " + to_string(index.blockMax[b]) + " < " +
+                    to_string(target) + " → Jump to next block",
+                "continue");
+        b++;
+    }
+    if (b == blocks) return -1;
+
+    // Linear search phase
+    int blockStart = b * index.blockSize;
+    int blockEnd = min(blockStart + index.blockSize, n) - 1;
+    for (int i = blockStart; i <= blockEnd; i++) {
+        comparisons++;
+        string comparison = "arr[" + to_string(i) + "] = " + to_string(arr[i]);
+        if (arr[i] == target) {
+            addStep("linear", blockStart, blockEnd, i, comparison + " == " + to_string(target) + " ✓", "found");
+            return i;
+        }
+        if (arr[i] > target) {
+            addStep("linear", blockStart, blockEnd, i, comparison + " > " + to_string(target) + " → Target not present", "notfound");
+            return -1;
+        }
+        addStep("linear", blockStart, blockEnd, i, comparison + " != " + to_string(target) + " → Continue linear search", "continue");
+    }
+    return -1;
+}
+
 int main(int argc, char* argv[]) {
     if (argc < 3) {
-        cout << "{\"error\":\"Usage: jump_search_steps <array> <target>\"}";
+        cout << "{\"error\":\"Usage: jump_search_steps <array> <target[,target...]> [blockSize|cache]\"}";
         return 1;
     }
-    
+
     string arrayStr = argv[1];
     vector<int> arr;
     stringstream ss(arrayStr);
     string num;
-    
+
     while (getline(ss, num, ',')) {
         arr.push_back(stoi(num));
     }
-    
-    int target = stoi(argv[2]);
-    int n = arr.size();
-    int step = sqrt(n);
-    int prev = 0;
-    int stepNum = 1;
-    bool found = false;
-    int foundIndex = -1;
-    
-    cout << "{\"algorithm\":\"Jump Search\",\"found\":";
-    
-    // First pass to determine if found
-    int tempPrev = 0;
-    while (arr[min(step, n) - 1] < target) {
-        tempPrev = step;
-        step += sqrt(n);
-        if (tempPrev >= n) break;
-    }
-    
-    for (int i = tempPrev; i < min(step, n); i++) {
-        if (arr[i] == target) {
-            found = true;
-            foundIndex = i;
-            break;
-        }
-    }
-    
-    cout << (found ? "true" : "false") << ",\"totalComparisons\":";
-    
-    // Count steps
-    int stepCount = 0;
-    step = sqrt(n);
-    prev = 0;
-    while (arr[min(step, n) - 1] < target) {
-        stepCount++;
-        prev = step;
-        step += sqrt(n);
-        if (prev >= n) break;
-    }
-    for (int i = prev; i < min(step, n); i++) {
-        stepCount++;
-        if (arr[i] == target) break;
+
+    vector<int> targets;
+    stringstream ts(argv[2]);
+    while (getline(ts, num, ',')) {
+        targets.push_back(stoi(num));
     }
-    
-    cout << stepCount << ",\"blockSize\":" << (int)sqrt(n) << ",\"steps\":[";
-    
-    // Generate steps
-    step = sqrt(n);
-    prev = 0;
-    stepNum = 1;
-    bool firstStep = true;
-    
-    // Jump phase
-    while (arr[min(step, n) - 1] < target) {
-        if (!firstStep) cout << ",";
-        firstStep = false;
-        
-        cout << "{\"stepNumber\":" << stepNum++
-             << ",\"phase\":\"jump\""
-             << ",\"blockStart\":" << prev
-             << ",\"blockEnd\":" << (min(step, n) - 1)
-             << ",\"checkIndex\":" << (min(step, n) - 1)
-             << ",\"comparison\":\"arr[" << (min(step, n) - 1) << "] = " << arr[min(step, n) - 1] << " < " << target << " → Jump to next block\""
-             << ",\"status\":\"continue\"}";
-        
-        prev = step;
-        step += sqrt(n);
-        if (prev >= n) break;
+
+    JumpIndex index(arr, chooseBlockSize(argc >= 4 ? argv[3] : "", arr.size()));
+
+    if (targets.size() == 1) {
+        string steps;
+        int comparisons;
+        int foundIndex = search(arr, index, targets[0], steps, comparisons);
+        cout << "{\"algorithm\":\"Jump Search\",\"found\":" << (foundIndex >= 0 ? "true" : "false")
+             << ",\"foundIndex\":" << foundIndex
+             << ",\"totalComparisons\":" << comparisons
+             << ",\"blockSize\":" << index.blockSize
+             << ",\"steps\":[" << steps << "]}";
+        return 0;
     }
-    
-    // Linear search phase
-    for (int i = prev; i < min(step, n); i++) {
-        if (!firstStep) cout << ",";
-        firstStep = false;
-        
-        cout << "{\"stepNumber\":" << stepNum++
-             << ",\"phase\":\"linear\""
-             << ",\"blockStart\":" << prev
-             << ",\"blockEnd\":" << (min(step, n) - 1)
-             << ",\"checkIndex\":" << i
-             << ",\"comparison\":\"arr[" << i << "] = " << arr[i];
-        
-        if (arr[i] == target) {
-            cout << " == " << target << " ✓\"";
-            cout << ",\"status\":\"found\"}";
-            break;
-        } else {
-            cout << " != " << target << " → Continue linear search\"";
-            cout << ",\"status\":\"continue\"}";
-        }
+
+    // Several targets share one block summary
+    cout << "{\"algorithm\":\"Jump Search\",\"blockSize\":" << index.blockSize
+         << ",\"blocks\":" << index.blockMax.size() << ",\"queries\":[";
+    for (size_t t = 0; t < targets.size(); t++) {
+        string steps;
+        int comparisons;
+        int foundIndex = search(arr, index, targets[t], steps, comparisons);
+        if (t > 0) cout << ",";
+        cout << "{\"target\":" << targets[t]
+             << ",\"found\":" << (foundIndex >= 0 ? "true" : "false")
+             << ",\"foundIndex\":" << foundIndex
+             << ",\"totalComparisons\":" << comparisons
+             << ",\"steps\":[" << steps << "]}";
     }
-    
     cout << "]}";
     return 0;
-}
\ No newline at end of file
+}
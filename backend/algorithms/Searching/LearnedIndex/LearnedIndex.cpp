@@ -0,0 +1,331 @@
+#include <iostream>
+#include <vector>
+#include <sstream>
+#include <string>
+#include <cmath>
+#include <random>
+#include <chrono>
+#include <algorithm>
+using namespace std;
+
+// Piecewise-linear learned index (PGM style). Every segment maps a key to a
+// predicted position that is at most `epsilon` away from the key's real
+// lower_bound index, so a lookup only needs a binary search over a window of
+// 2*epsilon+2 elements. Segment start keys are indexed the same way, level by
+// level, until a single segment remains.
+
+struct Segment {
+    long long key;
+    double slope;
+    double intercept;
+};
+
+struct LookupStats {
+    int probes = 0;
+    int predicted = 0;
+};
+
+class LearnedIndex {
+    int epsilon;
+    vector<vector<Segment>> levels; // levels[0] indexes the data, back() is the root
+
+    // Shrinking-cone segmentation: extend the current segment while some line
+    // through its first point keeps every key within epsilon of its position.
+    static vector<Segment> buildSegments(const vector<long long>& keys, int epsilon) {
+        vector<Segment> segments;
+        size_t n = keys.size();
+        size_t start = 0;
+        while (start < n) {
+            long long x0 = keys[start];
+            double y0 = start;
+            double lo = 0, hi = INFINITY;
+            size_t i = start + 1;
+            for (; i < n; i++) {
+                if (keys[i] == keys[i - 1]) continue;
+                double dx = (double)(keys[i] - x0);
+                double dy = (double)i - y0;
+                double slope = dy / dx;
+                if (slope < lo || slope > hi) break;
+                lo = max(lo, (dy - epsilon) / dx);
+                hi = min(hi, (dy + epsilon) / dx);
+            }
+            double slope = isinf(hi) ? 0 : (lo + hi) / 2;
+            segments.push_back({x0, slope, y0});
+            start = i;
+        }
+        return segments;
+    }
+
+    static int predict(const Segment& s, long long key, int lo, int hi) {
+        double pos = s.intercept + s.slope * (double)(key - s.key);
+        if (pos < lo) return lo;
+        if (pos > hi) return hi;
+        return (int)pos;
+    }
+
+    // Lower bound of `key` in keys[], starting from a prediction that is
+    // expected to be within epsilon. If the window does not bracket the answer
+    // (keys not present in the data can land just outside it) we widen it
+    // exponentially, so results stay exact whatever the model says.
+    static int lastMile(const vector<long long>& keys, long long key, int pos, int epsilon, LookupStats& stats) {
+        int n = keys.size();
+        int lo = max(0, pos - epsilon - 1);
+        int hi = min(n, pos + epsilon + 2);
+        for (int width = epsilon + 2; lo > 0 && keys[lo - 1] >= key; width *= 2) {
+            stats.probes++;
+            hi = lo;
+            lo = max(0, lo - width);
+        }
+        for (int width = epsilon + 2; hi < n && keys[hi] < key; width *= 2) {
+            stats.probes++;
+            lo = hi;
+            hi = min(n, hi + width);
+        }
+        while (lo < hi) {
+            int mid = lo + (hi - lo) / 2;
+            stats.probes++;
+            if (keys[mid] < key) lo = mid + 1;
+            else hi = mid;
+        }
+        return lo;
+    }
+
+public:
+    LearnedIndex(const vector<long long>& keys, int epsilon) : epsilon(epsilon) {
+        levels.push_back(buildSegments(keys, epsilon));
+        while (levels.back().size() > 1) {
+            vector<long long> starts;
+            for (const Segment& s : levels.back()) starts.push_back(s.key);
+            levels.push_back(buildSegments(starts, epsilon));
+        }
+    }
+
+    int lowerBound(const vector<long long>& keys, long long key, LookupStats& stats) const {
+        if (keys.empty()) return 0;
+        int seg = 0;
+        for (int level = levels.size() - 1; level > 0; level--) {
+            const vector<Segment>& below = levels[level - 1];
+            int last = below.size() - 1;
+            int pos = predict(levels[level][seg], key, 0, last);
+            // Find the last segment whose start key is <= key
+            int lo = max(0, pos - epsilon - 1), hi = min(last + 1, pos + epsilon + 2);
+            while (lo > 0 && below[lo - 1].key > key) { stats.probes++; hi = lo; lo = max(0, lo - 2 * epsilon - 2); }
+            while (hi <= last && below[hi].key <= key) { stats.probes++; lo = hi; hi = min(last + 1, hi + 2 * epsilon + 2); }
+            while (lo < hi) {
+                int mid = lo + (hi - lo) / 2;
+                stats.probes++;
+                if (below[mid].key <= key) lo = mid + 1;
+                else hi = mid;
+            }
+            seg = max(0, lo - 1);
+        }
+        int pos = predict(levels[0][seg], key, 0, keys.size() - 1);
+        stats.predicted = pos;
+        return lastMile(keys, key, pos, epsilon, stats);
+    }
+
+    int segmentCount() const { return levels[0].size(); }
+    int levelCount() const { return levels.size(); }
+    size_t bytes() const {
+        size_t total = 0;
+        for (const auto& level : levels) total += level.size() * sizeof(Segment);
+        return total;
+    }
+};
+
+int binaryLowerBound(const vector<long long>& arr, long long target, int& probes) {
+    int left = 0, right = arr.size();
+    while (left < right) {
+        int mid = left + (right - left) / 2;
+        probes++;
+        if (arr[mid] < target) left = mid + 1;
+        else right = mid;
+    }
+    return left;
+}
+
+// Same guarded interpolation search as InterpolationSearch.cpp, returning the
+// lower_bound position so all three methods can be checked against each other.
+int interpolationLowerBound(const vector<long long>& arr, long long target, int& probes) {
+    int left = 0, right = arr.size();
+    int maxInterpolations = 2 * (int)ceil(log2(max((int)arr.size(), 2)));
+    int interpolations = 0;
+    while (left < right) {
+        int mid;
+        if (interpolations < maxInterpolations && arr[right - 1] > arr[left] &&
+            target > arr[left] && target <= arr[right - 1]) {
+            long double fraction = (long double)(target - arr[left]) / (long double)(arr[right - 1] - arr[left]);
+            mid = left + (int)(fraction * (right - 1 - left));
+            interpolations++;
+        } else if (target <= arr[left]) {
+            probes++;
+            return left;
+        } else if (target > arr[right - 1]) {
+            probes++;
+            return right;
+        } else {
+            mid = left + (right - left) / 2;
+        }
+        probes++;
+        if (arr[mid] < target) left = mid + 1;
+        else right = mid;
+    }
+    return left;
+}
+
+vector<long long> parseList(const string& s) {
+    vector<long long> values;
+    stringstream ss(s);
+    string num;
+    while (getline(ss, num, ',')) {
+        if (!num.empty()) values.push_back(stoll(num));
+    }
+    return values;
+}
+
+vector<long long> generateKeys(const string& distribution, int n, mt19937_64& rng) {
+    vector<long long> keys(n);
+    if (distribution == "uniform") {
+        uniform_int_distribution<long long> dist(0, 1LL << 40);
+        for (auto& k : keys) k = dist(rng);
+    } else if (distribution == "lognormal") {
+        lognormal_distribution<double> dist(0.0, 2.0);
+        for (auto& k : keys) k = (long long)(dist(rng) * 1e6);
+    } else {
+        // Clustered: a few hundred dense clusters separated by large gaps
+        uniform_int_distribution<long long> centre(0, 1LL << 40);
+        normal_distribution<double> spread(0.0, 1e4);
+        vector<long long> centres(256);
+        for (auto& c : centres) c = centre(rng);
+        uniform_int_distribution<int> pick(0, centres.size() - 1);
+        for (auto& k : keys) k = max(0LL, centres[pick(rng)] + (long long)spread(rng));
+    }
+    sort(keys.begin(), keys.end());
+    return keys;
+}
+
+void runBenchmark(int n, int epsilon) {
+    const int queries = 1000000;
+    mt19937_64 rng(42);
+    const char* distributions[] = {"uniform", "lognormal", "clustered"};
+
+    cout << "{\"algorithm\":\"Learned Index Benchmark\",\"n\":" << n << ",\"epsilon\":" << epsilon
+         << ",\"queries\":" << queries << ",\"results\":[";
+    for (int d = 0; d < 3; d++) {
+        vector<long long> keys = generateKeys(distributions[d], n, rng);
+        vector<long long> lookups(queries);
+        uniform_int_distribution<int> pick(0, n - 1);
+        for (int i = 0; i < queries; i++) {
+            // Half present keys, half keys that fall between present ones
+            lookups[i] = keys[pick(rng)] + (i & 1);
+        }
+
+        auto t0 = chrono::high_resolution_clock::now();
+        LearnedIndex index(keys, epsilon);
+        auto t1 = chrono::high_resolution_clock::now();
+        double buildMs = chrono::duration<double, milli>(t1 - t0).count();
+
+        long long checksum[3] = {0, 0, 0};
+        long long probes[3] = {0, 0, 0};
+        double ns[3];
+
+        t0 = chrono::high_resolution_clock::now();
+        for (long long key : lookups) {
+            int p = 0;
+            checksum[0] += binaryLowerBound(keys, key, p);
+            probes[0] += p;
+        }
+        t1 = chrono::high_resolution_clock::now();
+        ns[0] = chrono::duration<double, nano>(t1 - t0).count() / queries;
+
+        t0 = chrono::high_resolution_clock::now();
+        for (long long key : lookups) {
+            int p = 0;
+            checksum[1] += interpolationLowerBound(keys, key, p);
+            probes[1] += p;
+        }
+        t1 = chrono::high_resolution_clock::now();
+        ns[1] = chrono::duration<double, nano>(t1 - t0).count() / queries;
+
+        t0 = chrono::high_resolution_clock::now();
+        for (long long key : lookups) {
+            LookupStats stats;
+            checksum[2] += index.lowerBound(keys, key, stats);
+            probes[2] += stats.probes;
+        }
+        t1 = chrono::high_resolution_clock::now();
+        ns[2] = chrono::duration<double, nano>(t1 - t0).count() / queries;
+
+        const char* names[] = {"binary", "interpolation", "learned"};
+        if (d > 0) cout << ",";
+        cout << "{\"distribution\":\"" << distributions[d] << "\",\"segments\":" << index.segmentCount()
+             << ",\"levels\":" << index.levelCount() << ",\"indexBytes\":" << index.bytes()
+             << ",\"buildMs\":" << buildMs
+             << ",\"consistent\":" << (checksum[0] == checksum[1] && checksum[0] == checksum[2] ? "true" : "false")
+             << ",\"methods\":[";
+        for (int m = 0; m < 3; m++) {
+            if (m > 0) cout << ",";
+            cout << "{\"method\":\"" << names[m] << "\",\"nsPerLookup\":" << ns[m]
+                 << ",\"probesPerLookup\":" << (double)probes[m] / queries << "}";
+        }
+        cout << "]}";
+    }
+    cout << "]}";
+}
+
+int main(int argc, char* argv[]) {
+    if (argc >= 2 && string(argv[1]) == "bench") {
+        int n = argc >= 3 ? stoi(argv[2]) : 10000000;
+        int epsilon = argc >= 4 ? stoi(argv[3]) : 32;
+        runBenchmark(n, epsilon);
+        return 0;
+    }
+    if (argc < 3) {
+        cout << "{\"error\":\"Usage: learned_index <sorted array> <target[,target...]> [epsilon] | learned_index bench [n] [epsilon]\"}";
+        return 1;
+    }
+
+    vector<long long> arr = parseList(argv[1]);
+    vector<long long> targets = parseList(argv[2]);
+    int epsilon = argc >= 4 ? stoi(argv[3]) : 4;
+    if (epsilon < 1) epsilon = 1;
+
+    LearnedIndex index(arr, epsilon);
+
+    // Model error over the stored keys: distance between the prediction and the
+    // first occurrence of each key
+    long long errorSum = 0;
+    int maxError = 0, distinct = 0;
+    for (size_t i = 0; i < arr.size(); i++) {
+        if (i > 0 && arr[i] == arr[i - 1]) continue;
+        LookupStats stats;
+        index.lowerBound(arr, arr[i], stats);
+        int error = abs(stats.predicted - (int)i);
+        errorSum += error;
+        maxError = max(maxError, error);
+        distinct++;
+    }
+
+    cout << "{\"algorithm\":\"Learned Index\",\"epsilon\":" << epsilon
+         << ",\"segments\":" << index.segmentCount()
+         << ",\"levels\":" << index.levelCount()
+         << ",\"maxModelError\":" << maxError
+         << ",\"avgModelError\":" << (distinct ? (double)errorSum / distinct : 0.0)
+         << ",\"lookups\":[";
+    long long totalProbes = 0;
+    for (size_t t = 0; t < targets.size(); t++) {
+        LookupStats stats;
+        int pos = index.lowerBound(arr, targets[t], stats);
+        bool found = pos < (int)arr.size() && arr[pos] == targets[t];
+        totalProbes += stats.probes;
+        if (t > 0) cout << ",";
+        cout << "{\"target\":" << targets[t]
+             << ",\"found\":" << (found ? "true" : "false")
+             << ",\"index\":" << (found ? pos : -1)
+             << ",\"predicted\":" << stats.predicted
+             << ",\"error\":" << abs(stats.predicted - pos)
+             << ",\"probes\":" << stats.probes << "}";
+    }
+    cout << "],\"avgProbesPerLookup\":" << (targets.empty() ? 0.0 : (double)totalProbes / targets.size()) << "}";
+    return 0;
+}
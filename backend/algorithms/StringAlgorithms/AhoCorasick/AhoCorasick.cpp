@@ -0,0 +1,202 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <map>
+#include <queue>
+#include <cstdint>
+#include <cstdio>
+#include "../../common/TextStream.h"
+using namespace std;
+
+// Aho-Corasick automaton over bytes. Each state stores its goto edges as a
+// 256-bit bitmap plus a contiguous run of child ids, so an edge lookup is one
+// bit test and a popcount instead of a map lookup or a 256-entry row. The root
+// keeps a dense table because almost every failure chain ends there.
+class AhoCorasick {
+    struct State {
+        uint64_t bits[4] = {0, 0, 0, 0};
+        int firstChild = 0;
+        int fail = 0;
+        int dictLink = 0;   // nearest state on the fail chain that ends a pattern
+        int depth = 0;
+    };
+
+    vector<State> states;
+    vector<int> children;   // children of state s: children[firstChild .. firstChild + popcount(bits))
+    vector<int> outBegin;   // patterns ending at s: outputs[outBegin[s] .. outBegin[s + 1])
+    vector<int> outputs;
+    int rootNext[256];
+
+    static int popcount(uint64_t x) { return __builtin_popcountll(x); }
+
+public:
+    int child(int s, unsigned char c) const {
+        const State& st = states[s];
+        uint64_t word = st.bits[c >> 6];
+        uint64_t bit = 1ULL << (c & 63);
+        if (!(word & bit)) return -1;
+        int rank = popcount(word & (bit - 1));
+        for (int w = 0; w < (c >> 6); w++) rank += popcount(st.bits[w]);
+        return children[st.firstChild + rank];
+    }
+
+    AhoCorasick(const vector<string>& patterns) {
+        // Build the trie with ordered maps first, then compress it
+        vector<map<unsigned char, int>> trie(1);
+        vector<vector<int>> ends(1);
+        vector<int> depth(1, 0);
+        for (size_t p = 0; p < patterns.size(); p++) {
+            int s = 0;
+            for (unsigned char c : patterns[p]) {
+                auto it = trie[s].find(c);
+                if (it == trie[s].end()) {
+                    trie[s][c] = trie.size();
+                    trie.emplace_back();
+                    ends.emplace_back();
+                    depth.push_back(depth[s] + 1);
+                    s = trie.size() - 1;
+                } else {
+                    s = it->second;
+                }
+            }
+            ends[s].push_back(p);
+        }
+
+        int n = trie.size();
+        states.resize(n);
+        outBegin.assign(n + 1, 0);
+        for (int s = 0; s < n; s++) {
+            states[s].firstChild = children.size();
+            states[s].depth = depth[s];
+            for (auto& [c, next] : trie[s]) {
+                states[s].bits[c >> 6] |= 1ULL << (c & 63);
+                children.push_back(next);
+            }
+            outBegin[s] = outputs.size();
+            for (int p : ends[s]) outputs.push_back(p);
+        }
+        outBegin[n] = outputs.size();
+
+        for (int c = 0; c < 256; c++) {
+            int next = child(0, c);
+            rootNext[c] = next < 0 ? 0 : next;
+        }
+
+        // Failure and dictionary links in BFS order
+        queue<int> bfs;
+        for (auto& [c, next] : trie[0]) bfs.push(next);
+        while (!bfs.empty()) {
+            int s = bfs.front();
+            bfs.pop();
+            for (auto& [c, next] : trie[s]) {
+                int f = states[s].fail;
+                while (f != 0 && child(f, c) < 0) f = states[f].fail;
+                int target = f == 0 ? rootNext[c] : child(f, c);
+                states[next].fail = target;
+                int fl = states[next].fail;
+                states[next].dictLink = outBegin[fl] < outBegin[fl + 1] ? fl : states[fl].dictLink;
+                bfs.push(next);
+            }
+        }
+    }
+
+    // Follow failure links until `c` can be consumed; hops counts the links taken
+    int step(int s, unsigned char c, int& hops) const {
+        hops = 0;
+        while (s != 0) {
+            int next = child(s, c);
+            if (next >= 0) return next;
+            s = states[s].fail;
+            hops++;
+        }
+        return rootNext[c];
+    }
+
+    // Calls emit(pattern, endPosition) for every pattern ending at state s
+    template <typename Emit>
+    void report(int s, size_t end, Emit emit) const {
+        if (outBegin[s] == outBegin[s + 1]) s = states[s].dictLink;
+        while (s != 0) {
+            for (int k = outBegin[s]; k < outBegin[s + 1]; k++) emit(outputs[k], end);
+            s = states[s].dictLink;
+        }
+    }
+
+    int stateCount() const { return states.size(); }
+    int depthOf(int s) const { return states[s].depth; }
+    int failOf(int s) const { return states[s].fail; }
+    size_t bytes() const {
+        return states.size() * sizeof(State) + children.size() * sizeof(int) +
+               (outBegin.size() + outputs.size()) * sizeof(int) + sizeof(rootNext);
+    }
+};
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        cout << "{\"error\":\"Usage: ./AhoCorasick <text> <pattern1,pattern2,...> [trace]\"}" << endl;
+        return 1;
+    }
+
+    string text = argv[1];
+    bool trace = argc >= 4 && string(argv[3]) == "trace";
+
+    vector<string> patterns;
+    stringstream ss(argv[2]);
+    string word;
+    while (getline(ss, word, ',')) {
+        if (!word.empty()) patterns.push_back(word);
+    }
+
+    AhoCorasick automaton(patterns);
+
+    struct Match { int pattern; size_t offset; };
+    vector<Match> matches;
+    string steps;
+    int s = 0;
+    for (size_t i = 0; i < text.size(); i++) {
+        int hops;
+        int from = s;
+        s = automaton.step(s, text[i], hops);
+        size_t before = matches.size();
+        automaton.report(s, i, [&](int p, size_t end) {
+            matches.push_back({p, end + 1 - patterns[p].size()});
+        });
+        if (trace) {
+            if (!steps.empty()) steps += ",";
+            steps += "{\"index\":" + to_string(i) +
+                     ",\"char\":\"" + jsonEscape(string(1, text[i])) + "\"" +
+                     ",\"from\":" + to_string(from) +
+                     ",\"to\":" + to_string(s) +
+                     ",\"depth\":" + to_string(automaton.depthOf(s)) +
+                     ",\"failHops\":" + to_string(hops) +
+                     ",\"fail\":" + to_string(automaton.failOf(s)) +
+                     ",\"matches\":[";
+            for (size_t k = before; k < matches.size(); k++) {
+                if (k > before) steps += ",";
+                steps += to_string(matches[k].pattern);
+            }
+            steps += "]}";
+        }
+    }
+
+    cout << "{\"algorithm\":\"Aho-Corasick\"";
+    if (trace) cout << ",\"text\":\"" << jsonEscape(text) << "\"";
+    cout << ",\"patterns\":[";
+    for (size_t p = 0; p < patterns.size(); p++) {
+        if (p > 0) cout << ",";
+        cout << "\"" << jsonEscape(patterns[p]) << "\"";
+    }
+    cout << "],\"states\":" << automaton.stateCount()
+         << ",\"automatonBytes\":" << automaton.bytes()
+         << ",\"matches\":[";
+    for (size_t k = 0; k < matches.size(); k++) {
+        if (k > 0) cout << ",";
+        cout << "{\"pattern\":" << matches[k].pattern << ",\"offset\":" << matches[k].offset << "}";
+    }
+    cout << "],\"totalMatches\":" << matches.size();
+    if (trace) cout << ",\"steps\":[" << steps << "]";
+    cout << "}" << endl;
+
+    return 0;
+}
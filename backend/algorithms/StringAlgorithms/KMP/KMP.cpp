@@ -1,6 +1,9 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <random>
+#include "../../common/TextStream.h"
+#include "../../common/FastSearch.h"
 using namespace std;
 
 vector<int> computeLPS(string pattern) {
@@ -26,20 +29,11 @@ vector<int> computeLPS(string pattern) {
     return lps;
 }
 
-int main(int argc, char* argv[]) {
-    if (argc < 3) {
-        cout << "{\"error\":\"Usage: ./KMP <text> <pattern>\"}" << endl;
-        return 1;
-    }
-    
-    string text = argv[1];
-    string pattern = argv[2];
-    
-    vector<int> lps = computeLPS(pattern);
-    vector<int> matches;
-    
-    int i = 0, j = 0;
-    int n = text.length();
+// Calls onMatch(base + i) for every occurrence of pattern starting at text[i]
+template <typename OnMatch>
+void kmpSearch(const char* text, size_t n, const string& pattern, const vector<int>& lps, size_t base, OnMatch onMatch) {
+    size_t i = 0;
+    int j = 0;
     int m = pattern.length();
     
     while (i < n) {
@@ -49,7 +43,7 @@ int main(int argc, char* argv[]) {
         }
         
         if (j == m) {
-            matches.push_back(i - j);
+            onMatch(base + i - j);
             j = lps[j - 1];
         } else if (i < n && pattern[j] != text[i]) {
             if (j != 0) {
@@ -59,9 +53,152 @@ int main(int argc, char* argv[]) {
             }
         }
     }
+}
+
+// Scan a file (memory-mapped) or stdin in chunks, printing only match offsets
+int streamSearch(const string& path, const string& pattern, size_t chunkSize) {
+    vector<int> lps = computeLPS(pattern);
+    size_t total = 0;
+    
+    cout << "{\"algorithm\":\"KMP\",\"mode\":\"stream\",\"pattern\":\"" << jsonEscape(pattern) << "\",\"matches\":[";
+    StreamStats stats;
+    string error;
+    bool ok = scanTextSource(path, pattern.length() - 1, chunkSize, [&](const char* data, size_t len, size_t base) {
+        kmpSearch(data, len, pattern, lps, base, [&](size_t offset) {
+            if (total++ > 0) cout << ",";
+            cout << offset;
+        });
+    }, stats, error);
+    cout << "],\"totalMatches\":" << total;
+    if (!ok) {
+        cout << ",\"error\":\"" << jsonEscape(error) << "\"}" << endl;
+        return 1;
+    }
+    cout << ",\"bytes\":" << stats.bytes << ",\"mapped\":" << (stats.mapped ? "true" : "false")
+         << ",\"seconds\":" << stats.seconds
+         << ",\"bytesPerSec\":" << (stats.seconds > 0 ? stats.bytes / stats.seconds : 0) << "}" << endl;
+    return 0;
+}
+
+// Split the whole text across threads, each running KMP on its own chunk
+int parallelSearch(const string& path, const string& pattern, unsigned threads) {
+    vector<int> lps = computeLPS(pattern);
+    MappedText text;
+    string error;
+    if (!text.open(path, error)) {
+        cout << "{\"algorithm\":\"KMP\",\"mode\":\"parallel\",\"error\":\"" << jsonEscape(error) << "\"}" << endl;
+        return 1;
+    }
+    
+    auto start = chrono::steady_clock::now();
+    vector<size_t> matches = parallelScan(text.data, text.size, pattern.length() - 1, threads,
+        [&](const char* data, size_t len, size_t base, auto onMatch) {
+            kmpSearch(data, len, pattern, lps, base, onMatch);
+        });
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    
+    cout << "{\"algorithm\":\"KMP\",\"mode\":\"parallel\",\"pattern\":\"" << jsonEscape(pattern) << "\",\"matches\":[";
+    for (size_t i = 0; i < matches.size(); i++) {
+        if (i > 0) cout << ",";
+        cout << matches[i];
+    }
+    cout << "],\"totalMatches\":" << matches.size()
+         << ",\"threads\":" << threads
+         << ",\"bytes\":" << text.size
+         << ",\"seconds\":" << seconds
+         << ",\"bytesPerSec\":" << (seconds > 0 ? text.size / seconds : 0) << "}" << endl;
+    return 0;
+}
+
+// Throughput of the parallel scan on a random text for 1, 2, 4, ... threads
+int parallelBenchmark(size_t megabytes, const string& pattern) {
+    vector<int> lps = computeLPS(pattern);
+    string text(megabytes << 20, 'a');
+    mt19937 rng(7);
+    for (char& c : text) c = "acgt"[rng() & 3];
+    
+    unsigned maxThreads = max(1u, thread::hardware_concurrency());
+    size_t expected = 0;
+    cout << "{\"algorithm\":\"KMP\",\"mode\":\"parallel-benchmark\",\"bytes\":" << text.size()
+         << ",\"pattern\":\"" << pattern << "\",\"hardwareThreads\":" << maxThreads << ",\"results\":[";
+    for (unsigned threads = 1; threads <= maxThreads * 2; threads *= 2) {
+        double best = 1e30;
+        size_t count = 0;
+        for (int run = 0; run < 3; run++) {
+            auto start = chrono::steady_clock::now();
+            count = parallelScan(text.data(), text.size(), pattern.length() - 1, threads,
+                [&](const char* data, size_t len, size_t base, auto onMatch) {
+                    kmpSearch(data, len, pattern, lps, base, onMatch);
+                }).size();
+            best = min(best, chrono::duration<double>(chrono::steady_clock::now() - start).count());
+        }
+        if (threads == 1) expected = count;
+        if (threads > 1) cout << ",";
+        cout << "{\"threads\":" << threads << ",\"seconds\":" << best
+             << ",\"gbPerSec\":" << text.size() / best / 1e9
+             << ",\"totalMatches\":" << count
+             << ",\"consistent\":" << (count == expected ? "true" : "false") << "}";
+    }
+    cout << "]}" << endl;
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    ios::sync_with_stdio(false);
+    if (argc >= 2 && string(argv[1]) == "--bench-fast") {
+        size_t megabytes = argc >= 3 ? stoull(argv[2]) : 64;
+        fastsearch::benchmark("KMP", megabytes, [](const char* data, size_t len, const string& pattern, auto onMatch) {
+            vector<int> lps = computeLPS(pattern);
+            kmpSearch(data, len, pattern, lps, 0, onMatch);
+        });
+        return 0;
+    }
+    if (argc >= 2 && string(argv[1]) == "--bench-parallel") {
+        size_t megabytes = argc >= 3 ? stoull(argv[2]) : 256;
+        string pattern = argc >= 4 ? argv[3] : "acgtacgt";
+        return parallelBenchmark(megabytes, pattern);
+    }
+    if (argc >= 4 && string(argv[1]) == "--parallel") {
+        string pattern = argv[3];
+        if (pattern.empty()) {
+            cout << "{\"error\":\"Pattern must not be empty\"}" << endl;
+            return 1;
+        }
+        unsigned threads = argc >= 5 ? stoul(argv[4]) : max(1u, thread::hardware_concurrency());
+        return parallelSearch(argv[2], pattern, threads);
+    }
+    if (argc >= 4 && string(argv[1]) == "--file") {
+        string pattern = argv[3];
+        if (pattern.empty()) {
+            cout << "{\"error\":\"Pattern must not be empty\"}" << endl;
+            return 1;
+        }
+        size_t chunkSize = argc >= 5 ? stoull(argv[4]) : (1 << 20);
+        return streamSearch(argv[2], pattern, chunkSize);
+    }
+    if (argc < 3) {
+        cout << "{\"error\":\"Usage: ./KMP <text> <pattern> [fast] | ./KMP --file <path|-> <pattern> [chunkBytes] | ./KMP --parallel <path|-> <pattern> [threads] | ./KMP --bench-parallel [megabytes] [pattern] | ./KMP --bench-fast [megabytes]\"}" << endl;
+        return 1;
+    }
+    
+    string text = argv[1];
+    string pattern = argv[2];
+    
+    bool fast = argc >= 4 && string(argv[3]) == "fast";
+    vector<int> matches;
+    if (fast) {
+        fastsearch::search(text.data(), text.length(), pattern, 0, [&](size_t offset) {
+            matches.push_back(offset);
+        });
+    } else {
+        vector<int> lps = computeLPS(pattern);
+        kmpSearch(text.data(), text.length(), pattern, lps, 0, [&](size_t offset) {
+            matches.push_back(offset);
+        });
+    }
     
     // Output JSON
-    cout << "{\"algorithm\":\"KMP\",\"text\":\"" << text << "\",\"pattern\":\"" << pattern << "\",\"matches\":[";
+    cout << "{\"algorithm\":\"KMP\"" << (fast ? ",\"mode\":\"fast\"" : "") << ",\"text\":\"" << text << "\",\"pattern\":\"" << pattern << "\",\"matches\":[";
     for (size_t i = 0; i < matches.size(); i++) {
         if (i > 0) cout << ",";
         cout << matches[i];
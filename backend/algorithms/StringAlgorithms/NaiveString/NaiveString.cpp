@@ -1,35 +1,93 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include "../../common/TextStream.h"
+#include "../../common/FastSearch.h"
 using namespace std;
 
+// Calls onMatch(base + i) for every occurrence of pattern starting at text[i]
+template <typename OnMatch>
+void naiveSearch(const char* text, size_t n, const string& pattern, size_t base, OnMatch onMatch) {
+    size_t m = pattern.length();
+    if (m > n) return;
+    
+    for (size_t i = 0; i <= n - m; i++) {
+        size_t j;
+        for (j = 0; j < m; j++) {
+            if (text[i + j] != pattern[j]) {
+                break;
+            }
+        }
+        if (j == m) {
+            onMatch(base + i);
+        }
+    }
+}
+
+// Scan a file (memory-mapped) or stdin in chunks, printing only match offsets
+int streamSearch(const string& path, const string& pattern, size_t chunkSize) {
+    size_t total = 0;
+    
+    cout << "{\"algorithm\":\"Naive String\",\"mode\":\"stream\",\"pattern\":\"" << jsonEscape(pattern) << "\",\"matches\":[";
+    StreamStats stats;
+    string error;
+    bool ok = scanTextSource(path, pattern.length() - 1, chunkSize, [&](const char* data, size_t len, size_t base) {
+        naiveSearch(data, len, pattern, base, [&](size_t offset) {
+            if (total++ > 0) cout << ",";
+            cout << offset;
+        });
+    }, stats, error);
+    cout << "],\"totalMatches\":" << total;
+    if (!ok) {
+        cout << ",\"error\":\"" << jsonEscape(error) << "\"}" << endl;
+        return 1;
+    }
+    cout << ",\"bytes\":" << stats.bytes << ",\"mapped\":" << (stats.mapped ? "true" : "false")
+         << ",\"seconds\":" << stats.seconds
+         << ",\"bytesPerSec\":" << (stats.seconds > 0 ? stats.bytes / stats.seconds : 0) << "}" << endl;
+    return 0;
+}
+
 int main(int argc, char* argv[]) {
+    ios::sync_with_stdio(false);
+    if (argc >= 2 && string(argv[1]) == "--bench-fast") {
+        size_t megabytes = argc >= 3 ? stoull(argv[2]) : 64;
+        fastsearch::benchmark("Naive String", megabytes, [](const char* data, size_t len, const string& pattern, auto onMatch) {
+            naiveSearch(data, len, pattern, 0, onMatch);
+        });
+        return 0;
+    }
+    if (argc >= 4 && string(argv[1]) == "--file") {
+        string pattern = argv[3];
+        if (pattern.empty()) {
+            cout << "{\"error\":\"Pattern must not be empty\"}" << endl;
+            return 1;
+        }
+        size_t chunkSize = argc >= 5 ? stoull(argv[4]) : (1 << 20);
+        return streamSearch(argv[2], pattern, chunkSize);
+    }
     if (argc < 3) {
-        cout << "{\"error\":\"Usage: ./NaiveString <text> <pattern>\"}" << endl;
+        cout << "{\"error\":\"Usage: ./NaiveString <text> <pattern> [fast] | ./NaiveString --file <path|-> <pattern> [chunkBytes] | ./NaiveString --bench-fast [megabytes]\"}" << endl;
         return 1;
     }
     
     string text = argv[1];
     string pattern = argv[2];
     
-    int n = text.length();
-    int m = pattern.length();
+    bool fast = argc >= 4 && string(argv[3]) == "fast";
     vector<int> matches;
-    
-    for (int i = 0; i <= n - m; i++) {
-        int j;
-        for (j = 0; j < m; j++) {
-            if (text[i + j] != pattern[j]) {
-                break;
-            }
-        }
-        if (j == m) {
-            matches.push_back(i);
-        }
+    if (fast) {
+        fastsearch::search(text.data(), text.length(), pattern, 0, [&](size_t offset) {
+            matches.push_back(offset);
+        });
+    } else {
+        naiveSearch(text.data(), text.length(), pattern, 0, [&](size_t offset) {
+            matches.push_back(offset);
+        });
     }
     
     // Output JSON
-    cout << "{\"algorithm\":\"Naive String\",\"text\":\"" << text << "\",\"pattern\":\"" << pattern << "\",\"matches\":[";
+    cout << "{\"algorithm\":\"Naive String\"" << (fast ? ",\"mode\":\"fast\"" : "") << ",\"text\":\"" << text << "\",\"pattern\":\"" << pattern << "\",\"matches\":[";
     for (size_t i = 0; i < matches.size(); i++) {
         if (i > 0) cout << ",";
         cout << matches[i];
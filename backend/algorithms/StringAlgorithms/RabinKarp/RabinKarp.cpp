@@ -1,70 +1,302 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <unordered_map>
+#include <sstream>
+#include "../../common/TextStream.h"
+#include "../../common/FastSearch.h"
 using namespace std;
 
-#define d 256
-#define q 101
-
-int main(int argc, char* argv[]) {
-    if (argc < 3) {
-        cout << "{\"error\":\"Usage: ./RabinKarp <text> <pattern>\"}" << endl;
-        return 1;
-    }
+// Polynomial rolling hash modulo the Mersenne prime 2^61 - 1 with a base drawn
+// at random per run. Two different windows collide with probability about
+// m / 2^61, so verification almost only runs on real matches and no fixed
+// input can be crafted to force collisions.
+struct RollingHash {
+    static const uint64_t MOD = (1ULL << 61) - 1;
+    uint64_t base;
     
-    string text = argv[1];
-    string pattern = argv[2];
+    RollingHash() {
+        random_device rd;
+        mt19937_64 rng(((uint64_t)rd() << 32) ^ rd());
+        base = uniform_int_distribution<uint64_t>(256, MOD - 1)(rng);
+    }
     
-    int n = text.length();
-    int m = pattern.length();
-    vector<int> matches;
+    static uint64_t mulmod(uint64_t a, uint64_t b) {
+        unsigned __int128 product = (unsigned __int128)a * b;
+        uint64_t r = (uint64_t)(product & MOD) + (uint64_t)(product >> 61);
+        return r >= MOD ? r - MOD : r;
+    }
     
-    int p = 0; // hash value for pattern
-    int t = 0; // hash value for text
-    int h = 1;
+    // Hash of s[0, m)
+    uint64_t hash(const char* s, size_t m) const {
+        uint64_t h = 0;
+        for (size_t i = 0; i < m; i++) {
+            h = mulmod(h, base) + (unsigned char)s[i];
+            if (h >= MOD) h -= MOD;
+        }
+        return h;
+    }
     
-    // Calculate h = pow(d, m-1) % q
-    for (int i = 0; i < m - 1; i++) {
-        h = (h * d) % q;
+    // base^(m-1), the weight of the byte leaving the window
+    uint64_t leadingPower(size_t m) const {
+        uint64_t h = 1;
+        for (size_t i = 0; i + 1 < m; i++) h = mulmod(h, base);
+        return h;
     }
     
-    // Calculate hash for pattern and first window
-    for (int i = 0; i < m; i++) {
-        p = (d * p + pattern[i]) % q;
-        t = (d * t + text[i]) % q;
+    // Slide the window one byte: drop `out`, append `in`
+    uint64_t roll(uint64_t h, char out, char in, uint64_t power) const {
+        uint64_t drop = mulmod((unsigned char)out, power);
+        h = h >= drop ? h - drop : h + MOD - drop;
+        h = mulmod(h, base) + (unsigned char)in;
+        return h >= MOD ? h - MOD : h;
     }
+};
+
+struct HashStats {
+    size_t hashHits = 0;      // windows whose hash matched a pattern
+    size_t spuriousHits = 0;  // ... but whose bytes did not
+};
+
+// Calls onMatch(base + i) for every occurrence of pattern starting at text[i]
+template <typename OnMatch>
+void rabinKarpSearch(const RollingHash& rh, const char* text, size_t n, const string& pattern, size_t base,
+                     OnMatch onMatch, HashStats* stats = nullptr) {
+    size_t m = pattern.length();
+    if (m == 0 || m > n) return;
+    
+    uint64_t power = rh.leadingPower(m);
+    uint64_t p = rh.hash(pattern.data(), m); // hash value for pattern
+    uint64_t t = rh.hash(text, m);           // hash value for text
     
     // Slide pattern over text
-    for (int i = 0; i <= n - m; i++) {
+    for (size_t i = 0; i <= n - m; i++) {
         if (p == t) {
-            // Check characters one by one
-            int j;
-            for (j = 0; j < m; j++) {
-                if (text[i + j] != pattern[j]) {
-                    break;
-                }
-            }
-            if (j == m) {
-                matches.push_back(i);
+            if (stats) stats->hashHits++;
+            if (memcmp(text + i, pattern.data(), m) == 0) {
+                onMatch(base + i);
+            } else if (stats) {
+                stats->spuriousHits++;
             }
         }
         
         // Calculate hash for next window
         if (i < n - m) {
-            t = (d * (t - text[i] * h) + text[i + m]) % q;
-            if (t < 0) {
-                t = (t + q);
+            t = rh.roll(t, text[i], text[i + m], power);
+        }
+    }
+}
+
+// Many equal-length patterns at once: one rolling hash per window and a hash
+// table lookup instead of one pass per pattern. Calls onMatch(patternIndex, offset).
+template <typename OnMatch>
+void rabinKarpMulti(const RollingHash& rh, const char* text, size_t n, const vector<string>& patterns,
+                    OnMatch onMatch, HashStats* stats = nullptr) {
+    size_t m = patterns[0].length();
+    if (m == 0 || m > n) return;
+    
+    unordered_map<uint64_t, vector<int>> byHash;
+    for (size_t k = 0; k < patterns.size(); k++) {
+        byHash[rh.hash(patterns[k].data(), m)].push_back(k);
+    }
+    
+    uint64_t power = rh.leadingPower(m);
+    uint64_t t = rh.hash(text, m);
+    for (size_t i = 0; i <= n - m; i++) {
+        auto it = byHash.find(t);
+        if (it != byHash.end()) {
+            if (stats) stats->hashHits++;
+            bool matched = false;
+            for (int k : it->second) {
+                if (memcmp(text + i, patterns[k].data(), m) == 0) {
+                    onMatch(k, i);
+                    matched = true;
+                }
+            }
+            if (!matched && stats) stats->spuriousHits++;
+        }
+        if (i < n - m) {
+            t = rh.roll(t, text[i], text[i + m], power);
+        }
+    }
+}
+
+// Groups of offsets where the same length-m substring occurs more than once.
+// Windows are bucketed by hash and confirmed with memcmp, so a collision can
+// never merge two different substrings.
+vector<vector<size_t>> duplicateSubstrings(const RollingHash& rh, const char* text, size_t n, size_t m, HashStats& stats) {
+    vector<vector<size_t>> groups;
+    if (m == 0 || m > n) return groups;
+    
+    unordered_map<uint64_t, vector<size_t>> groupsByHash; // hash -> indices into groups
+    uint64_t power = rh.leadingPower(m);
+    uint64_t t = rh.hash(text, m);
+    for (size_t i = 0; i <= n - m; i++) {
+        vector<size_t>& candidates = groupsByHash[t];
+        bool placed = false;
+        if (!candidates.empty()) stats.hashHits++;
+        for (size_t g : candidates) {
+            if (memcmp(text + groups[g][0], text + i, m) == 0) {
+                groups[g].push_back(i);
+                placed = true;
+                break;
             }
         }
+        if (!placed) {
+            if (!candidates.empty()) stats.spuriousHits++;
+            candidates.push_back(groups.size());
+            groups.push_back({i});
+        }
+        if (i < n - m) {
+            t = rh.roll(t, text[i], text[i + m], power);
+        }
+    }
+    
+    vector<vector<size_t>> repeated;
+    for (auto& g : groups) {
+        if (g.size() > 1) repeated.push_back(move(g));
+    }
+    return repeated;
+}
+
+// Scan a file (memory-mapped) or stdin in chunks, printing only match offsets
+int streamSearch(const string& path, const string& pattern, size_t chunkSize) {
+    RollingHash rh;
+    HashStats hashStats;
+    size_t total = 0;
+    
+    cout << "{\"algorithm\":\"Rabin-Karp\",\"mode\":\"stream\",\"pattern\":\"" << jsonEscape(pattern) << "\",\"matches\":[";
+    StreamStats stats;
+    string error;
+    bool ok = scanTextSource(path, pattern.length() - 1, chunkSize, [&](const char* data, size_t len, size_t base) {
+        rabinKarpSearch(rh, data, len, pattern, base, [&](size_t offset) {
+            if (total++ > 0) cout << ",";
+            cout << offset;
+        }, &hashStats);
+    }, stats, error);
+    cout << "],\"totalMatches\":" << total;
+    if (!ok) {
+        cout << ",\"error\":\"" << jsonEscape(error) << "\"}" << endl;
+        return 1;
+    }
+    cout << ",\"spuriousHits\":" << hashStats.spuriousHits
+         << ",\"bytes\":" << stats.bytes << ",\"mapped\":" << (stats.mapped ? "true" : "false")
+         << ",\"seconds\":" << stats.seconds
+         << ",\"bytesPerSec\":" << (stats.seconds > 0 ? stats.bytes / stats.seconds : 0) << "}" << endl;
+    return 0;
+}
+
+int multiSearch(const string& text, const string& patternList) {
+    vector<string> patterns;
+    stringstream ss(patternList);
+    string word;
+    while (getline(ss, word, ',')) {
+        if (!word.empty()) patterns.push_back(word);
+    }
+    if (patterns.empty()) {
+        cout << "{\"error\":\"No patterns given\"}" << endl;
+        return 1;
+    }
+    for (const string& p : patterns) {
+        if (p.length() != patterns[0].length()) {
+            cout << "{\"error\":\"Multi-pattern mode needs patterns of equal length\"}" << endl;
+            return 1;
+        }
+    }
+    
+    RollingHash rh;
+    HashStats hashStats;
+    size_t total = 0;
+    cout << "{\"algorithm\":\"Rabin-Karp\",\"mode\":\"multi\",\"patterns\":" << patterns.size() << ",\"matches\":[";
+    rabinKarpMulti(rh, text.data(), text.length(), patterns, [&](int k, size_t offset) {
+        if (total++ > 0) cout << ",";
+        cout << "{\"pattern\":" << k << ",\"offset\":" << offset << "}";
+    }, &hashStats);
+    cout << "],\"totalMatches\":" << total
+         << ",\"hashHits\":" << hashStats.hashHits
+         << ",\"spuriousHits\":" << hashStats.spuriousHits << "}" << endl;
+    return 0;
+}
+
+int duplicateSearch(const string& text, size_t length) {
+    RollingHash rh;
+    HashStats hashStats;
+    vector<vector<size_t>> groups = duplicateSubstrings(rh, text.data(), text.length(), length, hashStats);
+    
+    cout << "{\"algorithm\":\"Rabin-Karp\",\"mode\":\"duplicates\",\"length\":" << length << ",\"duplicates\":[";
+    for (size_t g = 0; g < groups.size(); g++) {
+        if (g > 0) cout << ",";
+        cout << "{\"substring\":\"" << jsonEscape(text.data() + groups[g][0], length) << "\",\"offsets\":[";
+        for (size_t i = 0; i < groups[g].size(); i++) {
+            if (i > 0) cout << ",";
+            cout << groups[g][i];
+        }
+        cout << "]}";
+    }
+    cout << "],\"totalDuplicates\":" << groups.size()
+         << ",\"spuriousHits\":" << hashStats.spuriousHits << "}" << endl;
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    ios::sync_with_stdio(false);
+    if (argc >= 2 && string(argv[1]) == "--bench-fast") {
+        size_t megabytes = argc >= 3 ? stoull(argv[2]) : 64;
+        RollingHash rh;
+        fastsearch::benchmark("Rabin-Karp", megabytes, [&](const char* data, size_t len, const string& pattern, auto onMatch) {
+            rabinKarpSearch(rh, data, len, pattern, 0, onMatch);
+        });
+        return 0;
+    }
+    if (argc >= 4 && string(argv[1]) == "--multi") {
+        return multiSearch(argv[2], argv[3]);
+    }
+    if (argc >= 4 && string(argv[1]) == "--duplicates") {
+        return duplicateSearch(argv[2], stoull(argv[3]));
+    }
+    if (argc >= 4 && string(argv[1]) == "--file") {
+        string pattern = argv[3];
+        if (pattern.empty()) {
+            cout << "{\"error\":\"Pattern must not be empty\"}" << endl;
+            return 1;
+        }
+        size_t chunkSize = argc >= 5 ? stoull(argv[4]) : (1 << 20);
+        return streamSearch(argv[2], pattern, chunkSize);
+    }
+    if (argc < 3) {
+        cout << "{\"error\":\"Usage: ./RabinKarp <text> <pattern> [fast] | ./RabinKarp --file <path|-> <pattern> [chunkBytes] | ./RabinKarp --bench-fast [megabytes] | ./RabinKarp --multi <text> <p1,p2,...> | ./RabinKarp --duplicates <text> <length>\"}" << endl;
+        return 1;
+    }
+    
+    string text = argv[1];
+    string pattern = argv[2];
+    
+    bool fast = argc >= 4 && string(argv[3]) == "fast";
+    RollingHash rh;
+    HashStats hashStats;
+    vector<int> matches;
+    if (fast) {
+        fastsearch::search(text.data(), text.length(), pattern, 0, [&](size_t offset) {
+            matches.push_back(offset);
+        });
+    } else {
+        rabinKarpSearch(rh, text.data(), text.length(), pattern, 0, [&](size_t offset) {
+            matches.push_back(offset);
+        }, &hashStats);
     }
     
     // Output JSON
-    cout << "{\"algorithm\":\"Rabin-Karp\",\"text\":\"" << text << "\",\"pattern\":\"" << pattern << "\",\"matches\":[";
+    cout << "{\"algorithm\":\"Rabin-Karp\"" << (fast ? ",\"mode\":\"fast\"" : "") << ",\"text\":\"" << text << "\",\"pattern\":\"" << pattern << "\",\"matches\":[";
     for (size_t i = 0; i < matches.size(); i++) {
         if (i > 0) cout << ",";
         cout << matches[i];
     }
-    cout << "],\"totalMatches\":" << matches.size() << "}" << endl;
+    cout << "],\"totalMatches\":" << matches.size();
+    if (!fast) cout << ",\"hashHits\":" << hashStats.hashHits << ",\"spuriousHits\":" << hashStats.spuriousHits;
+    cout << "}" << endl;
     
     return 0;
 }
@@ -0,0 +1,353 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <chrono>
+#include "../../common/TextStream.h"
+using namespace std;
+
+// Suffix array (SA-IS, linear time) with Kasai LCP over a text that is indexed
+// once and queried many times. The index is written as one binary file that
+// is memory-mapped on load, so a query costs O(m log n) without re-reading or
+// re-sorting the text.
+//
+// File layout (little endian, sections 8-byte aligned):
+//   IndexHeader | text bytes | int32 sa[n] | int32 lcp[n]
+// lcp[i] is the longest common prefix of suffixes sa[i-1] and sa[i]; lcp[0] = 0.
+
+const char INDEX_MAGIC[4] = {'A', 'V', 'S', 'A'};
+const uint32_t INDEX_VERSION = 1;
+
+struct IndexHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t textLength;
+    uint64_t textOffset;
+    uint64_t saOffset;
+    uint64_t lcpOffset;
+};
+
+// SA-IS over s[i] in [0, upper]
+vector<int> suffixArray(const vector<int>& s, int upper) {
+    int n = s.size();
+    if (n == 0) return {};
+    if (n == 1) return {0};
+    if (n == 2) return s[0] < s[1] ? vector<int>{0, 1} : vector<int>{1, 0};
+
+    vector<int> sa(n);
+    vector<bool> isS(n, false); // S-type: suffix i < suffix i+1
+    for (int i = n - 2; i >= 0; i--) {
+        isS[i] = s[i] == s[i + 1] ? isS[i + 1] : s[i] < s[i + 1];
+    }
+
+    // Bucket boundaries: sumL[c] = start of c's L bucket, sumS[c] = start of its S bucket
+    vector<int> sumL(upper + 1, 0), sumS(upper + 1, 0);
+    for (int i = 0; i < n; i++) {
+        if (!isS[i]) sumS[s[i]]++;
+        else sumL[s[i] + 1]++;
+    }
+    for (int c = 0; c <= upper; c++) {
+        sumS[c] += sumL[c];
+        if (c < upper) sumL[c + 1] += sumS[c];
+    }
+
+    auto induce = [&](const vector<int>& lms) {
+        fill(sa.begin(), sa.end(), -1);
+        vector<int> bucket(sumS);
+        for (int p : lms) {
+            if (p != n) sa[bucket[s[p]]++] = p;
+        }
+        bucket = sumL;
+        sa[bucket[s[n - 1]]++] = n - 1;
+        for (int i = 0; i < n; i++) {
+            int v = sa[i];
+            if (v >= 1 && !isS[v - 1]) sa[bucket[s[v - 1]]++] = v - 1;
+        }
+        bucket = sumL;
+        for (int i = n - 1; i >= 0; i--) {
+            int v = sa[i];
+            if (v >= 1 && isS[v - 1]) sa[--bucket[s[v - 1] + 1]] = v - 1;
+        }
+    };
+
+    vector<int> lmsIndex(n + 1, -1);
+    vector<int> lms;
+    for (int i = 1; i < n; i++) {
+        if (!isS[i - 1] && isS[i]) {
+            lmsIndex[i] = lms.size();
+            lms.push_back(i);
+        }
+    }
+    int m = lms.size();
+    induce(lms);
+
+    if (m > 0) {
+        // Name LMS substrings in sorted order and recurse on the reduced string
+        vector<int> sortedLms;
+        for (int v : sa) {
+            if (lmsIndex[v] != -1) sortedLms.push_back(v);
+        }
+        vector<int> reduced(m);
+        int names = 0;
+        reduced[lmsIndex[sortedLms[0]]] = 0;
+        for (int i = 1; i < m; i++) {
+            int l = sortedLms[i - 1], r = sortedLms[i];
+            int endL = lmsIndex[l] + 1 < m ? lms[lmsIndex[l] + 1] : n;
+            int endR = lmsIndex[r] + 1 < m ? lms[lmsIndex[r] + 1] : n;
+            bool same = endL - l == endR - r;
+            if (same) {
+                while (l < endL && s[l] == s[r]) {
+                    l++;
+                    r++;
+                }
+                if (l == n || s[l] != s[r]) same = false;
+            }
+            if (!same) names++;
+            reduced[lmsIndex[sortedLms[i]]] = names;
+        }
+        vector<int> reducedSa = suffixArray(reduced, names);
+        for (int i = 0; i < m; i++) sortedLms[i] = lms[reducedSa[i]];
+        induce(sortedLms);
+    }
+    return sa;
+}
+
+// Kasai: lcp[i] = LCP(suffix sa[i-1], suffix sa[i]), lcp[0] = 0
+template <typename Seq>
+vector<int> lcpArray(const Seq& s, int n, const vector<int>& sa) {
+    vector<int> rank(n), lcp(n, 0);
+    for (int i = 0; i < n; i++) rank[sa[i]] = i;
+    int h = 0;
+    for (int i = 0; i < n; i++) {
+        if (h > 0) h--;
+        if (rank[i] == 0) {
+            h = 0;
+            continue;
+        }
+        int j = sa[rank[i] - 1];
+        while (i + h < n && j + h < n && s[i + h] == s[j + h]) h++;
+        lcp[rank[i]] = h;
+    }
+    return lcp;
+}
+
+// Read-only view over a mapped index file
+struct SuffixIndex {
+    MappedText file;
+    const char* text = nullptr;
+    const int32_t* sa = nullptr;
+    const int32_t* lcp = nullptr;
+    size_t n = 0;
+
+    bool open(const string& path, string& error) {
+        if (!file.open(path, error)) return false;
+        if (file.size < sizeof(IndexHeader)) {
+            error = "Index file is truncated";
+            return false;
+        }
+        IndexHeader header;
+        memcpy(&header, file.data, sizeof(header));
+        if (memcmp(header.magic, INDEX_MAGIC, 4) != 0 || header.version != INDEX_VERSION) {
+            error = "Not a suffix array index (or unsupported version)";
+            return false;
+        }
+        // Every section inside the file and aligned for its entries, with
+        // no arithmetic that can wrap on a hostile header
+        auto fits = [&](uint64_t at, uint64_t count, uint64_t width) {
+            return at % width == 0 && at >= sizeof(IndexHeader) && at <= file.size && count <= (file.size - at) / width;
+        };
+        n = header.textLength;
+        if (n >= (size_t)INT32_MAX || !fits(header.textOffset, n, 1) || !fits(header.saOffset, n, sizeof(int32_t)) ||
+            !fits(header.lcpOffset, n, sizeof(int32_t))) {
+            error = "Index file is truncated or has a corrupt header";
+            return false;
+        }
+        text = file.data + header.textOffset;
+        sa = reinterpret_cast<const int32_t*>(file.data + header.saOffset);
+        lcp = reinterpret_cast<const int32_t*>(file.data + header.lcpOffset);
+        // Queries index the text through sa and read lcp bytes from there
+        for (size_t i = 0; i < n; i++) {
+            if (sa[i] < 0 || (size_t)sa[i] >= n || lcp[i] < 0 || (size_t)lcp[i] > n - sa[i]) {
+                error = "Index file has a corrupt suffix array";
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Compare suffix `pos` against pattern, looking at most m bytes
+    int compare(int32_t pos, const string& pattern) const {
+        size_t avail = n - pos;
+        size_t len = min(avail, pattern.size());
+        int c = memcmp(text + pos, pattern.data(), len);
+        if (c != 0) return c;
+        return avail < pattern.size() ? -1 : 0;
+    }
+
+    // SA range [lo, hi) of suffixes starting with pattern
+    pair<size_t, size_t> range(const string& pattern) const {
+        size_t lo = 0, hi = n;
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            if (compare(sa[mid], pattern) < 0) lo = mid + 1;
+            else hi = mid;
+        }
+        size_t first = lo;
+        hi = n;
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            if (compare(sa[mid], pattern) <= 0) lo = mid + 1;
+            else hi = mid;
+        }
+        return {first, lo};
+    }
+};
+
+size_t align8(size_t x) { return (x + 7) & ~size_t(7); }
+
+int buildIndex(const string& input, const string& output) {
+    MappedText text;
+    string error;
+    if (!text.open(input, error)) {
+        cout << "{\"error\":\"" << jsonEscape(error) << "\"}" << endl;
+        return 1;
+    }
+    if (text.size >= (size_t)INT32_MAX) {
+        cout << "{\"error\":\"Texts of 2 GiB or more are not supported by the 32-bit index\"}" << endl;
+        return 1;
+    }
+    int n = text.size;
+
+    auto start = chrono::steady_clock::now();
+    vector<int> s(n);
+    for (int i = 0; i < n; i++) s[i] = (unsigned char)text.data[i];
+    vector<int> sa = suffixArray(s, 255);
+    vector<int>().swap(s);
+    vector<int> lcp = lcpArray(text.data, n, sa);
+    double buildSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    IndexHeader header;
+    memcpy(header.magic, INDEX_MAGIC, 4);
+    header.version = INDEX_VERSION;
+    header.textLength = n;
+    header.textOffset = align8(sizeof(IndexHeader));
+    header.saOffset = align8(header.textOffset + n);
+    header.lcpOffset = header.saOffset + (size_t)n * sizeof(int32_t);
+
+    FILE* out = fopen(output.c_str(), "wb");
+    if (!out) {
+        cout << "{\"error\":\"Cannot write " << jsonEscape(output) << "\"}" << endl;
+        return 1;
+    }
+    const char zeros[8] = {0};
+    fwrite(&header, sizeof(header), 1, out);
+    fwrite(zeros, 1, header.textOffset - sizeof(header), out);
+    fwrite(text.data, 1, n, out);
+    fwrite(zeros, 1, header.saOffset - (header.textOffset + n), out);
+    fwrite(sa.data(), sizeof(int32_t), n, out);
+    fwrite(lcp.data(), sizeof(int32_t), n, out);
+    bool ok = fclose(out) == 0;
+    if (!ok) {
+        cout << "{\"error\":\"Failed writing " << jsonEscape(output) << "\"}" << endl;
+        return 1;
+    }
+
+    cout << "{\"algorithm\":\"Suffix Array\",\"mode\":\"build\",\"textLength\":" << n
+         << ",\"indexBytes\":" << header.lcpOffset + (size_t)n * sizeof(int32_t)
+         << ",\"buildSeconds\":" << buildSeconds << "}" << endl;
+    return 0;
+}
+
+int queryIndex(const string& path, const string& mode, const string& pattern, size_t limit) {
+    SuffixIndex index;
+    string error;
+    if (!index.open(path, error)) {
+        cout << "{\"error\":\"" << jsonEscape(error) << "\"}" << endl;
+        return 1;
+    }
+
+    auto start = chrono::steady_clock::now();
+    if (mode == "lrs") {
+        // Longest repeated substring: the largest LCP between adjacent suffixes
+        size_t best = 0, at = 0;
+        for (size_t i = 1; i < index.n; i++) {
+            if ((size_t)index.lcp[i] > best) {
+                best = index.lcp[i];
+                at = i;
+            }
+        }
+        cout << "{\"algorithm\":\"Suffix Array\",\"mode\":\"lrs\",\"length\":" << best;
+        if (best > 0) {
+            cout << ",\"substring\":\"" << jsonEscape(index.text + index.sa[at], best) << "\""
+                 << ",\"offsets\":[" << min(index.sa[at - 1], index.sa[at]) << "," << max(index.sa[at - 1], index.sa[at]) << "]";
+        }
+        cout << "}" << endl;
+        return 0;
+    }
+
+    pair<size_t, size_t> r = index.range(pattern);
+    double micros = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+    size_t count = r.second - r.first;
+    cout << "{\"algorithm\":\"Suffix Array\",\"mode\":\"" << mode << "\",\"pattern\":\"" << jsonEscape(pattern.data(), pattern.size())
+         << "\",\"count\":" << count;
+    if (mode == "find") {
+        vector<int32_t> offsets(index.sa + r.first, index.sa + r.first + min(count, limit));
+        sort(offsets.begin(), offsets.end());
+        cout << ",\"matches\":[";
+        for (size_t i = 0; i < offsets.size(); i++) {
+            if (i > 0) cout << ",";
+            cout << offsets[i];
+        }
+        cout << "],\"truncated\":" << (count > limit ? "true" : "false");
+    }
+    cout << ",\"queryMicros\":" << micros << "}" << endl;
+    return 0;
+}
+
+// Longest common substring of a and b from the suffix array of a#b, where #
+// sorts below every byte and occurs once, so no common prefix can cross it.
+int longestCommonSubstring(const string& a, const string& b) {
+    int n = a.size() + 1 + b.size();
+    vector<int> s(n);
+    for (size_t i = 0; i < a.size(); i++) s[i] = (unsigned char)a[i] + 1;
+    s[a.size()] = 0;
+    for (size_t i = 0; i < b.size(); i++) s[a.size() + 1 + i] = (unsigned char)b[i] + 1;
+
+    vector<int> sa = suffixArray(s, 256);
+    vector<int> lcp = lcpArray(s, n, sa);
+    int split = a.size();
+    int best = 0, at = 0, atB = 0;
+    for (int i = 1; i < n; i++) {
+        bool leftInA = sa[i - 1] < split, rightInA = sa[i] < split;
+        if (leftInA != rightInA && lcp[i] > best) {
+            best = lcp[i];
+            at = leftInA ? sa[i - 1] : sa[i];
+            atB = (leftInA ? sa[i] : sa[i - 1]) - split - 1;
+        }
+    }
+
+    cout << "{\"algorithm\":\"Suffix Array\",\"mode\":\"lcs\",\"length\":" << best
+         << ",\"substring\":\"" << jsonEscape(a.data() + at, best) << "\"";
+    if (best > 0) cout << ",\"offset1\":" << at << ",\"offset2\":" << atB;
+    cout << "}" << endl;
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    ios::sync_with_stdio(false);
+    string mode = argc >= 2 ? argv[1] : "";
+    if (mode == "build" && argc >= 4) return buildIndex(argv[2], argv[3]);
+    if ((mode == "count" || mode == "find") && argc >= 4) {
+        size_t limit = argc >= 5 ? stoull(argv[4]) : 1000;
+        return queryIndex(argv[2], mode, argv[3], limit);
+    }
+    if (mode == "lrs" && argc >= 3) return queryIndex(argv[2], mode, "", 0);
+    if (mode == "lcs" && argc >= 4) return longestCommonSubstring(argv[2], argv[3]);
+
+    cout << "{\"error\":\"Usage: ./SuffixArray build <text file|-> <index file> | count <index> <pattern> | "
+            "find <index> <pattern> [limit] | lrs <index> | lcs <string1> <string2>\"}" << endl;
+    return 1;
+}
@@ -0,0 +1,30 @@
+#ifndef ALGOVISTA_BARRIER_H
+#define ALGOVISTA_BARRIER_H
+
+#include <mutex>
+#include <condition_variable>
+
+// Reusable barrier for worker pools that advance in lock step (wavefront
+// diagonals, DP rows). The generation counter lets the same object be waited
+// on again immediately after it opens.
+class Barrier {
+    std::mutex lock;
+    std::condition_variable cv;
+    unsigned count, waiting = 0, generation = 0;
+
+public:
+    explicit Barrier(unsigned count) : count(count) {}
+    void wait() {
+        std::unique_lock<std::mutex> guard(lock);
+        unsigned gen = generation;
+        if (++waiting == count) {
+            waiting = 0;
+            generation++;
+            cv.notify_all();
+        } else {
+            cv.wait(guard, [&] { return gen != generation; });
+        }
+    }
+};
+
+#endif
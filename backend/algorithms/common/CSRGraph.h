@@ -0,0 +1,154 @@
+#ifndef ALGOVISTA_CSR_GRAPH_H
+#define ALGOVISTA_CSR_GRAPH_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+
+// Compressed sparse row graphs shared by GraphAlgorithms/ and
+// DataStructures/Graph. Vertex ids are 32-bit and the arrays are kept apart
+// (offsets, targets, weights) so a traversal that ignores weights never
+// loads them. A graph is built from an edge list by a two-pass counting
+// sort: count each vertex's out-degree, prefix-sum into offsets, then
+// scatter. The scatter walks the edges in input order, so every vertex
+// lists its neighbours in the order the edges were given.
+
+namespace csr {
+
+struct EdgeList {
+    uint32_t n = 0;
+    std::vector<uint32_t> from, to;
+    std::vector<int32_t> weight;     // parallel to from/to when hasWeights
+    bool hasWeights = false;
+
+    size_t size() const { return from.size(); }
+    bool weighted() const { return hasWeights; }
+};
+
+// Forward keeps u -> v, Reverse stores v -> u (the transpose, for Kosaraju
+// and predecessor scans), Undirected stores both, u -> v first
+enum Orientation { Forward, Reverse, Undirected };
+
+// A cheap handle: the arrays are read through plain pointers so a graph
+// built in memory and one mapped from a graph file (GraphFile.h) look the
+// same to the algorithms. storage keeps whichever backs them alive, and
+// copies share it.
+struct Graph {
+    uint32_t n = 0;
+    uint64_t m = 0;
+    const uint64_t* offsets = nullptr;   // n + 1 entries; v's edges are [offsets[v], offsets[v + 1])
+    const uint32_t* targets = nullptr;
+    const int32_t* weights = nullptr;    // parallel to targets, null when unweighted
+    const double* coords = nullptr;      // x, y per vertex, null when absent
+    bool symmetric = false;              // every edge is stored in both directions
+    std::shared_ptr<const void> storage;
+
+    uint64_t edgeCount() const { return m; }
+    uint32_t degree(uint32_t v) const { return offsets[v + 1] - offsets[v]; }
+    bool weighted() const { return weights != nullptr; }
+};
+
+struct GraphArrays {
+    std::vector<uint64_t> offsets;
+    std::vector<uint32_t> targets;
+    std::vector<int32_t> weights;
+};
+
+inline Graph build(const EdgeList& list, Orientation orientation = Forward) {
+    auto arrays = std::make_shared<GraphArrays>();
+    std::vector<uint64_t>& offsets = arrays->offsets;
+    std::vector<uint32_t>& targets = arrays->targets;
+    std::vector<int32_t>& weights = arrays->weights;
+    uint32_t n = list.n;
+    size_t m = list.size();
+    bool both = orientation == Undirected;
+    const std::vector<uint32_t>& src = orientation == Reverse ? list.to : list.from;
+    const std::vector<uint32_t>& dst = orientation == Reverse ? list.from : list.to;
+
+    // Pass 1: degrees, shifted by one so the prefix sum lands in offsets
+    offsets.assign((size_t)n + 1, 0);
+    for (size_t e = 0; e < m; e++) {
+        offsets[src[e] + 1]++;
+        if (both) offsets[dst[e] + 1]++;
+    }
+    for (uint32_t v = 0; v < n; v++) offsets[v + 1] += offsets[v];
+
+    // Pass 2: scatter through a per-vertex cursor
+    std::vector<uint64_t> cursor(offsets.begin(), offsets.end() - 1);
+    targets.resize(offsets[n]);
+    if (list.weighted()) {
+        weights.reserve(offsets[n] + 1);   // data() stays non-null with no edges
+        weights.resize(offsets[n]);
+    }
+    auto place = [&](uint32_t a, uint32_t b, size_t e) {
+        uint64_t slot = cursor[a]++;
+        targets[slot] = b;
+        if (list.weighted()) weights[slot] = list.weight[e];
+    };
+    for (size_t e = 0; e < m; e++) {
+        place(src[e], dst[e], e);
+        if (both) place(dst[e], src[e], e);
+    }
+
+    Graph g;
+    g.n = n;
+    g.m = offsets[n];
+    g.offsets = offsets.data();
+    g.targets = targets.data();
+    g.weights = list.weighted() ? weights.data() : nullptr;
+    g.symmetric = both;
+    g.storage = arrays;
+    return g;
+}
+
+// Parses the argv edge format "u,v;u,v" or, weighted, "u,v,w;u,v,w" into
+// list (list.n must already be set). Fails on a short record or a vertex
+// id outside [0, n).
+inline bool parseEdges(const std::string& text, bool weighted, EdgeList& list, std::string& error) {
+    if (weighted) list.hasWeights = true;
+    const char* p = text.c_str();
+    const char* end = p + text.size();
+    int fields = weighted ? 3 : 2;
+    while (p < end) {
+        const char* recordEnd = p;
+        while (recordEnd < end && *recordEnd != ';') recordEnd++;
+        long long f[3];
+        int got = 0;
+        const char* q = p;
+        while (q < recordEnd && got < fields) {
+            char* next;
+            long long v = strtoll(q, &next, 10);
+            if (next == q) break;
+            f[got++] = v;
+            q = next;
+            while (q < recordEnd && (*q == ',' || *q == ' ')) q++;
+        }
+        bool blank = true;
+        for (const char* c = p; c < recordEnd; c++) blank = blank && (*c == ' ' || *c == '\n');
+        if (!blank) {
+            if (got < fields) {
+                error = "Malformed edge '" + std::string(p, recordEnd) + "'";
+                return false;
+            }
+            if (f[0] < 0 || f[1] < 0 || f[0] >= list.n || f[1] >= list.n) {
+                error = "Edge '" + std::string(p, recordEnd) + "' names a vertex outside 0.." + std::to_string((long long)list.n - 1);
+                return false;
+            }
+            if (weighted && (f[2] < INT32_MIN || f[2] > INT32_MAX)) {
+                error = "Edge '" + std::string(p, recordEnd) + "' has a weight outside the 32-bit range";
+                return false;
+            }
+            list.from.push_back(f[0]);
+            list.to.push_back(f[1]);
+            if (weighted) list.weight.push_back(f[2]);
+        }
+        p = recordEnd + 1;
+    }
+    return true;
+}
+
+} // namespace csr
+
+#endif
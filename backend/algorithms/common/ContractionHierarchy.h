@@ -0,0 +1,506 @@
+#ifndef ALGOVISTA_CONTRACTION_HIERARCHY_H
+#define ALGOVISTA_CONTRACTION_HIERARCHY_H
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <queue>
+#include <utility>
+#include <functional>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include "GraphFile.h"
+#include "PointToPoint.h"
+
+// Contraction hierarchies. Preprocessing contracts vertices one at a time in
+// order of importance: removing v adds a shortcut u -> x (weight
+// w(u, v) + w(v, x), middle v) unless a witness search from u that avoids v
+// finds a path to x no longer than that. Importance is twice the edge
+// difference (shortcuts added minus edges removed) plus the number of
+// neighbours already contracted plus the vertex's level (one above its
+// highest contracted neighbour), which spreads contractions evenly across
+// the graph. Priorities are re-evaluated lazily: a vertex reaching the front
+// of the queue is simulated again and re-queued if it got more expensive.
+// Witness searches are cut off after a fixed number of settled vertices,
+// which only ever adds shortcuts that were not strictly needed.
+//
+// Each vertex keeps the arcs it had when it was contracted; they all lead
+// to higher-ranked vertices. A query searches upward from s over out-arcs
+// and upward from t over in-arcs, and the best meeting vertex joins them.
+// A shortcut is expanded back into original edges through its middle.
+
+namespace ch {
+
+const uint32_t noVertex = sssp::noVertex;
+const int64_t unreachable = sssp::unreachable;
+
+// Arcs of one direction: up[0] at v holds v -> x, up[1] at v holds x -> v,
+// and in both rank[x] > rank[v]
+struct UpGraph {
+    const uint64_t* offsets = nullptr;
+    const uint32_t* targets = nullptr;
+    const int64_t* weights = nullptr;
+    const uint32_t* middles = nullptr;   // noVertex for an original edge
+    uint64_t m = 0;
+};
+
+struct Hierarchy {
+    uint32_t n = 0;
+    bool symmetric = false;
+    const uint32_t* rank = nullptr;
+    UpGraph up[2];
+    std::shared_ptr<const void> storage;
+};
+
+struct HierarchyArrays {
+    std::vector<uint32_t> rank;
+    std::vector<uint64_t> offsets[2];
+    std::vector<uint32_t> targets[2], middles[2];
+    std::vector<int64_t> weights[2];
+};
+
+struct BuildStats {
+    uint64_t originalArcs = 0, shortcuts = 0, witnessSearches = 0;
+};
+
+class Contractor {
+    struct Arc {
+        uint32_t to, middle;
+        int64_t weight;
+    };
+    struct Shortcut {
+        uint32_t from, to;
+        int64_t weight;
+    };
+
+    uint32_t n;
+    uint32_t settleLimit, simulateLimit;
+    std::vector<std::vector<Arc>> out, in;
+    std::vector<char> contracted;
+    std::vector<uint32_t> deletedNeighbours, level;
+    std::vector<uint32_t> targetRound;   // == round marks a vertex the current search must reach
+    uint32_t round = 0, targetsLeft = 0;
+    sssp::Labels labels;
+    sssp::QuadQueue queue{0};
+    BuildStats& stats;
+
+    // Keeps one arc per (list, endpoint): the lighter one
+    static bool improve(std::vector<Arc>& list, uint32_t to, int64_t weight, uint32_t middle) {
+        for (Arc& a : list) {
+            if (a.to != to) continue;
+            if (weight >= a.weight) return false;
+            a.weight = weight;
+            a.middle = middle;
+            return true;
+        }
+        list.push_back({to, middle, weight});
+        return true;
+    }
+
+    static void erase(std::vector<Arc>& list, uint32_t to) {
+        for (size_t i = 0; i < list.size(); i++) {
+            if (list[i].to == to) {
+                list[i] = list.back();
+                list.pop_back();
+                return;
+            }
+        }
+    }
+
+    // Dijkstra from source over uncontracted vertices except skip, until every
+    // target is settled, the queue passes limit or settleLimit vertices are
+    // settled
+    void witnessSearch(uint32_t source, uint32_t skip, int64_t limit, uint32_t settleLimit) {
+        stats.witnessSearches++;
+        labels.reset();
+        queue.clear();
+        labels.set(source, 0, noVertex);
+        queue.update(source, 0);
+        uint32_t settled = 0;
+        while (!queue.empty()) {
+            int64_t d;
+            uint32_t u;
+            queue.pop(d, u);
+            if (d > labels.dist[u]) continue;
+            if (d > limit || ++settled > settleLimit) break;
+            if (targetRound[u] == round && --targetsLeft == 0) break;
+            for (const Arc& a : out[u]) {
+                if (a.to == skip) continue;
+                int64_t candidate = d + a.weight;
+                if (candidate < labels.dist[a.to]) {
+                    labels.set(a.to, candidate, u);
+                    queue.update(a.to, candidate);
+                }
+            }
+        }
+    }
+
+    // Simulated contractions (for priorities) use a tighter settle limit;
+    // a missed witness there only makes v look a little less attractive
+    void shortcutsFor(uint32_t v, std::vector<Shortcut>& shortcuts, uint32_t settleLimit) {
+        shortcuts.clear();
+        int64_t longestOut = 0;
+        for (const Arc& b : out[v]) longestOut = std::max(longestOut, b.weight);
+        for (const Arc& a : in[v]) {
+            if (++round == 0) {
+                std::fill(targetRound.begin(), targetRound.end(), 0);
+                round = 1;
+            }
+            targetsLeft = 0;
+            for (const Arc& b : out[v]) {
+                if (b.to != a.to && targetRound[b.to] != round) {
+                    targetRound[b.to] = round;
+                    targetsLeft++;
+                }
+            }
+            if (targetsLeft == 0) continue;
+            witnessSearch(a.to, v, a.weight + longestOut, settleLimit);
+            for (const Arc& b : out[v]) {
+                if (b.to == a.to) continue;
+                int64_t through = a.weight + b.weight;
+                if (labels.dist[b.to] > through) shortcuts.push_back({a.to, b.to, through});
+            }
+        }
+    }
+
+    int64_t priority(uint32_t v, std::vector<Shortcut>& scratch) {
+        shortcutsFor(v, scratch, simulateLimit);
+        int64_t difference = (int64_t)scratch.size() - (int64_t)(in[v].size() + out[v].size());
+        return 2 * difference + deletedNeighbours[v] + level[v];
+    }
+
+public:
+    Contractor(const csr::Graph& g, uint32_t settleLimit, BuildStats& stats)
+        : n(g.n), settleLimit(settleLimit), simulateLimit(std::min<uint32_t>(settleLimit, 25)), out(g.n), in(g.n),
+          contracted(g.n, 0), deletedNeighbours(g.n, 0), level(g.n, 0), targetRound(g.n, 0), labels(g.n), stats(stats) {
+        for (uint32_t u = 0; u < n; u++) {
+            for (uint64_t e = g.offsets[u]; e < g.offsets[u + 1]; e++) {
+                uint32_t v = g.targets[e];
+                if (v == u) continue;
+                if (improve(out[u], v, g.weights[e], noVertex)) improve(in[v], u, g.weights[e], noVertex);
+            }
+        }
+        for (uint32_t u = 0; u < n; u++) stats.originalArcs += out[u].size();
+    }
+
+    Hierarchy run(bool symmetric) {
+        auto arrays = std::make_shared<HierarchyArrays>();
+        std::vector<std::vector<Arc>> up[2] = {std::vector<std::vector<Arc>>(n), std::vector<std::vector<Arc>>(n)};
+        arrays->rank.assign(n, 0);
+        std::vector<int64_t> current(n);
+        std::vector<Shortcut> shortcuts;
+        std::vector<uint32_t> neighbours;
+        typedef std::pair<int64_t, uint32_t> Entry;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> order;
+        for (uint32_t v = 0; v < n; v++) {
+            current[v] = priority(v, shortcuts);
+            order.push({current[v], v});
+        }
+
+        uint32_t next = 0;
+        while (!order.empty()) {
+            Entry top = order.top();
+            order.pop();
+            uint32_t v = top.second;
+            if (contracted[v] || top.first != current[v]) continue;
+            int64_t fresh = priority(v, shortcuts);
+            if (fresh != current[v]) {
+                current[v] = fresh;
+                order.push({fresh, v});
+                continue;
+            }
+
+            shortcutsFor(v, shortcuts, settleLimit);
+            arrays->rank[v] = next++;
+            contracted[v] = 1;
+            up[0][v] = std::move(out[v]);
+            up[1][v] = std::move(in[v]);
+            for (const Arc& a : up[0][v]) erase(in[a.to], v);
+            for (const Arc& a : up[1][v]) erase(out[a.to], v);
+            for (const Shortcut& s : shortcuts) {
+                if (!improve(out[s.from], s.to, s.weight, v)) continue;
+                improve(in[s.to], s.from, s.weight, v);
+                stats.shortcuts++;
+            }
+            neighbours.clear();
+            for (int side = 0; side < 2; side++) {
+                for (const Arc& a : up[side][v]) neighbours.push_back(a.to);
+            }
+            std::sort(neighbours.begin(), neighbours.end());
+            neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+            for (uint32_t x : neighbours) {
+                deletedNeighbours[x]++;
+                level[x] = std::max(level[x], level[v] + 1);
+            }
+        }
+
+        Hierarchy h;
+        h.n = n;
+        h.symmetric = symmetric;
+        h.rank = arrays->rank.data();
+        for (int side = 0; side < 2; side++) {
+            std::vector<uint64_t>& offsets = arrays->offsets[side];
+            offsets.assign((size_t)n + 1, 0);
+            for (uint32_t v = 0; v < n; v++) offsets[v + 1] = offsets[v] + up[side][v].size();
+            for (uint32_t v = 0; v < n; v++) {
+                for (const Arc& a : up[side][v]) {
+                    arrays->targets[side].push_back(a.to);
+                    arrays->weights[side].push_back(a.weight);
+                    arrays->middles[side].push_back(a.middle);
+                }
+            }
+            h.up[side].offsets = offsets.data();
+            h.up[side].targets = arrays->targets[side].data();
+            h.up[side].weights = arrays->weights[side].data();
+            h.up[side].middles = arrays->middles[side].data();
+            h.up[side].m = offsets[n];
+        }
+        h.storage = arrays;
+        return h;
+    }
+};
+
+// Weights must be non-negative; self-loops are dropped and parallel arcs
+// collapse to the lightest
+inline Hierarchy build(const csr::Graph& g, BuildStats& stats, uint32_t settleLimit = 1000) {
+    Contractor contractor(g, settleLimit, stats);
+    return contractor.run(g.symmetric);
+}
+
+// Hierarchy files are mapped like graph files (sections 8-byte aligned):
+//   HierarchyHeader  128 bytes
+//   rank             uint32 x n
+//   then per direction (out-arcs, in-arcs): offsets uint64 x (n + 1),
+//   targets uint32 x m, weights int64 x m, middles uint32 x m
+struct HierarchyHeader {
+    char magic[8];          // "AVCHIER\0"
+    uint32_t version;
+    uint32_t flags;         // csr::Symmetric
+    uint64_t vertices;
+    uint64_t rankAt;
+    uint64_t arcs[2], offsetsAt[2], targetsAt[2], weightsAt[2], middlesAt[2];
+    uint64_t reserved[2];
+};
+static_assert(sizeof(HierarchyHeader) == 128, "hierarchy header must stay 128 bytes");
+
+const char hierarchyMagic[8] = {'A', 'V', 'C', 'H', 'I', 'E', 'R', '\0'};
+
+inline bool save(const Hierarchy& h, const std::string& path, std::string& error) {
+    HierarchyHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, hierarchyMagic, sizeof(header.magic));
+    header.version = 1;
+    header.flags = h.symmetric ? (uint32_t)csr::Symmetric : 0u;
+    header.vertices = h.n;
+    auto align = [](uint64_t at) { return (at + 7) & ~(uint64_t)7; };
+    uint64_t at = sizeof(header);
+    header.rankAt = at;
+    at = align(at + (uint64_t)h.n * 4);
+    for (int side = 0; side < 2; side++) {
+        header.arcs[side] = h.up[side].m;
+        header.offsetsAt[side] = at;
+        at = align(at + ((uint64_t)h.n + 1) * 8);
+        header.targetsAt[side] = at;
+        at = align(at + h.up[side].m * 4);
+        header.weightsAt[side] = at;
+        at = align(at + h.up[side].m * 8);
+        header.middlesAt[side] = at;
+        at = align(at + h.up[side].m * 4);
+    }
+
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file) {
+        error = "Cannot create " + path + ": " + strerror(errno);
+        return false;
+    }
+    uint64_t written = 0;
+    bool ok = true;
+    auto put = [&](uint64_t sectionAt, const void* data, uint64_t bytes) {
+        static const char zeros[8] = {0};
+        if (ok && written < sectionAt) ok = fwrite(zeros, 1, sectionAt - written, file) == sectionAt - written;
+        if (ok && bytes) ok = fwrite(data, 1, bytes, file) == bytes;
+        written = sectionAt + bytes;
+    };
+    put(0, &header, sizeof(header));
+    put(header.rankAt, h.rank, (uint64_t)h.n * 4);
+    for (int side = 0; side < 2; side++) {
+        put(header.offsetsAt[side], h.up[side].offsets, ((uint64_t)h.n + 1) * 8);
+        put(header.targetsAt[side], h.up[side].targets, h.up[side].m * 4);
+        put(header.weightsAt[side], h.up[side].weights, h.up[side].m * 8);
+        put(header.middlesAt[side], h.up[side].middles, h.up[side].m * 4);
+    }
+    if (fclose(file) != 0) ok = false;
+    if (!ok) error = "Cannot write " + path + ": " + strerror(errno);
+    return ok;
+}
+
+inline bool load(const std::string& path, Hierarchy& h, std::string& error) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error = "Cannot open " + path + ": " + strerror(errno);
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (uint64_t)st.st_size < sizeof(HierarchyHeader)) {
+        error = path + " is not a hierarchy file";
+        close(fd);
+        return false;
+    }
+    auto mapping = std::make_shared<csr::FileMapping>();
+    mapping->addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping->addr == MAP_FAILED) {
+        mapping->addr = nullptr;
+        error = "Cannot map " + path + ": " + strerror(errno);
+        return false;
+    }
+    uint64_t size = mapping->size = st.st_size;
+    const char* base = static_cast<const char*>(mapping->addr);
+    HierarchyHeader header;
+    memcpy(&header, base, sizeof(header));
+    if (memcmp(header.magic, hierarchyMagic, sizeof(header.magic)) != 0 || header.version != 1) {
+        error = path + " is not a version 1 hierarchy file";
+        return false;
+    }
+    auto fits = [&](uint64_t at, uint64_t count, uint64_t width) {
+        return at % 8 == 0 && at >= sizeof(header) && at <= size && count <= (size - at) / width;
+    };
+    bool ok = header.vertices <= INT32_MAX && fits(header.rankAt, header.vertices, 4);
+    for (int side = 0; side < 2 && ok; side++) {
+        ok = fits(header.offsetsAt[side], header.vertices + 1, 8) && fits(header.targetsAt[side], header.arcs[side], 4) &&
+             fits(header.weightsAt[side], header.arcs[side], 8) && fits(header.middlesAt[side], header.arcs[side], 4);
+    }
+    if (!ok) {
+        error = path + " is truncated or has a corrupt header";
+        return false;
+    }
+    h = Hierarchy();
+    h.n = header.vertices;
+    h.symmetric = header.flags & csr::Symmetric;
+    h.rank = reinterpret_cast<const uint32_t*>(base + header.rankAt);
+    for (int side = 0; side < 2; side++) {
+        h.up[side].offsets = reinterpret_cast<const uint64_t*>(base + header.offsetsAt[side]);
+        h.up[side].targets = reinterpret_cast<const uint32_t*>(base + header.targetsAt[side]);
+        h.up[side].weights = reinterpret_cast<const int64_t*>(base + header.weightsAt[side]);
+        h.up[side].middles = reinterpret_cast<const uint32_t*>(base + header.middlesAt[side]);
+        h.up[side].m = header.arcs[side];
+        if (h.up[side].offsets[0] != 0 || h.up[side].offsets[h.n] != h.up[side].m) {
+            error = path + " has inconsistent offsets";
+            return false;
+        }
+    }
+    h.storage = mapping;
+    return true;
+}
+
+// Upward bidirectional search. Both sides run until their queue minimum
+// reaches the best meeting distance. A vertex is stalled (not expanded)
+// when a higher neighbour already proves its label is not a shortest
+// distance, which prunes most of the upward search space.
+class Query {
+    sssp::Labels labels[2];
+    sssp::QuadQueue queues[2] = {sssp::QuadQueue(0), sssp::QuadQueue(0)};
+
+    // The stored arc from -> to and its middle vertex
+    bool arc(const Hierarchy& h, uint32_t from, uint32_t to, uint32_t& middle) const {
+        int side = h.rank[from] < h.rank[to] ? 0 : 1;
+        uint32_t at = side == 0 ? from : to, other = side == 0 ? to : from;
+        const UpGraph& g = h.up[side];
+        for (uint64_t e = g.offsets[at]; e < g.offsets[at + 1]; e++) {
+            if (g.targets[e] == other) {
+                middle = g.middles[e];
+                return true;
+            }
+        }
+        return false;
+    }
+
+public:
+    uint64_t settled = 0, stalled = 0;
+
+    explicit Query(uint32_t n) : labels{sssp::Labels(n), sssp::Labels(n)} {}
+
+    sssp::Route run(const Hierarchy& h, uint32_t source, uint32_t target, bool withPath = true) {
+        sssp::Route route;
+        settled = stalled = 0;
+        for (int side = 0; side < 2; side++) {
+            labels[side].reset();
+            queues[side].clear();
+        }
+        labels[0].set(source, 0, noVertex);
+        labels[1].set(target, 0, noVertex);
+        queues[0].update(source, 0);
+        queues[1].update(target, 0);
+        int64_t best = unreachable;
+        uint32_t meet = noVertex;
+
+        for (;;) {
+            bool open[2];
+            for (int side = 0; side < 2; side++) open[side] = !queues[side].empty() && queues[side].topKey() < best;
+            if (!open[0] && !open[1]) break;
+            int side = !open[0] ? 1 : !open[1] ? 0 : queues[0].topKey() <= queues[1].topKey() ? 0 : 1;
+            sssp::Labels& mine = labels[side];
+            int64_t d;
+            uint32_t u;
+            queues[side].pop(d, u);
+            if (d > mine.dist[u]) continue;
+            settled++;
+            const sssp::Labels& other = labels[1 - side];
+            if (other.dist[u] != unreachable && d + other.dist[u] < best) {
+                best = d + other.dist[u];
+                meet = u;
+            }
+
+            const UpGraph& down = h.up[1 - side];
+            bool stall = false;
+            for (uint64_t e = down.offsets[u]; e < down.offsets[u + 1] && !stall; e++) {
+                uint32_t x = down.targets[e];
+                stall = mine.dist[x] != unreachable && mine.dist[x] + down.weights[e] < d;
+            }
+            if (stall) {
+                stalled++;
+                continue;
+            }
+            const UpGraph& g = h.up[side];
+            for (uint64_t e = g.offsets[u]; e < g.offsets[u + 1]; e++) {
+                uint32_t x = g.targets[e];
+                int64_t candidate = d + g.weights[e];
+                if (candidate < mine.dist[x]) {
+                    mine.set(x, candidate, u);
+                    queues[side].update(x, candidate);
+                }
+            }
+        }
+
+        route.settled = settled;
+        if (meet == noVertex) return route;
+        route.distance = best;
+        if (!withPath) return route;
+
+        // Up-path s .. meet, then meet .. t down the backward labels, with
+        // every hierarchy arc expanded through its middles
+        std::vector<uint32_t> hops = labels[0].chain(meet);
+        for (uint32_t v = labels[1].pred[meet]; v != noVertex; v = labels[1].pred[v]) hops.push_back(v);
+        route.path.push_back(source);
+        std::vector<std::pair<uint32_t, uint32_t>> stack;
+        for (size_t i = hops.size(); i-- > 1;) stack.push_back({hops[i - 1], hops[i]});
+        while (!stack.empty()) {
+            std::pair<uint32_t, uint32_t> hop = stack.back();
+            stack.pop_back();
+            uint32_t middle = noVertex;
+            arc(h, hop.first, hop.second, middle);
+            if (middle == noVertex) {
+                route.path.push_back(hop.second);
+            } else {
+                stack.push_back({middle, hop.second});
+                stack.push_back({hop.first, middle});
+            }
+        }
+        return route;
+    }
+};
+
+} // namespace ch
+
+#endif
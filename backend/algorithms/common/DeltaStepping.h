@@ -0,0 +1,221 @@
+#ifndef ALGOVISTA_DELTA_STEPPING_H
+#define ALGOVISTA_DELTA_STEPPING_H
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include "CSRGraph.h"
+#include "Barrier.h"
+#include "ShortestPath.h"
+
+// Parallel delta-stepping (Meyer & Sanders) over csr::Graph with
+// non-negative weights. Tentative distances are grouped into buckets of
+// width delta and buckets are settled in order. Inside a bucket only light
+// edges (weight < delta) can re-insert into the same bucket, so they are
+// relaxed in rounds until the bucket stays empty; heavy edges of everything
+// the bucket settled are relaxed once afterwards. Each round is spread over
+// all threads in chunks, distances drop through an atomic min, and every
+// thread files the vertices it improved into its own buckets, so no lock is
+// taken anywhere. Final distances equal Dijkstra's.
+
+namespace sssp {
+
+struct DeltaStats {
+    int64_t delta = 0;
+    uint64_t buckets = 0, rounds = 0, expansions = 0, relaxations = 0, improvements = 0;
+};
+
+// Bucket width from the weight distribution: about the mean weight divided
+// by the square root of the average degree, so a round touches enough
+// vertices to share out without re-relaxing much of the next bucket early
+inline int64_t chooseDelta(const csr::Graph& g) {
+    if (g.n == 0 || g.m == 0) return 1;
+    double sum = 0;
+    for (uint64_t e = 0; e < g.m; e++) sum += g.weights[e];
+    double mean = sum / g.m, degree = (double)g.m / g.n;
+    return std::max<int64_t>(1, (int64_t)(mean / std::sqrt(std::max(degree, 1.0))));
+}
+
+class DeltaStepping {
+    struct alignas(64) Worker {
+        std::vector<std::vector<uint32_t>> buckets;   // cyclic, by bucket number % slots
+        std::vector<uint32_t> current, settled;
+        uint64_t expansions = 0, relaxations = 0, improvements = 0;
+    };
+
+    const csr::Graph& g;
+    int64_t delta;
+    unsigned threads;
+    uint64_t slots;
+    // Edges of every vertex reordered light-first; offsets stay g.offsets
+    std::vector<uint32_t> targets;
+    std::vector<int32_t> weights;
+    std::vector<uint64_t> lightEnd;
+    std::unique_ptr<std::atomic<int64_t>[]> dist, expanded;
+    std::vector<Worker> workers;
+    std::atomic<size_t> cursor{0};
+
+    template <typename Body>
+    void parallel(Body body) {
+        std::vector<std::thread> pool;
+        for (unsigned t = 1; t < threads; t++) pool.emplace_back(body, t);
+        body(0);
+        for (std::thread& th : pool) th.join();
+    }
+
+    void relax(Worker& me, uint32_t v, int64_t candidate) {
+        me.relaxations++;
+        int64_t old = dist[v].load(std::memory_order_relaxed);
+        while (candidate < old) {
+            if (dist[v].compare_exchange_weak(old, candidate, std::memory_order_relaxed)) {
+                me.improvements++;
+                me.buckets[(uint64_t)(candidate / delta) % slots].push_back(v);
+                return;
+            }
+        }
+    }
+
+    // Light edges of u, unless u belongs to an earlier bucket (an outdated
+    // entry) or was already expanded at its current distance
+    void expand(Worker& me, uint32_t u, uint64_t bucket) {
+        int64_t d = dist[u].load(std::memory_order_relaxed);
+        if (d < (int64_t)bucket * delta) return;
+        int64_t before = expanded[u].exchange(d, std::memory_order_relaxed);
+        if (before == d) return;
+        if (before == unreachable) me.settled.push_back(u);
+        me.expansions++;
+        for (uint64_t e = g.offsets[u]; e < lightEnd[u]; e++) relax(me, targets[e], d + weights[e]);
+    }
+
+    void work(unsigned t, Barrier& barrier) {
+        Worker& me = workers[t];
+        std::vector<size_t> prefix(threads + 1, 0);
+        auto measure = [&] {
+            for (unsigned i = 0; i < threads; i++) prefix[i + 1] = prefix[i] + workers[i].current.size();
+        };
+        const size_t chunk = 256;
+        uint64_t bucket = 0;
+        measure();
+        for (;;) {
+            // One light round over the union of every worker's current list
+            for (;;) {
+                size_t begin = cursor.fetch_add(chunk, std::memory_order_relaxed);
+                if (begin >= prefix[threads]) break;
+                size_t end = std::min(begin + chunk, prefix[threads]);
+                unsigned owner = std::upper_bound(prefix.begin(), prefix.end(), begin) - prefix.begin() - 1;
+                for (size_t i = begin; i < end; i++) {
+                    while (i >= prefix[owner + 1]) owner++;
+                    expand(me, workers[owner].current[i - prefix[owner]], bucket);
+                }
+            }
+            barrier.wait();
+
+            // Nothing new in this bucket: it is settled, so relax heavy edges
+            // and move on to the first non-empty bucket. Heavy edges never
+            // land in the current slot and the light ones never reach past
+            // slots - 1 buckets ahead, so the scan is over one cycle.
+            uint64_t slot = bucket % slots, next = bucket;
+            size_t waiting = 0;
+            for (unsigned i = 0; i < threads; i++) waiting += workers[i].buckets[slot].size();
+            if (waiting == 0) {
+                for (uint32_t u : me.settled) {
+                    int64_t d = dist[u].load(std::memory_order_relaxed);
+                    for (uint64_t e = lightEnd[u]; e < g.offsets[u + 1]; e++) relax(me, targets[e], d + weights[e]);
+                }
+                me.settled.clear();
+                barrier.wait();
+                next = UINT64_MAX;
+                for (uint64_t step = 1; step < slots && next == UINT64_MAX; step++) {
+                    for (unsigned i = 0; i < threads; i++) {
+                        if (!workers[i].buckets[(bucket + step) % slots].empty()) next = bucket + step;
+                    }
+                }
+                if (next == UINT64_MAX) break;
+            }
+            barrier.wait();
+            if (t == 0) {
+                cursor.store(0, std::memory_order_relaxed);
+                stats.rounds++;
+                if (next != bucket) stats.buckets++;
+            }
+            me.current.clear();
+            std::swap(me.current, me.buckets[next % slots]);
+            barrier.wait();
+            measure();
+            bucket = next;
+        }
+    }
+
+public:
+    DeltaStats stats;
+
+    // delta <= 0 picks one with chooseDelta
+    DeltaStepping(const csr::Graph& graph, int64_t delta, unsigned threads)
+        : g(graph), delta(delta > 0 ? delta : chooseDelta(graph)), threads(std::max(1u, threads)), targets(graph.m),
+          weights(graph.m), lightEnd(graph.n), dist(new std::atomic<int64_t>[graph.n]),
+          expanded(new std::atomic<int64_t>[graph.n]), workers(this->threads) {
+        int64_t heaviest = 0;
+        for (uint64_t e = 0; e < g.m; e++) heaviest = std::max<int64_t>(heaviest, g.weights[e]);
+        // Bound the ring at 2^20 slots; a tiny delta on heavy weights only
+        // gets rounded up
+        this->delta = std::max(this->delta, (heaviest >> 20) + 1);
+        slots = heaviest / this->delta + 2;
+        for (Worker& w : workers) w.buckets.resize(slots);
+        parallel([&](unsigned t) {
+            uint64_t from = (uint64_t)g.n * t / this->threads, to = (uint64_t)g.n * (t + 1) / this->threads;
+            for (uint64_t u = from; u < to; u++) {
+                uint64_t at = g.offsets[u];
+                for (int heavy = 0; heavy < 2; heavy++) {
+                    for (uint64_t e = g.offsets[u]; e < g.offsets[u + 1]; e++) {
+                        if ((g.weights[e] >= this->delta) != (bool)heavy) continue;
+                        targets[at] = g.targets[e];
+                        weights[at++] = g.weights[e];
+                    }
+                    if (!heavy) lightEnd[u] = at;
+                }
+            }
+        });
+    }
+
+    int64_t bucketWidth() const { return delta; }
+
+    void run(uint32_t source, std::vector<int64_t>& out) {
+        stats = DeltaStats();
+        stats.delta = delta;
+        parallel([&](unsigned t) {
+            uint64_t from = (uint64_t)g.n * t / threads, to = (uint64_t)g.n * (t + 1) / threads;
+            for (uint64_t v = from; v < to; v++) {
+                dist[v].store(unreachable, std::memory_order_relaxed);
+                expanded[v].store(unreachable, std::memory_order_relaxed);
+            }
+        });
+        for (Worker& w : workers) {
+            for (auto& b : w.buckets) b.clear();
+            w.current.clear();
+            w.settled.clear();
+            w.expansions = w.relaxations = w.improvements = 0;
+        }
+        dist[source].store(0, std::memory_order_relaxed);
+        workers[0].current.push_back(source);
+        cursor.store(0);
+        stats.buckets = stats.rounds = 1;
+        Barrier barrier(threads);
+        parallel([&](unsigned t) { work(t, barrier); });
+
+        out.resize(g.n);
+        for (uint32_t v = 0; v < g.n; v++) out[v] = dist[v].load(std::memory_order_relaxed);
+        for (const Worker& w : workers) {
+            stats.expansions += w.expansions;
+            stats.relaxations += w.relaxations;
+            stats.improvements += w.improvements;
+        }
+    }
+};
+
+} // namespace sssp
+
+#endif
@@ -0,0 +1,189 @@
+#ifndef ALGOVISTA_FAST_SEARCH_H
+#define ALGOVISTA_FAST_SEARCH_H
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <cstring>
+#include <cstdint>
+#include <iostream>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// Single-pattern search that filters candidates with vector compares: a
+// window can only match if its first byte equals pattern[0] and its last byte
+// equals pattern[m-1], so both bytes are tested for a whole block of windows
+// at once and only the survivors are verified with memcmp. Inputs that keep
+// producing false candidates (e.g. "aaaabaaaa" in "aaaa...") would make that
+// O(n*m), so once verification work exceeds a linear budget the rest of the
+// text is handed to KMP, keeping the worst case O(n + m).
+
+namespace fastsearch {
+
+// Bit i of the returned mask is set if a[i] == x and b[i] == y. BLOCK bytes.
+#if defined(__AVX2__)
+const size_t BLOCK = 32;
+inline uint64_t candidates(const char* a, const char* b, char x, char y) {
+    __m256i ea = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)a), _mm256_set1_epi8(x));
+    __m256i eb = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)b), _mm256_set1_epi8(y));
+    return (uint32_t)_mm256_movemask_epi8(_mm256_and_si256(ea, eb));
+}
+#elif defined(__SSE2__)
+const size_t BLOCK = 32;
+inline uint64_t candidates(const char* a, const char* b, char x, char y) {
+    __m128i vx = _mm_set1_epi8(x), vy = _mm_set1_epi8(y);
+    __m128i lo = _mm_and_si128(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)a), vx),
+                               _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)b), vy));
+    __m128i hi = _mm_and_si128(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(a + 16)), vx),
+                               _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(b + 16)), vy));
+    return (uint32_t)_mm_movemask_epi8(lo) | ((uint64_t)(uint32_t)_mm_movemask_epi8(hi) << 16);
+}
+#elif defined(__ARM_NEON)
+const size_t BLOCK = 16;
+inline uint64_t candidates(const char* a, const char* b, char x, char y) {
+    uint8x16_t eq = vandq_u8(vceqq_u8(vld1q_u8((const uint8_t*)a), vdupq_n_u8(x)),
+                             vceqq_u8(vld1q_u8((const uint8_t*)b), vdupq_n_u8(y)));
+    // Narrow to 4 bits per byte, then keep one bit of each nibble
+    uint64_t nibbles = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+    uint64_t mask = 0;
+    for (int i = 0; nibbles; i++, nibbles >>= 4) {
+        if (nibbles & 1) mask |= 1ULL << i;
+    }
+    return mask;
+}
+#else
+const size_t BLOCK = 8;
+inline uint64_t candidates(const char* a, const char* b, char x, char y) {
+    uint64_t mask = 0;
+    for (size_t i = 0; i < BLOCK; i++) {
+        if (a[i] == x && b[i] == y) mask |= 1ULL << i;
+    }
+    return mask;
+}
+#endif
+
+template <typename OnMatch>
+void kmpFrom(const char* text, size_t n, const std::string& pattern, size_t from, size_t base, OnMatch onMatch) {
+    size_t m = pattern.size();
+    std::vector<size_t> lps(m, 0);
+    for (size_t i = 1, len = 0; i < m; ) {
+        if (pattern[i] == pattern[len]) lps[i++] = ++len;
+        else if (len) len = lps[len - 1];
+        else lps[i++] = 0;
+    }
+    size_t j = 0;
+    for (size_t i = from; i < n; i++) {
+        while (j > 0 && text[i] != pattern[j]) j = lps[j - 1];
+        if (text[i] == pattern[j]) j++;
+        if (j == m) {
+            onMatch(base + i + 1 - m);
+            j = lps[j - 1];
+        }
+    }
+}
+
+struct FastStats {
+    size_t candidates = 0;
+    size_t verified = 0;
+    bool fellBack = false;
+};
+
+// Calls onMatch(base + i) for every occurrence of pattern starting at text[i]
+template <typename OnMatch>
+void search(const char* text, size_t n, const std::string& pattern, size_t base, OnMatch onMatch, FastStats* stats = nullptr) {
+    size_t m = pattern.size();
+    if (m == 0 || m > n) return;
+    const char* p = pattern.data();
+
+    if (m == 1) {
+        for (const char* at = text; (at = (const char*)memchr(at, p[0], text + n - at)) != nullptr; at++) {
+            onMatch(base + (at - text));
+        }
+        return;
+    }
+
+    char first = p[0], last = p[m - 1];
+    size_t work = 0;
+    size_t i = 0;
+    for (; i + m - 1 + BLOCK <= n; i += BLOCK) {
+        uint64_t mask = candidates(text + i, text + i + m - 1, first, last);
+        while (mask) {
+            size_t pos = i + __builtin_ctzll(mask);
+            mask &= mask - 1;
+            work += m;
+            if (stats) stats->candidates++;
+            if (memcmp(text + pos + 1, p + 1, m - 2) == 0) {
+                if (stats) stats->verified++;
+                onMatch(base + pos);
+            }
+        }
+        if (work > 8 * (i + BLOCK) + 64 * m) {
+            if (stats) stats->fellBack = true;
+            kmpFrom(text, n, pattern, i + BLOCK, base, onMatch);
+            return;
+        }
+    }
+    for (; i + m <= n; i++) {
+        if (text[i] == first && text[i + m - 1] == last && memcmp(text + i + 1, p + 1, m - 2) == 0) {
+            onMatch(base + i);
+        }
+    }
+}
+
+// Compare a baseline matcher (the binary's own algorithm) against search() on
+// random text, DNA-like text and an adversarial periodic input.
+template <typename Baseline>
+void benchmark(const std::string& name, size_t megabytes, Baseline baseline) {
+    using namespace std;
+    size_t n = megabytes << 20;
+    mt19937 rng(11);
+
+    struct Case { string label; string text; string pattern; };
+    vector<Case> cases(3);
+    cases[0].label = "random-letters";
+    cases[0].text.resize(n);
+    for (char& c : cases[0].text) c = 'a' + rng() % 26;
+    cases[0].pattern = cases[0].text.substr(n / 2, 12);
+    cases[1].label = "dna";
+    cases[1].text.resize(n);
+    for (char& c : cases[1].text) c = "acgt"[rng() & 3];
+    cases[1].pattern = cases[1].text.substr(n / 3, 16);
+    cases[2].label = "adversarial";
+    cases[2].text.assign(n, 'a');
+    cases[2].pattern = string(8, 'a') + "b" + string(7, 'a');
+
+    cout << "{\"algorithm\":\"" << name << "\",\"mode\":\"fast-benchmark\",\"bytes\":" << n
+         << ",\"vectorBlock\":" << BLOCK << ",\"results\":[";
+    for (size_t c = 0; c < cases.size(); c++) {
+        const Case& k = cases[c];
+        size_t baseCount = 0, fastCount = 0;
+        auto t0 = chrono::steady_clock::now();
+        baseline(k.text.data(), k.text.size(), k.pattern, [&](size_t) { baseCount++; });
+        auto t1 = chrono::steady_clock::now();
+        FastStats stats;
+        search(k.text.data(), k.text.size(), k.pattern, 0, [&](size_t) { fastCount++; }, &stats);
+        auto t2 = chrono::steady_clock::now();
+        double baseSec = chrono::duration<double>(t1 - t0).count();
+        double fastSec = chrono::duration<double>(t2 - t1).count();
+        if (c > 0) cout << ",";
+        cout << "{\"case\":\"" << k.label << "\",\"patternLength\":" << k.pattern.size()
+             << ",\"baselineSeconds\":" << baseSec << ",\"fastSeconds\":" << fastSec
+             << ",\"baselineGbPerSec\":" << n / baseSec / 1e9 << ",\"fastGbPerSec\":" << n / fastSec / 1e9
+             << ",\"speedup\":" << baseSec / fastSec
+             << ",\"candidates\":" << stats.candidates << ",\"fellBackToKmp\":" << (stats.fellBack ? "true" : "false")
+             << ",\"totalMatches\":" << fastCount
+             << ",\"consistent\":" << (baseCount == fastCount ? "true" : "false") << "}";
+    }
+    cout << "]}" << endl;
+}
+
+} // namespace fastsearch
+
+#endif
@@ -0,0 +1,87 @@
+#ifndef ALGOVISTA_INTERVAL_SCHEDULE_H
+#define ALGOVISTA_INTERVAL_SCHEDULE_H
+
+#include <vector>
+#include <queue>
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+
+// Interval scheduling shared by JobScheduling and ActivitySelection. An
+// interval occupies [start, finish); two intervals are compatible when one
+// finishes no later than the other starts.
+
+namespace intervals {
+
+struct Interval {
+    long long start, finish, weight;
+    long long id;
+};
+
+inline bool byFinish(const Interval& a, const Interval& b) {
+    if (a.finish != b.finish) return a.finish < b.finish;
+    return a.start < b.start;
+}
+
+// Weighted interval scheduling. After sorting by finish, p(j) is the number of
+// intervals finishing by start_j (binary search), and
+//   best[j] = max(best[j - 1], weight_j + best[p(j)]).
+// Sorts items in place; chosen receives positions into the sorted items in
+// finish order. Only best[] is stored: p(j) is searched again on the way back.
+inline long long weightedSchedule(std::vector<Interval>& items, std::vector<size_t>& chosen) {
+    std::stable_sort(items.begin(), items.end(), byFinish);
+    size_t n = items.size();
+    std::vector<long long> finish(n), best(n + 1, 0);
+    for (size_t j = 0; j < n; j++) finish[j] = items[j].finish;
+    auto predecessor = [&](size_t j) {
+        return (size_t)(std::upper_bound(finish.begin(), finish.begin() + j, items[j].start) - finish.begin());
+    };
+    for (size_t j = 0; j < n; j++) best[j + 1] = std::max(best[j], items[j].weight + best[predecessor(j)]);
+
+    chosen.clear();
+    for (size_t j = n; j > 0;) {
+        size_t p = predecessor(j - 1);
+        if (items[j - 1].weight + best[p] > best[j - 1]) {
+            chosen.push_back(j - 1);
+            j = p;
+        } else {
+            j--;
+        }
+    }
+    std::reverse(chosen.begin(), chosen.end());
+    return best[n];
+}
+
+// Interval partitioning: the fewest rooms such that no room holds two
+// overlapping intervals. Sweep by start; a min-heap of (finish, room) hands
+// the room that frees up first to the next interval if it is free by then,
+// otherwise a new room opens. room[i] is the room of items[i].
+inline size_t assignRooms(const std::vector<Interval>& items, std::vector<uint32_t>& room) {
+    size_t n = items.size();
+    std::vector<uint32_t> order(n);
+    for (size_t i = 0; i < n; i++) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        if (items[a].start != items[b].start) return items[a].start < items[b].start;
+        return items[a].finish < items[b].finish;
+    });
+    typedef std::pair<long long, uint32_t> Busy;
+    std::priority_queue<Busy, std::vector<Busy>, std::greater<Busy>> busy;
+    room.assign(n, 0);
+    uint32_t rooms = 0;
+    for (uint32_t i : order) {
+        if (!busy.empty() && busy.top().first <= items[i].start) {
+            room[i] = busy.top().second;
+            busy.pop();
+        } else {
+            room[i] = rooms++;
+        }
+        busy.push({items[i].finish, room[i]});
+    }
+    return rooms;
+}
+
+} // namespace intervals
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef ALGOVISTA_NUMBER_STREAM_H
+#define ALGOVISTA_NUMBER_STREAM_H
+
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cerrno>
+#include <cstdio>
+
+// Buffered integer reader for record files too large for argv (job and
+// interval batches with millions of rows). Reads a file, or stdin for "-",
+// through a fixed buffer; anything that is not a digit or a leading '-'
+// separates numbers, so "1,2,3", "1 2 3" and one-record-per-line all parse.
+
+class NumberStream {
+    FILE* file = nullptr;
+    bool owned = false;
+    std::vector<char> buffer = std::vector<char>(1 << 16);
+    size_t pos = 0, len = 0;
+    size_t consumed = 0;
+
+    int peek() {
+        if (pos == len) {
+            consumed += len;
+            len = fread(buffer.data(), 1, buffer.size(), file);
+            pos = 0;
+            if (len == 0) return EOF;
+        }
+        return (unsigned char)buffer[pos];
+    }
+
+public:
+    bool open(const std::string& path, std::string& error) {
+        if (path == "-") {
+            file = stdin;
+            return true;
+        }
+        file = fopen(path.c_str(), "rb");
+        if (!file) {
+            error = "Cannot open " + path + ": " + strerror(errno);
+            return false;
+        }
+        owned = true;
+        return true;
+    }
+
+    // False at end of input
+    bool next(long long& value) {
+        int c;
+        bool negative = false;
+        for (;;) {
+            c = peek();
+            if (c == EOF) return false;
+            pos++;
+            if (c >= '0' && c <= '9') break;
+            negative = c == '-';
+        }
+        value = c - '0';
+        while ((c = peek()) >= '0' && c <= '9') {
+            value = value * 10 + (c - '0');
+            pos++;
+        }
+        if (negative) value = -value;
+        return true;
+    }
+
+    size_t bytes() const { return consumed + pos; }
+
+    ~NumberStream() {
+        if (owned) fclose(file);
+    }
+};
+
+#endif
@@ -0,0 +1,370 @@
+#ifndef ALGOVISTA_POINT_TO_POINT_H
+#define ALGOVISTA_POINT_TO_POINT_H
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <cmath>
+#include <random>
+#include <cstdint>
+#include <cstring>
+#include "GraphFile.h"
+#include "ShortestPath.h"
+
+// Single source-target queries that settle far fewer vertices than a full
+// Dijkstra tree:
+//  - bidirectional: forward search from s and backward search (on the
+//    reverse graph) from t, stopping once the two queue minima together
+//    reach the best s-t path seen so far
+//  - A*: Dijkstra on reduced costs w(u, v) - h(u) + h(v) for a consistent
+//    lower bound h on the distance to t. h = 0 is plain Dijkstra; with
+//    vertex coordinates h is the straight-line distance scaled by the
+//    smallest weight per unit length of any edge; with landmarks (ALT) it
+//    is the best triangle-inequality bound over the landmarks
+// Labels only reset what the previous query touched, so one set serves
+// many queries on a large graph.
+
+namespace sssp {
+
+struct Labels {
+    std::vector<int64_t> dist;
+    std::vector<uint32_t> pred;
+    std::vector<uint32_t> touched;
+
+    explicit Labels(uint32_t n = 0) : dist(n, unreachable), pred(n, noVertex) {}
+
+    void set(uint32_t v, int64_t d, uint32_t p) {
+        if (dist[v] == unreachable) touched.push_back(v);
+        dist[v] = d;
+        pred[v] = p;
+    }
+
+    void reset() {
+        for (uint32_t v : touched) {
+            dist[v] = unreachable;
+            pred[v] = noVertex;
+        }
+        touched.clear();
+    }
+
+    // Vertices from the search root to v, following pred
+    std::vector<uint32_t> chain(uint32_t v) const {
+        std::vector<uint32_t> path;
+        for (; v != noVertex; v = pred[v]) path.push_back(v);
+        return std::vector<uint32_t>(path.rbegin(), path.rend());
+    }
+};
+
+struct Route {
+    int64_t distance = unreachable;
+    std::vector<uint32_t> path;
+    uint64_t settled = 0;
+};
+
+struct ZeroPotential {
+    int64_t operator()(uint32_t) const { return 0; }
+};
+
+// Straight-line bound. scale is the least weight per unit of length over all
+// edges, so scale * |uv| <= w(u, v) on every edge; rounding down keeps the
+// bound consistent for integer weights.
+struct EuclideanPotential {
+    const double* coords;
+    double scale, tx, ty;
+
+    EuclideanPotential(const double* coords, double scale, uint32_t target)
+        : coords(coords), scale(scale), tx(coords[2 * target]), ty(coords[2 * target + 1]) {}
+
+    int64_t operator()(uint32_t v) const {
+        return (int64_t)(scale * std::hypot(coords[2 * v] - tx, coords[2 * v + 1] - ty));
+    }
+};
+
+inline double euclideanScale(const csr::Graph& g) {
+    double scale = INFINITY;
+    for (uint32_t u = 0; u < g.n; u++) {
+        for (uint64_t e = g.offsets[u]; e < g.offsets[u + 1]; e++) {
+            uint32_t v = g.targets[e];
+            double length = std::hypot(g.coords[2 * u] - g.coords[2 * v], g.coords[2 * u + 1] - g.coords[2 * v + 1]);
+            if (length > 0) scale = std::min(scale, g.weights[e] / length);
+        }
+    }
+    return std::isfinite(scale) ? scale * (1 - 1e-9) : 0;
+}
+
+// Goal-directed search from source to target under potential h. A vertex
+// whose potential is unreachable cannot reach target and is never queued.
+template <typename Potential>
+Route astar(const csr::Graph& g, uint32_t source, uint32_t target, const Potential& h, Labels& labels, QuadQueue& queue) {
+    Route route;
+    labels.reset();
+    queue.clear();
+    labels.set(source, 0, noVertex);
+    queue.update(source, h(source));
+    while (!queue.empty()) {
+        int64_t key;
+        uint32_t u;
+        queue.pop(key, u);
+        int64_t d = labels.dist[u];
+        if (key > d + h(u)) continue;
+        route.settled++;
+        if (u == target) {
+            route.distance = d;
+            route.path = labels.chain(target);
+            break;
+        }
+        for (uint64_t e = g.offsets[u]; e < g.offsets[u + 1]; e++) {
+            uint32_t v = g.targets[e];
+            int64_t candidate = d + g.weights[e];
+            if (candidate < labels.dist[v]) {
+                int64_t hv = h(v);
+                if (hv == unreachable) continue;
+                labels.set(v, candidate, u);
+                queue.update(v, candidate + hv);
+            }
+        }
+    }
+    return route;
+}
+
+// reverse is g transposed (g itself when undirected). The forward side
+// labels distances from source, the backward side distances to target;
+// meetFrom -> meetTo is the edge of the best path that joins them.
+inline Route bidirectional(const csr::Graph& g, const csr::Graph& reverse, uint32_t source, uint32_t target,
+                           Labels& forward, Labels& backward, QuadQueue& forwardQueue, QuadQueue& backwardQueue) {
+    Route route;
+    forward.reset();
+    backward.reset();
+    forwardQueue.clear();
+    backwardQueue.clear();
+    forward.set(source, 0, noVertex);
+    backward.set(target, 0, noVertex);
+    forwardQueue.update(source, 0);
+    backwardQueue.update(target, 0);
+    int64_t best = source == target ? 0 : unreachable;
+    uint32_t meetFrom = source, meetTo = source;
+
+    while (!forwardQueue.empty() && !backwardQueue.empty()) {
+        // Stale entries only make a minimum smaller, so the test stays safe
+        if (forwardQueue.topKey() + backwardQueue.topKey() >= best) break;
+        bool isForward = forwardQueue.topKey() <= backwardQueue.topKey();
+        const csr::Graph& side = isForward ? g : reverse;
+        Labels& mine = isForward ? forward : backward;
+        const Labels& other = isForward ? backward : forward;
+        QuadQueue& queue = isForward ? forwardQueue : backwardQueue;
+
+        int64_t d;
+        uint32_t u;
+        queue.pop(d, u);
+        if (d > mine.dist[u]) continue;
+        route.settled++;
+        for (uint64_t e = side.offsets[u]; e < side.offsets[u + 1]; e++) {
+            uint32_t v = side.targets[e];
+            int64_t candidate = d + side.weights[e];
+            if (candidate < mine.dist[v]) {
+                mine.set(v, candidate, u);
+                queue.update(v, candidate);
+            }
+            if (other.dist[v] != unreachable && candidate + other.dist[v] < best) {
+                best = candidate + other.dist[v];
+                meetFrom = isForward ? u : v;
+                meetTo = isForward ? v : u;
+            }
+        }
+    }
+
+    if (best == unreachable) return route;
+    route.distance = best;
+    route.path = forward.chain(meetFrom);
+    if (meetTo != meetFrom) {
+        for (uint32_t v = meetTo; v != noVertex; v = backward.pred[v]) route.path.push_back(v);
+    }
+    return route;
+}
+
+// Landmark distances for ALT: from[i * n + v] = d(L_i, v) and
+// to[i * n + v] = d(v, L_i). On an undirected graph the two coincide and
+// to points at from.
+struct Landmarks {
+    uint32_t count = 0, n = 0;
+    bool symmetric = false;
+    const uint32_t* ids = nullptr;
+    const int64_t* from = nullptr;
+    const int64_t* to = nullptr;
+    std::shared_ptr<const void> storage;
+};
+
+struct LandmarkArrays {
+    std::vector<uint32_t> ids;
+    std::vector<int64_t> from, to;
+};
+
+// Farthest-point selection: each landmark is the vertex farthest (in the
+// forward metric) from those already chosen, starting from the vertex
+// farthest from a random one. Vertices no landmark reaches count as
+// infinitely far, so every component of a disconnected graph gets covered.
+inline Landmarks chooseLandmarks(const csr::Graph& g, const csr::Graph& reverse, uint32_t count, uint32_t seed = 48) {
+    auto arrays = std::make_shared<LandmarkArrays>();
+    Landmarks marks;
+    marks.n = g.n;
+    marks.symmetric = g.symmetric;
+    count = std::min(count, g.n);
+    std::vector<int64_t> nearest(g.n, unreachable);
+    Tree tree;
+    std::mt19937 rng(seed);
+    uint32_t next = g.n ? rng() % g.n : 0;
+    if (g.n) {
+        dijkstra<QuadQueue>(g, next, tree);
+        for (uint32_t v = 0; v < g.n; v++) {
+            if (tree.dist[v] != unreachable && tree.dist[v] > tree.dist[next]) next = v;
+        }
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        arrays->ids.push_back(next);
+        dijkstra<QuadQueue>(g, next, tree);
+        arrays->from.insert(arrays->from.end(), tree.dist.begin(), tree.dist.end());
+        if (!g.symmetric) {
+            dijkstra<QuadQueue>(reverse, next, tree);
+            arrays->to.insert(arrays->to.end(), tree.dist.begin(), tree.dist.end());
+        }
+        const int64_t* fromLandmark = arrays->from.data() + (size_t)i * g.n;
+        for (uint32_t v = 0; v < g.n; v++) nearest[v] = std::min(nearest[v], fromLandmark[v]);
+        next = 0;
+        for (uint32_t v = 1; v < g.n; v++) {
+            if (nearest[v] > nearest[next]) next = v;
+        }
+    }
+    marks.count = arrays->ids.size();
+    marks.ids = arrays->ids.data();
+    marks.from = arrays->from.data();
+    marks.to = g.symmetric ? marks.from : arrays->to.data();
+    marks.storage = arrays;
+    return marks;
+}
+
+// max over landmarks of d(L, t) - d(L, v) and d(v, L) - d(t, L). A landmark
+// that v cannot reach but t can proves v cannot reach t.
+struct LandmarkPotential {
+    const Landmarks& marks;
+    uint32_t target;
+
+    int64_t operator()(uint32_t v) const {
+        int64_t best = 0;
+        size_t n = marks.n;
+        for (uint32_t i = 0; i < marks.count; i++) {
+            int64_t fromV = marks.from[i * n + v], fromT = marks.from[i * n + target];
+            if (fromV != unreachable && fromT != unreachable) best = std::max(best, fromT - fromV);
+            int64_t toV = marks.to[i * n + v], toT = marks.to[i * n + target];
+            if (toT != unreachable) {
+                if (toV == unreachable) return unreachable;
+                best = std::max(best, toV - toT);
+            }
+        }
+        return best;
+    }
+};
+
+// Landmark files sit next to a graph file and are mapped the same way:
+//   LandmarkHeader   56 bytes
+//   ids    uint32 x count       (padded to 8 bytes)
+//   from   int64  x count * n
+//   to     int64  x count * n   unless Symmetric
+// The header records the graph's vertex and arc counts so a file built for
+// another graph, or for the other orientation, is refused.
+struct LandmarkHeader {
+    char magic[8];          // "AVLANDMK"
+    uint32_t version;
+    uint32_t flags;         // csr::Symmetric
+    uint32_t count;
+    uint32_t reserved;
+    uint64_t vertices;
+    uint64_t arcs;
+    uint64_t fromAt, toAt;
+};
+static_assert(sizeof(LandmarkHeader) == 56, "landmark header must stay 56 bytes");
+
+const char landmarkMagic[8] = {'A', 'V', 'L', 'A', 'N', 'D', 'M', 'K'};
+
+inline bool saveLandmarks(const Landmarks& marks, const csr::Graph& g, const std::string& path, std::string& error) {
+    LandmarkHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, landmarkMagic, sizeof(h.magic));
+    h.version = 1;
+    h.flags = marks.symmetric ? (uint32_t)csr::Symmetric : 0u;
+    h.count = marks.count;
+    h.vertices = g.n;
+    h.arcs = g.m;
+    uint64_t table = (uint64_t)marks.count * marks.n * sizeof(int64_t);
+    h.fromAt = (sizeof(h) + marks.count * sizeof(uint32_t) + 7) & ~(uint64_t)7;
+    h.toAt = marks.symmetric ? 0 : h.fromAt + table;
+
+    FILE* out = fopen(path.c_str(), "wb");
+    if (!out) {
+        error = "Cannot create " + path + ": " + strerror(errno);
+        return false;
+    }
+    static const char zeros[8] = {0};
+    size_t pad = h.fromAt - sizeof(h) - marks.count * sizeof(uint32_t);
+    bool ok = fwrite(&h, sizeof(h), 1, out) == 1 &&
+              fwrite(marks.ids, sizeof(uint32_t), marks.count, out) == marks.count &&
+              fwrite(zeros, 1, pad, out) == pad &&
+              fwrite(marks.from, 1, table, out) == table &&
+              (marks.symmetric || fwrite(marks.to, 1, table, out) == table);
+    if (fclose(out) != 0) ok = false;
+    if (!ok) error = "Cannot write " + path + ": " + strerror(errno);
+    return ok;
+}
+
+inline bool loadLandmarks(const std::string& path, const csr::Graph& g, Landmarks& marks, std::string& error) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error = "Cannot open " + path + ": " + strerror(errno);
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (uint64_t)st.st_size < sizeof(LandmarkHeader)) {
+        error = path + " is not a landmark file";
+        close(fd);
+        return false;
+    }
+    auto mapping = std::make_shared<csr::FileMapping>();
+    mapping->addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping->addr == MAP_FAILED) {
+        mapping->addr = nullptr;
+        error = "Cannot map " + path + ": " + strerror(errno);
+        return false;
+    }
+    mapping->size = st.st_size;
+    const char* base = static_cast<const char*>(mapping->addr);
+    LandmarkHeader h;
+    memcpy(&h, base, sizeof(h));
+    if (memcmp(h.magic, landmarkMagic, sizeof(h.magic)) != 0 || h.version != 1) {
+        error = path + " is not a version 1 landmark file";
+        return false;
+    }
+    bool symmetric = h.flags & csr::Symmetric;
+    if (h.vertices != g.n || h.arcs != g.m || symmetric != g.symmetric) {
+        error = path + " was built for a different graph or orientation";
+        return false;
+    }
+    uint64_t table = (uint64_t)h.count * h.vertices * sizeof(int64_t);
+    uint64_t end = (symmetric ? h.fromAt : h.toAt) + table;
+    if (h.fromAt < sizeof(h) + h.count * sizeof(uint32_t) || h.fromAt % 8 || h.toAt % 8 || end > mapping->size ||
+        (!symmetric && h.toAt < h.fromAt + table)) {
+        error = path + " is truncated or has a corrupt header";
+        return false;
+    }
+    marks.count = h.count;
+    marks.n = h.vertices;
+    marks.symmetric = symmetric;
+    marks.ids = reinterpret_cast<const uint32_t*>(base + sizeof(h));
+    marks.from = reinterpret_cast<const int64_t*>(base + h.fromAt);
+    marks.to = symmetric ? marks.from : reinterpret_cast<const int64_t*>(base + h.toAt);
+    marks.storage = mapping;
+    return true;
+}
+
+} // namespace sssp
+
+#endif
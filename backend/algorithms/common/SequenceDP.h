@@ -0,0 +1,104 @@
+#ifndef ALGOVISTA_SEQUENCE_DP_H
+#define ALGOVISTA_SEQUENCE_DP_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <climits>
+#include <algorithm>
+
+// Shared pieces of the pairwise sequence DPs (LCS, edit distance, alignment).
+// Every one of them fills an (m+1) x (n+1) grid where a cell only looks at the
+// previous one or two rows, so none of them keeps the grid:
+//  - sweepRows: row-by-row driver over a Model, keeping three rows and
+//    optionally restricting each row to the diagonal band |i - j| <= width
+//  - MatchMasks / bitStep: per-byte bit masks of the first string, used by
+//    the bit-parallel kernels to advance 64 cells per word operation
+
+namespace seqdp {
+
+// Large enough to lose every min(), small enough that adding costs never overflows
+const int INF = INT_MAX / 4;
+
+// A Model describes one recurrence:
+//   using State = ...;
+//   State top(size_t j) const;                   // row 0
+//   State left(size_t i) const;                  // column 0
+//   State blocked() const;                       // cell outside the band
+//   State cell(size_t i, size_t j, const State* prev2, const State* prev, const State* cur) const;
+//   int score(const State& s) const;             // value compared against the bound
+//
+// sweepRows returns row m. If width is given, cells with |i - j| > width are
+// never computed; if bound is given as well and a whole row scores above it,
+// the sweep stops early and `exceeded` is set.
+template <typename Model>
+std::vector<typename Model::State> sweepRows(const Model& model, size_t m, size_t n, size_t width = SIZE_MAX,
+                                             int bound = INF, bool* exceeded = nullptr) {
+    using State = typename Model::State;
+    std::vector<State> prev2(n + 1), prev(n + 1), cur(n + 1);
+    for (size_t j = 0; j <= n; j++) prev[j] = model.top(j);
+    if (exceeded) *exceeded = false;
+    bool banded = width < SIZE_MAX;
+
+    for (size_t i = 1; i <= m; i++) {
+        size_t lo = banded && i > width ? i - width : 1;
+        size_t hi = banded ? std::min(n, i + width) : n;
+        cur[0] = model.left(i);
+        if (lo > 1 && lo <= n + 1) cur[lo - 1] = model.blocked();
+        int best = lo == 1 ? model.score(cur[0]) : INF;
+        for (size_t j = lo; j <= hi; j++) {
+            cur[j] = model.cell(i, j, prev2.data(), prev.data(), cur.data());
+            best = std::min(best, model.score(cur[j]));
+        }
+        if (hi < n) cur[hi + 1] = model.blocked();
+        std::swap(prev2, prev);
+        std::swap(prev, cur);
+        if (bound < INF && best > bound) {
+            if (exceeded) *exceeded = true;
+            break;
+        }
+    }
+    return prev;
+}
+
+// Bit i of mask(c) is set where a[i] == c. Only bytes that occur in a get a
+// row, so sparse alphabets stay cheap on long inputs.
+struct MatchMasks {
+    size_t words;
+    std::vector<std::vector<uint64_t>> rows;
+
+    explicit MatchMasks(const std::string& a) : words((a.size() + 63) / 64), rows(256) {
+        for (size_t i = 0; i < a.size(); i++) {
+            std::vector<uint64_t>& mask = rows[(unsigned char)a[i]];
+            if (mask.empty()) mask.assign(words, 0);
+            mask[i / 64] |= 1ULL << (i % 64);
+        }
+    }
+    const uint64_t* mask(char c) const {
+        const std::vector<uint64_t>& row = rows[(unsigned char)c];
+        return row.empty() ? nullptr : row.data();
+    }
+};
+
+// One column of Hyyro's LCS recurrence, V = (V + U) | (V - U) with
+// U = V & mask, over words [w0, w1). carry and borrow run in from the word
+// below and out to the word above, so the vector can be split into blocks.
+inline void bitStep(uint64_t* V, const uint64_t* mask, size_t w0, size_t w1, uint64_t& carry, uint64_t& borrow) {
+    for (size_t w = w0; w < w1; w++) {
+        uint64_t v = V[w];
+        uint64_t u = v & mask[w];
+        uint64_t sum = v + u;
+        uint64_t c1 = sum < v;
+        sum += carry;
+        carry = c1 | (sum < carry);
+        uint64_t diff = v - u;
+        uint64_t b1 = v < u;
+        uint64_t diff2 = diff - borrow;
+        borrow = b1 | (diff < borrow);
+        V[w] = sum | diff2;
+    }
+}
+
+} // namespace seqdp
+
+#endif
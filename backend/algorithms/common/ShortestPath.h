@@ -0,0 +1,260 @@
+#ifndef ALGOVISTA_SHORTEST_PATH_H
+#define ALGOVISTA_SHORTEST_PATH_H
+
+#include <vector>
+#include <queue>
+#include <string>
+#include <utility>
+#include <functional>
+#include <cstdint>
+#include "CSRGraph.h"
+
+// Single-source shortest paths over csr::Graph with non-negative weights.
+// One Dijkstra loop runs over interchangeable priority queues:
+//  - BinaryQueue: std::priority_queue, the textbook baseline
+//  - QuadQueue: 4-ary implicit heap, shallower and more cache-friendly
+//  - IndexedQueue: 4-ary heap with a position table and true decrease-key,
+//    so it never holds more than one entry per vertex
+//  - RadixQueue: monotone radix heap for integer keys, O(log C) amortized
+// The lazy queues (all but IndexedQueue) may hold outdated entries for a
+// vertex whose distance has since dropped; the loop skips such a pop
+// instead of scanning the vertex's edges again. Distances are int64.
+
+namespace sssp {
+
+const int64_t unreachable = INT64_MAX;
+const uint32_t noVertex = UINT32_MAX;
+
+struct Tree {
+    std::vector<int64_t> dist;
+    std::vector<uint32_t> pred;   // noVertex for the source and unreached vertices
+    uint64_t settled = 0, pushes = 0, stale = 0;
+
+    // Vertices from source to target, empty when target is unreached
+    std::vector<uint32_t> pathTo(uint32_t target) const {
+        std::vector<uint32_t> path;
+        if (dist[target] == unreachable) return path;
+        for (uint32_t v = target; v != noVertex; v = pred[v]) path.push_back(v);
+        return std::vector<uint32_t>(path.rbegin(), path.rend());
+    }
+};
+
+class BinaryQueue {
+    typedef std::pair<int64_t, uint32_t> Entry;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+
+public:
+    explicit BinaryQueue(uint32_t) {}
+    bool empty() const { return heap.empty(); }
+    void update(uint32_t v, int64_t key) { heap.push({key, v}); }
+    void pop(int64_t& key, uint32_t& v) {
+        key = heap.top().first;
+        v = heap.top().second;
+        heap.pop();
+    }
+};
+
+class QuadQueue {
+    struct Entry {
+        int64_t key;
+        uint32_t v;
+    };
+    std::vector<Entry> heap;
+
+public:
+    explicit QuadQueue(uint32_t) {}
+    bool empty() const { return heap.empty(); }
+    int64_t topKey() const { return heap[0].key; }
+    void clear() { heap.clear(); }
+
+    void update(uint32_t v, int64_t key) {
+        size_t i = heap.size();
+        heap.push_back({key, v});
+        while (i > 0) {
+            size_t parent = (i - 1) / 4;
+            if (heap[parent].key <= key) break;
+            heap[i] = heap[parent];
+            i = parent;
+        }
+        heap[i] = {key, v};
+    }
+
+    void pop(int64_t& key, uint32_t& v) {
+        key = heap[0].key;
+        v = heap[0].v;
+        Entry last = heap.back();
+        heap.pop_back();
+        size_t n = heap.size(), i = 0;
+        if (n == 0) return;
+        for (;;) {
+            size_t child = 4 * i + 1;
+            if (child >= n) break;
+            size_t best = child, end = child + 4 < n ? child + 4 : n;
+            for (size_t c = child + 1; c < end; c++) {
+                if (heap[c].key < heap[best].key) best = c;
+            }
+            if (heap[best].key >= last.key) break;
+            heap[i] = heap[best];
+            i = best;
+        }
+        heap[i] = last;
+    }
+};
+
+class IndexedQueue {
+    std::vector<uint32_t> heap;     // vertices
+    std::vector<int64_t> key;       // by vertex
+    std::vector<uint32_t> pos;      // heap index by vertex, noVertex when absent
+
+    void place(size_t i, uint32_t v) {
+        heap[i] = v;
+        pos[v] = i;
+    }
+
+    void siftUp(size_t i, uint32_t v) {
+        while (i > 0) {
+            size_t parent = (i - 1) / 4;
+            if (key[heap[parent]] <= key[v]) break;
+            place(i, heap[parent]);
+            i = parent;
+        }
+        place(i, v);
+    }
+
+public:
+    explicit IndexedQueue(uint32_t n) : key(n), pos(n, noVertex) {}
+    bool empty() const { return heap.empty(); }
+
+    void update(uint32_t v, int64_t k) {
+        key[v] = k;
+        if (pos[v] == noVertex) {
+            heap.push_back(v);
+            siftUp(heap.size() - 1, v);
+        } else {
+            siftUp(pos[v], v);
+        }
+    }
+
+    void pop(int64_t& k, uint32_t& v) {
+        v = heap[0];
+        k = key[v];
+        pos[v] = noVertex;
+        uint32_t last = heap.back();
+        heap.pop_back();
+        size_t n = heap.size(), i = 0;
+        if (n == 0) return;
+        for (;;) {
+            size_t child = 4 * i + 1;
+            if (child >= n) break;
+            size_t best = child, end = child + 4 < n ? child + 4 : n;
+            for (size_t c = child + 1; c < end; c++) {
+                if (key[heap[c]] < key[heap[best]]) best = c;
+            }
+            if (key[heap[best]] >= key[last]) break;
+            place(i, heap[best]);
+            i = best;
+        }
+        place(i, last);
+    }
+};
+
+// Keys never drop below the last key popped (true for Dijkstra with
+// non-negative weights). An entry lives in bucket b = bit length of
+// key ^ last, so bucket 0 holds keys equal to last. When bucket 0 runs dry
+// the first non-empty bucket is emptied into lower ones around its minimum;
+// each entry moves down at most 64 times over its life.
+class RadixQueue {
+    struct Entry {
+        uint64_t key;
+        uint32_t v;
+    };
+    std::vector<Entry> buckets[65];
+    uint64_t last = 0;
+    size_t count = 0;
+
+    static int bucketOf(uint64_t key, uint64_t last) {
+        return key == last ? 0 : 64 - __builtin_clzll(key ^ last);
+    }
+
+public:
+    explicit RadixQueue(uint32_t) {}
+    bool empty() const { return count == 0; }
+
+    void update(uint32_t v, int64_t key) {
+        buckets[bucketOf(key, last)].push_back({(uint64_t)key, v});
+        count++;
+    }
+
+    void pop(int64_t& key, uint32_t& v) {
+        if (buckets[0].empty()) {
+            int b = 1;
+            while (buckets[b].empty()) b++;
+            uint64_t lowest = buckets[b][0].key;
+            for (const Entry& e : buckets[b]) lowest = e.key < lowest ? e.key : lowest;
+            last = lowest;
+            for (const Entry& e : buckets[b]) buckets[bucketOf(e.key, last)].push_back(e);
+            buckets[b].clear();
+        }
+        key = buckets[0].back().key;
+        v = buckets[0].back().v;
+        buckets[0].pop_back();
+        count--;
+    }
+};
+
+// Settles vertices in distance order from source; stops early once target
+// (when given) is settled. Weights must be non-negative.
+template <typename Queue>
+void dijkstra(const csr::Graph& g, uint32_t source, Tree& tree, uint32_t target = noVertex) {
+    tree.dist.assign(g.n, unreachable);
+    tree.pred.assign(g.n, noVertex);
+    tree.settled = tree.pushes = tree.stale = 0;
+    Queue queue(g.n);
+    tree.dist[source] = 0;
+    queue.update(source, 0);
+    tree.pushes++;
+    while (!queue.empty()) {
+        int64_t d;
+        uint32_t u;
+        queue.pop(d, u);
+        if (d > tree.dist[u]) {
+            tree.stale++;
+            continue;
+        }
+        tree.settled++;
+        if (u == target) break;
+        for (uint64_t e = g.offsets[u]; e < g.offsets[u + 1]; e++) {
+            uint32_t v = g.targets[e];
+            int64_t candidate = d + g.weights[e];
+            if (candidate < tree.dist[v]) {
+                tree.dist[v] = candidate;
+                tree.pred[v] = u;
+                queue.update(v, candidate);
+                tree.pushes++;
+            }
+        }
+    }
+}
+
+// Runs dijkstra with the queue named by heap ("binary", "4ary", "indexed"
+// or "radix"); false for an unknown name
+inline bool dijkstra(const std::string& heap, const csr::Graph& g, uint32_t source, Tree& tree, uint32_t target = noVertex) {
+    if (heap == "binary") dijkstra<BinaryQueue>(g, source, tree, target);
+    else if (heap == "4ary") dijkstra<QuadQueue>(g, source, tree, target);
+    else if (heap == "indexed") dijkstra<IndexedQueue>(g, source, tree, target);
+    else if (heap == "radix") dijkstra<RadixQueue>(g, source, tree, target);
+    else return false;
+    return true;
+}
+
+// True when no edge weight is negative
+inline bool nonNegative(const csr::Graph& g) {
+    for (uint64_t e = 0; e < g.m; e++) {
+        if (g.weights[e] < 0) return false;
+    }
+    return true;
+}
+
+} // namespace sssp
+
+#endif
@@ -0,0 +1,186 @@
+#ifndef ALGOVISTA_TEXT_STREAM_H
+#define ALGOVISTA_TEXT_STREAM_H
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <cstring>
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Chunked scanning of large texts for the string matchers. A file is
+// memory-mapped and walked in windows; "-" reads stdin into a reusable
+// buffer. Consecutive windows overlap by `overlap` bytes (pattern length - 1),
+// so a match that crosses a chunk boundary is seen whole in exactly one
+// window and never twice.
+
+// Body of a JSON string literal: quotes and backslashes escaped, control
+// characters as \u00XX. Patterns and file paths reach the output verbatim.
+inline std::string jsonEscape(const char* s, size_t len) {
+    std::string out;
+    for (size_t i = 0; i < len; i++) {
+        unsigned char c = s[i];
+        if (c == '"' || c == '\\') { out += '\\'; out += c; }
+        else if (c < 0x20) { char buf[8]; snprintf(buf, sizeof(buf), "\\u%04x", c); out += buf; }
+        else out += c;
+    }
+    return out;
+}
+
+inline std::string jsonEscape(const std::string& s) { return jsonEscape(s.data(), s.size()); }
+
+struct StreamStats {
+    size_t bytes = 0;
+    double seconds = 0;
+    bool mapped = false;
+};
+
+// match(data, len, base) must report matches starting at data[i] as base + i.
+template <typename Matcher>
+bool scanTextSource(const std::string& path, size_t overlap, size_t chunkSize, Matcher match,
+                    StreamStats& stats, std::string& error) {
+    auto start = std::chrono::steady_clock::now();
+    if (chunkSize <= overlap) chunkSize = overlap + 1;
+
+    if (path != "-") {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            error = "Cannot open " + path + ": " + strerror(errno);
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            error = "Cannot stat " + path + ": " + strerror(errno);
+            close(fd);
+            return false;
+        }
+        size_t size = st.st_size;
+        if (size > 0) {
+            void* map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (map == MAP_FAILED) {
+                error = "Cannot map " + path + ": " + strerror(errno);
+                close(fd);
+                return false;
+            }
+            madvise(map, size, MADV_SEQUENTIAL);
+            const char* data = static_cast<const char*>(map);
+            for (size_t begin = 0; begin < size; begin += chunkSize) {
+                size_t from = begin >= overlap ? begin - overlap : 0;
+                size_t to = begin + chunkSize < size ? begin + chunkSize : size;
+                match(data + from, to - from, from);
+            }
+            munmap(map, size);
+        }
+        close(fd);
+        stats.bytes = size;
+        stats.mapped = true;
+    } else {
+        std::vector<char> buffer(overlap + chunkSize);
+        size_t kept = 0;     // bytes carried over from the previous window
+        size_t offset = 0;   // stream offset of buffer[0]
+        size_t got;
+        while ((got = fread(buffer.data() + kept, 1, chunkSize, stdin)) > 0) {
+            size_t len = kept + got;
+            match(buffer.data(), len, offset);
+            kept = len < overlap ? len : overlap;
+            memmove(buffer.data(), buffer.data() + len - kept, kept);
+            offset += len - kept;
+            stats.bytes += got;
+        }
+    }
+
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return true;
+}
+
+// Whole text as one contiguous view: a read-only mapping for files, or an
+// owned copy of stdin for "-".
+class MappedText {
+    const char* mapping = nullptr;
+    size_t mappedSize = 0;
+    std::string owned;
+
+public:
+    const char* data = nullptr;
+    size_t size = 0;
+
+    bool open(const std::string& path, std::string& error) {
+        if (path == "-") {
+            char buffer[1 << 16];
+            size_t got;
+            while ((got = fread(buffer, 1, sizeof(buffer), stdin)) > 0) owned.append(buffer, got);
+            data = owned.data();
+            size = owned.size();
+            return true;
+        }
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            error = "Cannot open " + path + ": " + strerror(errno);
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            error = "Cannot stat " + path + ": " + strerror(errno);
+            close(fd);
+            return false;
+        }
+        size = st.st_size;
+        if (size > 0) {
+            void* map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (map == MAP_FAILED) {
+                error = "Cannot map " + path + ": " + strerror(errno);
+                close(fd);
+                return false;
+            }
+            mapping = static_cast<const char*>(map);
+            mappedSize = size;
+        }
+        close(fd);
+        data = mapping;
+        return true;
+    }
+
+    ~MappedText() {
+        if (mapping) munmap(const_cast<char*>(mapping), mappedSize);
+    }
+};
+
+// Split text[0, n) into one contiguous range per thread. Thread t scans its
+// range plus `overlap` bytes past the end but keeps only matches that start
+// inside its own range, so every match is owned by exactly one thread. The
+// per-thread lists are already sorted and disjoint, so merging them is a
+// concatenation in thread order.
+template <typename Matcher>
+std::vector<size_t> parallelScan(const char* text, size_t n, size_t overlap, unsigned threads, Matcher match) {
+    if (threads == 0) threads = 1;
+    if (threads > n / (overlap + 1) + 1) threads = n / (overlap + 1) + 1;
+    std::vector<std::vector<size_t>> found(threads);
+    std::vector<std::thread> workers;
+    size_t per = (n + threads - 1) / threads;
+    for (unsigned t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            size_t begin = t * per < n ? t * per : n;
+            size_t end = begin + per < n ? begin + per : n;
+            size_t scanEnd = end + overlap < n ? end + overlap : n;
+            std::vector<size_t>& out = found[t];
+            match(text + begin, scanEnd - begin, begin, [&](size_t offset) {
+                if (offset < end) out.push_back(offset);
+            });
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    std::vector<size_t> merged;
+    size_t total = 0;
+    for (auto& f : found) total += f.size();
+    merged.reserve(total);
+    for (auto& f : found) merged.insert(merged.end(), f.begin(), f.end());
+    return merged;
+}
+
+#endif
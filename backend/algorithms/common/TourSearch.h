@@ -0,0 +1,368 @@
+#ifndef ALGOVISTA_TOUR_SEARCH_H
+#define ALGOVISTA_TOUR_SEARCH_H
+
+#include <vector>
+#include <deque>
+#include <algorithm>
+#include <numeric>
+#include <chrono>
+#include <cstdint>
+
+// Tour construction and local search for symmetric TSP instances, shared by
+// the heuristic solver and the branch-and-bound incumbent. Everything is
+// templated on a distance callable dist(a, b) -> long long, so matrix and
+// coordinate instances use the same code.
+//  - candidate lists: each city's k nearest others, nearest first
+//  - nearestNeighborTour / greedyTour: O(n k) style constructions that fall
+//    back to full scans only when all candidates are used up
+//  - LocalSearch: 2-opt and Or-opt (segments of 1..3 cities, either
+//    orientation) driven by candidate lists and don't-look bits; the tour is
+//    an array plus position index, and 2-opt reverses the shorter side
+//  - iterateKicks: double-bridge kicks on top of LocalSearch
+
+namespace toursearch {
+
+template <typename Dist>
+long long tourLength(const std::vector<int>& order, const Dist& dist) {
+    long long total = 0;
+    for (size_t i = 0; i < order.size(); i++) total += dist(order[i], order[(i + 1) % order.size()]);
+    return total;
+}
+
+// k nearest neighbours by scanning every pair: fine for matrix instances,
+// where the O(n^2) input already dominates
+template <typename Dist>
+std::vector<std::vector<int>> nearestByScan(int n, int k, const Dist& dist) {
+    std::vector<std::vector<int>> cand(n);
+    k = std::min(k, n - 1);
+    std::vector<int> others;
+    for (int a = 0; a < n; a++) {
+        others.clear();
+        for (int b = 0; b < n; b++) if (b != a) others.push_back(b);
+        std::partial_sort(others.begin(), others.begin() + k, others.end(),
+                          [&](int x, int y) { return dist(a, x) < dist(a, y); });
+        cand[a].assign(others.begin(), others.begin() + k);
+    }
+    return cand;
+}
+
+template <typename Dist>
+std::vector<int> nearestNeighborTour(int n, int start, const Dist& dist, const std::vector<std::vector<int>>& cand) {
+    std::vector<int> order;
+    if (n == 0) return order;
+    // Unvisited cities in a swap-remove array, so the fallback scan only sees those
+    std::vector<int> left(n), slot(n);
+    std::iota(left.begin(), left.end(), 0);
+    std::iota(slot.begin(), slot.end(), 0);
+    auto visit = [&](int c) {
+        int last = left.back();
+        left[slot[c]] = last;
+        slot[last] = slot[c];
+        left.pop_back();
+        slot[c] = -1;
+        order.push_back(c);
+    };
+    visit(start);
+    int cur = start;
+    while (!left.empty()) {
+        int next = -1;
+        for (int c : cand[cur]) {
+            if (slot[c] >= 0) {
+                next = c;
+                break;
+            }
+        }
+        if (next < 0) {
+            long long best = 0;
+            for (int c : left) {
+                long long d = dist(cur, c);
+                if (next < 0 || d < best) {
+                    best = d;
+                    next = c;
+                }
+            }
+        }
+        visit(next);
+        cur = next;
+    }
+    return order;
+}
+
+// Greedy edge matching over the candidate edges (shortest first, no city of
+// degree 3, no early cycle), then fragments are chained nearest-end-first
+template <typename Dist>
+std::vector<int> greedyTour(int n, const Dist& dist, const std::vector<std::vector<int>>& cand) {
+    if (n < 3) {
+        std::vector<int> order(n);
+        std::iota(order.begin(), order.end(), 0);
+        return order;
+    }
+    struct Edge { long long d; int a, b; };
+    std::vector<Edge> edges;
+    for (int a = 0; a < n; a++) {
+        for (int b : cand[a]) if (a < b || std::find(cand[b].begin(), cand[b].end(), a) == cand[b].end()) {
+            edges.push_back({dist(a, b), a, b});
+        }
+    }
+    std::sort(edges.begin(), edges.end(), [](const Edge& x, const Edge& y) { return x.d < y.d; });
+
+    std::vector<int> parent(n), degree(n, 0);
+    std::vector<int> adj(2 * n, -1);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&](int x) {
+        while (parent[x] != x) x = parent[x] = parent[parent[x]];
+        return x;
+    };
+    auto link = [&](int a, int b) {
+        adj[2 * a + degree[a]++] = b;
+        adj[2 * b + degree[b]++] = a;
+    };
+    int added = 0;
+    for (const Edge& e : edges) {
+        if (degree[e.a] < 2 && degree[e.b] < 2 && find(e.a) != find(e.b)) {
+            parent[find(e.a)] = find(e.b);
+            link(e.a, e.b);
+            if (++added == n - 1) break;
+        }
+    }
+
+    // Walk fragments; at each fragment end jump to the nearest free endpoint
+    std::vector<char> used(n, 0);
+    std::vector<int> ends;
+    for (int c = 0; c < n; c++) if (degree[c] < 2) ends.push_back(c);
+    std::vector<int> order;
+    auto walk = [&](int from) {
+        int prev = -1, cur = from;
+        while (true) {
+            used[cur] = 1;
+            order.push_back(cur);
+            int next = -1;
+            for (int s = 0; s < degree[cur]; s++) {
+                int c = adj[2 * cur + s];
+                if (c != prev && !used[c]) next = c;
+            }
+            if (next < 0) return cur;
+            prev = cur;
+            cur = next;
+        }
+    };
+    int tail = walk(ends.empty() ? 0 : ends[0]);
+    while ((int)order.size() < n) {
+        int next = -1;
+        long long best = 0;
+        for (int c : ends) {
+            if (used[c]) continue;
+            long long d = dist(tail, c);
+            if (next < 0 || d < best) {
+                best = d;
+                next = c;
+            }
+        }
+        tail = walk(next);
+    }
+    return order;
+}
+
+template <typename Dist>
+class LocalSearch {
+    int n;
+    const Dist& dist;
+    const std::vector<std::vector<int>>& cand;
+    std::vector<int> order, pos;
+    std::deque<int> queue;
+    std::vector<char> queued;   // don't-look bit is the inverse of this
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+    unsigned sinceCheck = 0;
+    bool timedOut = false;
+
+    // Polls the clock every 64 calls and stays true once the deadline has
+    // passed, so optimize() stops between moves
+    bool expired() {
+        if (!timedOut && ++sinceCheck >= 64) {
+            sinceCheck = 0;
+            timedOut = std::chrono::steady_clock::now() >= deadline;
+        }
+        return timedOut;
+    }
+
+    int next(int c) const { return order[pos[c] + 1 == n ? 0 : pos[c] + 1]; }
+    int prev(int c) const { return order[pos[c] == 0 ? n - 1 : pos[c] - 1]; }
+
+    void push(int c) {
+        if (!queued[c]) {
+            queued[c] = 1;
+            queue.push_back(c);
+        }
+    }
+
+    // Reverse the circular run of positions i..j; reversing the complement
+    // gives the same cycle, so take whichever side is shorter
+    void reverse(int i, int j) {
+        int len = (j - i + n) % n + 1;
+        if (2 * len > n) {
+            int ni = (j + 1) % n, nj = (i - 1 + n) % n;
+            i = ni;
+            j = nj;
+            len = n - len;
+        }
+        for (int s = 0; s < len / 2; s++) {
+            int a = order[i], b = order[j];
+            order[i] = b;
+            pos[b] = i;
+            order[j] = a;
+            pos[a] = j;
+            i = i + 1 == n ? 0 : i + 1;
+            j = j == 0 ? n - 1 : j - 1;
+        }
+    }
+
+    bool twoOpt(int a) {
+        for (int dir = 0; dir < 2; dir++) {
+            int b = dir == 0 ? next(a) : prev(a);
+            long long dab = dist(a, b);
+            for (int c : cand[a]) {
+                long long dac = dist(a, c);
+                if (dac >= dab) break;
+                int d = dir == 0 ? next(c) : prev(c);
+                if (c == b || d == a) continue;
+                long long delta = dac + dist(b, d) - dab - dist(c, d);
+                if (delta < 0) {
+                    // a b .. c d -> a c .. b d, or mirrored for the predecessor side
+                    if (dir == 0) reverse(pos[b], pos[c]);
+                    else reverse(pos[c], pos[b]);
+                    cost += delta;
+                    push(a); push(b); push(c); push(d);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    bool orOpt(int a) {
+        if (n < 8) return false;
+        for (int len = 1; len <= 3; len++) {
+            int s1 = a, s2 = order[(pos[a] + len - 1) % n];
+            int p = prev(s1), nx = next(s2);
+            long long removed = dist(p, s1) + dist(s2, nx) - dist(p, nx);
+            if (removed <= 0) continue;
+            auto inSegment = [&](int c) { return (pos[c] - pos[s1] + n) % n < len; };
+            for (int e : {s1, s2}) {
+                for (int c : cand[e]) {
+                    if (dist(e, c) >= removed) break;
+                    if (inSegment(c)) continue;
+                    for (int side = 0; side < 2; side++) {
+                        int u = side == 0 ? c : prev(c), v = side == 0 ? next(c) : c;
+                        if (inSegment(u) || inSegment(v)) continue;
+                        long long keep = dist(u, s1) + dist(s2, v), flip = dist(u, s2) + dist(s1, v);
+                        long long delta = std::min(keep, flip) - dist(u, v) - removed;
+                        if (delta < 0) {
+                            moveSegment(s1, len, u, flip < keep);
+                            cost += delta;
+                            push(p); push(nx); push(s1); push(s2); push(u); push(v);
+                            return true;
+                        }
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
+    // Cut the len cities starting at s1 out and reinsert them right after u
+    void moveSegment(int s1, int len, int u, bool reversed) {
+        std::vector<int> segment(len);
+        for (int k = 0; k < len; k++) segment[k] = order[(pos[s1] + k) % n];
+        if (reversed) std::reverse(segment.begin(), segment.end());
+        std::vector<int> rebuilt;
+        rebuilt.reserve(n);
+        for (int k = 0; k < n - len; k++) {
+            int c = order[(pos[s1] + len + k) % n];
+            rebuilt.push_back(c);
+            if (c == u) rebuilt.insert(rebuilt.end(), segment.begin(), segment.end());
+        }
+        order.swap(rebuilt);
+        for (int k = 0; k < n; k++) pos[order[k]] = k;
+    }
+
+public:
+    long long cost = 0;
+
+    LocalSearch(const Dist& dist, const std::vector<std::vector<int>>& cand, const std::vector<int>& tour)
+        : n(tour.size()), dist(dist), cand(cand), queued(tour.size(), 0) {
+        setTour(tour);
+    }
+
+    void setTour(const std::vector<int>& tour) {
+        order = tour;
+        pos.assign(n, 0);
+        for (int k = 0; k < n; k++) pos[order[k]] = k;
+        cost = tourLength(order, dist);
+    }
+
+    const std::vector<int>& tour() const { return order; }
+
+    void setDeadline(std::chrono::steady_clock::time_point at) {
+        deadline = at;
+        timedOut = false;
+    }
+
+    // Improve until no queued city yields a move or the deadline passes;
+    // returns the number of moves
+    size_t optimize(const std::vector<int>& start) {
+        for (int c : start) push(c);
+        size_t moves = 0;
+        while (!queue.empty() && !expired()) {
+            int a = queue.front();
+            queue.pop_front();
+            queued[a] = 0;
+            if (n < 4) continue;
+            while (!expired() && (twoOpt(a) || orOpt(a))) moves++;
+        }
+        for (int c : queue) queued[c] = 0;
+        queue.clear();
+        return moves;
+    }
+
+    size_t optimizeAll() {
+        return optimize(order);
+    }
+};
+
+// Iterated local search: apply a segment-local double bridge (A B C D ->
+// A C B D with B and C at most 50 cities long), re-optimise around the eight
+// touched cities, keep the result only if the tour got shorter. Runs while
+// keepGoing() holds and calls onImprove(cost, tour) on each accepted kick.
+// Returns the number of kicks.
+template <typename Dist, typename Rng, typename KeepGoing, typename OnImprove>
+size_t iterateKicks(LocalSearch<Dist>& search, Rng& rng, KeepGoing keepGoing, OnImprove onImprove) {
+    int n = search.tour().size();
+    if (n < 8) return 0;
+    size_t kicks = 0;
+    std::vector<int> saved, rotated(n), kicked;
+    kicked.reserve(n);
+    while (keepGoing()) {
+        saved = search.tour();
+        long long before = search.cost;
+        int maxSeg = std::max(1, std::min(50, n / 4));
+        int i = rng() % n, l1 = 1 + rng() % maxSeg, l2 = 1 + rng() % maxSeg;
+        for (int k = 0; k < n; k++) rotated[k] = saved[(i + k) % n];
+        // rotated = x | B (l1 cities) | C (l2 cities) | rest
+        kicked.clear();
+        kicked.push_back(rotated[0]);
+        kicked.insert(kicked.end(), rotated.begin() + 1 + l1, rotated.begin() + 1 + l1 + l2);
+        kicked.insert(kicked.end(), rotated.begin() + 1, rotated.begin() + 1 + l1);
+        kicked.insert(kicked.end(), rotated.begin() + 1 + l1 + l2, rotated.end());
+        search.setTour(kicked);
+        search.optimize({rotated[0], rotated[1], rotated[l1], rotated[l1 + 1], rotated[l1 + l2],
+                         rotated[(1 + l1 + l2) % n], rotated[n - 1]});
+        kicks++;
+        if (search.cost < before) onImprove(search.cost, search.tour());
+        else search.setTour(saved);
+    }
+    return kicks;
+}
+
+} // namespace toursearch
+
+#endif
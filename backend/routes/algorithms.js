@@ -1,6 +1,15 @@
 const express = require('express');
 const router = express.Router();
 const runCpp = require('../utils/runCpp');
+const nodePath = require('path');
+
+// Server-side data files (large texts, indexes) are resolved inside
+// TEXT_DATA_DIR so requests cannot read or write arbitrary paths.
+function resolveDataFile(file) {
+  const dataDir = nodePath.resolve(process.env.TEXT_DATA_DIR || nodePath.join(__dirname, '../data'));
+  const filePath = nodePath.resolve(dataDir, file || '');
+  return filePath.startsWith(dataDir + nodePath.sep) ? filePath : null;
+}
 
 // Stack Operations
 router.post('/stack/push', (req, res) => {
@@ -252,13 +261,61 @@ router.post('/graph/kruskal', (req, res) => {
 });
 
 router.post('/graph/dijkstra', (req, res) => {
-  const { vertices, edges, source } = req.body;
+  const { vertices, edges, source, directed, heap, target } = req.body;
   const edgesStr = edges.map(e => `${e.from},${e.to},${e.weight}`).join(';');
   const { spawn } = require('child_process');
   const path = require('path');
   
+  const args = [vertices.toString(), edgesStr, source.toString()];
+  if (directed) args.push('--directed');
+  if (heap) args.push('--heap', heap);
+  if (target !== undefined) args.push('--target', target.toString());
+  
   const execPath = path.join(__dirname, '../algorithms/GraphAlgorithms/Dijkstra/Dijkstra');
-  const child = spawn(execPath, [vertices.toString(), edgesStr, source.toString()]);
+  const child = spawn(execPath, args);
+  
+  let output = '';
+  child.stdout.on('data', (data) => {
+    output += data.toString();
+  });
+  
+  child.on('close', (code) => {
+    try {
+      const result = JSON.parse(output.trim());
+      res.json(result);
+    } catch (e) {
+      res.json({ error: 'Failed to parse result', raw: output });
+    }
+  });
+  
+  child.on('error', (err) => {
+    res.json({ error: 'Execution failed', message: err.message });
+  });
+});
+
+router.post('/graph/deltastepping', (req, res) => {
+  const { vertices, edges, graph, source, directed, threads, delta, check } = req.body;
+  const { spawn } = require('child_process');
+  const path = require('path');
+  
+  let args;
+  if (graph) {
+    const graphPath = resolveDataFile(graph);
+    if (!graphPath) {
+      return res.json({ error: 'Files must be inside the text data directory' });
+    }
+    args = ['--graph', graphPath, source.toString()];
+  } else {
+    const edgesStr = edges.map(e => `${e.from},${e.to},${e.weight}`).join(';');
+    args = [vertices.toString(), edgesStr, source.toString()];
+  }
+  if (directed) args.push('--directed');
+  if (threads) args.push('--threads', threads.toString());
+  if (delta) args.push('--delta', delta.toString());
+  if (check) args.push('--check');
+  
+  const execPath = path.join(__dirname, '../algorithms/GraphAlgorithms/DeltaStepping/DeltaStepping');
+  const child = spawn(execPath, args);
   
   let output = '';
   child.stdout.on('data', (data) => {
@@ -486,6 +543,176 @@ router.post('/algorithms/kosaraju', (req, res) => {
   });
 });
 
+// Binary graph files: convert an edge-list text file, then run any graph
+// algorithm on the mapped file instead of an inline edge list
+router.post('/graph/convert', (req, res) => {
+  const { file, output: outFile, weighted, undirected, dimacs, coords } = req.body;
+  const { spawn } = require('child_process');
+  const path = require('path');
+  
+  const textPath = resolveDataFile(file);
+  const graphPath = resolveDataFile(outFile);
+  const coordsPath = coords ? resolveDataFile(coords) : undefined;
+  if (!textPath || !graphPath || coordsPath === null) {
+    return res.json({ error: 'Files must be inside the text data directory' });
+  }
+  const args = ['--text', textPath, graphPath];
+  if (weighted) args.push('--weighted');
+  if (undirected) args.push('--undirected');
+  if (dimacs) args.push('--dimacs');
+  if (coordsPath) args.push('--coords', coordsPath);
+  
+  const execPath = path.join(__dirname, '../algorithms/GraphAlgorithms/GraphConvert/GraphConvert');
+  const child = spawn(execPath, args);
+  
+  let output = '';
+  child.stdout.on('data', (data) => {
+    output += data.toString();
+  });
+  
+  child.on('close', (code) => {
+    try {
+      const result = JSON.parse(output.trim());
+      res.json(result);
+    } catch (e) {
+      res.json({ error: 'Failed to parse result', raw: output });
+    }
+  });
+  
+  child.on('error', (err) => {
+    res.json({ error: 'Execution failed', message: err.message });
+  });
+});
+
+// Single source-target shortest path: Dijkstra, bidirectional, A* and ALT
+// side by side, on an inline edge list or a graph file (with its landmarks)
+router.post('/algorithms/pointtopoint', (req, res) => {
+  const { vertices, edges, graph, landmarksFile, source, target, method, directed, landmarks } = req.body;
+  const { spawn } = require('child_process');
+  const path = require('path');
+  
+  let args;
+  if (graph) {
+    const graphPath = resolveDataFile(graph);
+    const altPath = landmarksFile ? resolveDataFile(landmarksFile) : undefined;
+    if (!graphPath || altPath === null) {
+      return res.json({ error: 'Files must be inside the text data directory' });
+    }
+    args = ['--graph', graphPath, source.toString(), target.toString()];
+    if (altPath) args.push('--alt', altPath);
+  } else {
+    const edgesStr = edges.map(e => `${e.from},${e.to},${e.weight}`).join(';');
+    args = [vertices.toString(), edgesStr, source.toString(), target.toString()];
+  }
+  if (method) args.push('--method', method);
+  if (directed) args.push('--directed');
+  if (landmarks) args.push('--landmarks', landmarks.toString());
+  
+  const execPath = path.join(__dirname, '../algorithms/GraphAlgorithms/PointToPoint/PointToPoint');
+  const child = spawn(execPath, args);
+  
+  let output = '';
+  child.stdout.on('data', (data) => {
+    output += data.toString();
+  });
+  
+  child.on('close', (code) => {
+    try {
+      const result = JSON.parse(output.trim());
+      res.json(result);
+    } catch (e) {
+      res.json({ error: 'Failed to parse result', raw: output });
+    }
+  });
+  
+  child.on('error', (err) => {
+    res.json({ error: 'Execution failed', message: err.message });
+  });
+});
+
+router.post('/algorithms/contractionhierarchy', (req, res) => {
+  const { vertices, edges, graph, hierarchy, source, target, directed } = req.body;
+  const { spawn } = require('child_process');
+  const path = require('path');
+  
+  let args;
+  if (hierarchy || graph) {
+    const filePath = resolveDataFile(hierarchy || graph);
+    if (!filePath) {
+      return res.json({ error: 'Files must be inside the text data directory' });
+    }
+    args = [hierarchy ? '--ch' : '--graph', filePath, source.toString(), target.toString()];
+  } else {
+    const edgesStr = edges.map(e => `${e.from},${e.to},${e.weight}`).join(';');
+    args = [vertices.toString(), edgesStr, source.toString(), target.toString()];
+  }
+  if (directed && !hierarchy) args.push('--directed');
+  
+  const execPath = path.join(__dirname, '../algorithms/GraphAlgorithms/ContractionHierarchy/ContractionHierarchy');
+  const child = spawn(execPath, args);
+  
+  let output = '';
+  child.stdout.on('data', (data) => {
+    output += data.toString();
+  });
+  
+  child.on('close', (code) => {
+    try {
+      const result = JSON.parse(output.trim());
+      res.json(result);
+    } catch (e) {
+      res.json({ error: 'Failed to parse result', raw: output });
+    }
+  });
+  
+  child.on('error', (err) => {
+    res.json({ error: 'Execution failed', message: err.message });
+  });
+});
+
+router.post('/algorithms/graphfile', (req, res) => {
+  const { algorithm, graph, source } = req.body;
+  const { spawn } = require('child_process');
+  const path = require('path');
+  
+  const binaries = {
+    bfs: 'BFS', dfs: 'DFS', dijkstra: 'Dijkstra', bellmanford: 'BellmanFord',
+    floydwarshall: 'FloydWarshall', kahns: 'Kahns', kosaraju: 'Kosaraju',
+    kruskal: 'Kruskal', prims: 'Prims', topologicalsort: 'TopologicalSort'
+  };
+  const binary = binaries[(algorithm || '').toLowerCase()];
+  if (!binary) {
+    return res.json({ error: `Unknown algorithm: ${algorithm}` });
+  }
+  const graphPath = resolveDataFile(graph);
+  if (!graphPath) {
+    return res.json({ error: 'Graph file must be inside the text data directory' });
+  }
+  const args = ['--graph', graphPath];
+  if (source !== undefined) args.push(source.toString());
+  
+  const execPath = path.join(__dirname, '../algorithms/GraphAlgorithms', binary, binary);
+  const child = spawn(execPath, args);
+  
+  let output = '';
+  child.stdout.on('data', (data) => {
+    output += data.toString();
+  });
+  
+  child.on('close', (code) => {
+    try {
+      const result = JSON.parse(output.trim());
+      res.json(result);
+    } catch (e) {
+      res.json({ error: 'Failed to parse result', raw: output });
+    }
+  });
+  
+  child.on('error', (err) => {
+    res.json({ error: 'Execution failed', message: err.message });
+  });
+});
+
 // Bubble Sort Visualization
 router.post('/bubblesort/steps', (req, res) => {
   const { array } = req.body;
@@ -1617,14 +1844,19 @@ router.post('/exponentialsearch', (req, res) => {
 
 // Jump Search
 router.post('/jumpsearch', (req, res) => {
-  const { array, target } = req.body;
+  const { array, target, blockSize } = req.body;
   const arrayStr = array.join(',');
+  const targetStr = Array.isArray(target) ? target.join(',') : target.toString();
   
   const { spawn } = require('child_process');
   const path = require('path');
   
+  // blockSize: a number, or 'cache' for cache-line-aligned blocks (default sqrt(n))
+  const args = [arrayStr, targetStr];
+  if (blockSize !== undefined) args.push(blockSize.toString());
+  
   const execPath = path.join(__dirname, '../algorithms/Searching/JumpSearch/JumpSearch');
-  const child = spawn(execPath, [arrayStr, target.toString()]);
+  const child = spawn(execPath, args);
   
   let output = '';
   child.stdout.on('data', (data) => {
@@ -1667,14 +1899,74 @@ router.post('/binarysearch', (req, res) => {
   });
 });
 
+// Interpolation Search
+router.post('/interpolationsearch', (req, res) => {
+  const { array, target } = req.body;
+  const arrayStr = array.join(',');
+  
+  const { spawn } = require('child_process');
+  const path = require('path');
+  
+  const execPath = path.join(__dirname, '../algorithms/Searching/InterpolationSearch/InterpolationSearch');
+  const child = spawn(execPath, [arrayStr, target.toString()]);
+  
+  let output = '';
+  child.stdout.on('data', (data) => {
+    output += data.toString();
+  });
+  
+  child.on('close', (code) => {
+    try {
+      const result = JSON.parse(output.trim());
+      res.json(result);
+    } catch (e) {
+      res.json({ error: 'Failed to parse result', raw: output });
+    }
+  });
+});
+
+// Learned Index (piecewise-linear model over a sorted array)
+router.post('/learnedindex', (req, res) => {
+  const { array, targets, epsilon } = req.body;
+  const arrayStr = array.join(',');
+  const targetsStr = Array.isArray(targets) ? targets.join(',') : targets.toString();
+  
+  const { spawn } = require('child_process');
+  const path = require('path');
+  
+  const args = [arrayStr, targetsStr];
+  if (epsilon !== undefined) args.push(epsilon.toString());
+  
+  const execPath = path.join(__dirname, '../algorithms/Searching/LearnedIndex/LearnedIndex');
+  const child = spawn(execPath, args);
+  
+  let output = '';
+  child.stdout.on('data', (data) => {
+    output += data.toString();
+  });
+  
+  child.on('close', (code) => {
+    try {
+      const result = JSON.parse(output.trim());
+      res.json(result);
+    } catch (e) {
+      res.json({ error: 'Failed to parse result', raw: output });
+    }
+  });
+});
+
 // Naive String Matching
 router.post('/naivestring', (req, res) => {
-  const { text, pattern } = req.body;
+  const { text, pattern, fast } = req.body;
   const { spawn } = require('child_process');
   const path = require('path');
   
+  // fast: vectorised first/last-byte filter with KMP fallback
+  const args = [text, pattern];
+  if (fast) args.push('fast');
+  
   const execPath = path.join(__dirname, '../algorithms/StringAlgorithms/NaiveString/NaiveString');
-  const child = spawn(execPath, [text, pattern]);
+  const child = spawn(execPath, args);
   
   let output = '';
   child.stdout.on('data', (data) => {
@@ -1697,12 +1989,16 @@ router.post('/naivestring', (req, res) => {
 
 // KMP String Matching
 router.post('/kmp', (req, res) => {
-  const { text, pattern } = req.body;
+  const { text, pattern, fast } = req.body;
   const { spawn } = require('child_process');
   const path = require('path');
   
+  // fast: vectorised first/last-byte filter with KMP fallback
+  const args = [text, pattern];
+  if (fast) args.push('fast');
+  
   const execPath = path.join(__dirname, '../algorithms/StringAlgorithms/KMP/KMP');
-  const child = spawn(execPath, [text, pattern]);
+  const child = spawn(execPath, args);
   
   let output = '';
   child.stdout.on('data', (data) => {
@@ -1725,12 +2021,16 @@ router.post('/kmp', (req, res) => {
 
 // Rabin-Karp String Matching
 router.post('/rabinkarp', (req, res) => {
-  const { text, pattern } = req.body;
+  const { text, pattern, fast } = req.body;
   const { spawn } = require('child_process');
   const path = require('path');
   
+  // fast: vectorised first/last-byte filter with KMP fallback
+  const args = [text, pattern];
+  if (fast) args.push('fast');
+  
   const execPath = path.join(__dirname, '../algorithms/StringAlgorithms/RabinKarp/RabinKarp');
-  const child = spawn(execPath, [text, pattern]);
+  const child = spawn(execPath, args);
   
   let output = '';
   child.stdout.on('data', (data) => {
@@ -1751,20 +2051,14 @@ router.post('/rabinkarp', (req, res) => {
   });
 });
 
-// TSP (Travelling Salesman Problem)
-router.post('/tsp', (req, res) => {
-  const { distanceMatrix } = req.body;
+// Rabin-Karp with many equal-length patterns
+router.post('/rabinkarp/multi', (req, res) => {
+  const { text, patterns } = req.body;
   const { spawn } = require('child_process');
   const path = require('path');
   
-  // Format: "4;0,10,15,20;10,0,35,25;15,35,0,30;20,25,30,0"
-  let matrixStr = `${distanceMatrix.length}`;
-  for (let i = 0; i < distanceMatrix.length; i++) {
-    matrixStr += `;${distanceMatrix[i].join(',')}`;
-  }
-  
-  const execPath = path.join(__dirname, '../algorithms/BranchAndBound/TSP/TSP');
-  const child = spawn(execPath, [matrixStr]);
+  const execPath = path.join(__dirname, '../algorithms/StringAlgorithms/RabinKarp/RabinKarp');
+  const child = spawn(execPath, ['--multi', text, patterns.join(',')]);
   
   let output = '';
   child.stdout.on('data', (data) => {
@@ -1785,20 +2079,14 @@ router.post('/tsp', (req, res) => {
   });
 });
 
-// Job Scheduling
-router.post('/jobscheduling', (req, res) => {
-  const { jobs } = req.body;
+// Rabin-Karp duplicate substring detection
+router.post('/rabinkarp/duplicates', (req, res) => {
+  const { text, length } = req.body;
   const { spawn } = require('child_process');
   const path = require('path');
   
-  // Format: "5;A,2,100;B,1,19;C,2,27;D,1,25;E,3,15"
-  let jobsStr = `${jobs.length}`;
-  for (const job of jobs) {
-    jobsStr += `;${job.id},${job.deadline},${job.profit}`;
-  }
-  
-  const execPath = path.join(__dirname, '../algorithms/BranchAndBound/JobScheduling/JobScheduling');
-  const child = spawn(execPath, [jobsStr]);
+  const execPath = path.join(__dirname, '../algorithms/StringAlgorithms/RabinKarp/RabinKarp');
+  const child = spawn(execPath, ['--duplicates', text, length.toString()]);
   
   let output = '';
   child.stdout.on('data', (data) => {
@@ -1819,14 +2107,40 @@ router.post('/jobscheduling', (req, res) => {
   });
 });
 
-// LCS (Longest Common Subsequence)
-router.post('/lcs', (req, res) => {
-  const { stringX, stringY } = req.body;
+// Streaming String Matching over a server-side file (KMP / Rabin-Karp / Naive)
+// Pass `threads` with KMP to scan the file in parallel chunks.
+router.post('/stringsearch/stream', (req, res) => {
+  const { algorithm, file, pattern, chunkSize, threads } = req.body;
   const { spawn } = require('child_process');
   const path = require('path');
   
-  const execPath = path.join(__dirname, '../algorithms/DynamicProgramming/LCS/LCS');
-  const child = spawn(execPath, [stringX, stringY]);
+  const binaries = {
+    kmp: 'StringAlgorithms/KMP/KMP',
+    rabinkarp: 'StringAlgorithms/RabinKarp/RabinKarp',
+    naivestring: 'StringAlgorithms/NaiveString/NaiveString'
+  };
+  const binary = binaries[(algorithm || 'kmp').toLowerCase()];
+  if (!binary) {
+    return res.json({ error: `Unknown algorithm: ${algorithm}` });
+  }
+  
+  const filePath = resolveDataFile(file);
+  if (!filePath) {
+    return res.json({ error: 'File must be inside the text data directory' });
+  }
+  if (typeof pattern !== 'string' || pattern.length === 0) {
+    return res.json({ error: 'Pattern must be a non-empty string' });
+  }
+  
+  // KMP can split the file across threads instead of streaming it
+  let args = ['--file', filePath, pattern];
+  if (chunkSize) args.push(chunkSize.toString());
+  if (threads && binary === binaries.kmp) {
+    args = ['--parallel', filePath, pattern, threads.toString()];
+  }
+  
+  const execPath = path.join(__dirname, '../algorithms', binary);
+  const child = spawn(execPath, args);
   
   let output = '';
   child.stdout.on('data', (data) => {
@@ -1847,16 +2161,21 @@ router.post('/lcs', (req, res) => {
   });
 });
 
-// Matrix Chain Multiplication
-router.post('/matrixchain', (req, res) => {
-  const { dimensions } = req.body;
+// Suffix Array index build (SA-IS + Kasai LCP)
+router.post('/suffixarray/build', (req, res) => {
+  const { file, index } = req.body;
   const { spawn } = require('child_process');
   const path = require('path');
   
-  const dimsStr = dimensions.join(',');
-  
-  const execPath = path.join(__dirname, '../algorithms/DynamicProgramming/MatrixChainMultiplication/MatrixChainMultiplication');
-  const child = spawn(execPath, [dimsStr]);
+  const textPath = resolveDataFile(file);
+  const indexPath = resolveDataFile(index);
+  if (!textPath || !indexPath) {
+    return res.json({ error: 'Files must be inside the text data directory' });
+  }
+  const args = ['build', textPath, indexPath];
+
+  const execPath = path.join(__dirname, '../algorithms/StringAlgorithms/SuffixArray/SuffixArray');
+  const child = spawn(execPath, args);
   
   let output = '';
   child.stdout.on('data', (data) => {
@@ -1877,20 +2196,22 @@ router.post('/matrixchain', (req, res) => {
   });
 });
 
-// 0/1 Knapsack
-router.post('/knapsack01', (req, res) => {
-  const { items, capacity } = req.body;
+// Suffix Array queries against a built index
+router.post('/suffixarray/query', (req, res) => {
+  const { index, mode, pattern, limit } = req.body;
   const { spawn } = require('child_process');
   const path = require('path');
   
-  // Format: "4;60,10;100,20;120,30;80,15"
-  let itemsStr = `${items.length}`;
-  for (const item of items) {
-    itemsStr += `;${item.value},${item.weight}`;
+  // mode: 'count' | 'find' | 'lrs'
+  const indexPath = resolveDataFile(index);
+  if (!indexPath) {
+    return res.json({ error: 'Index must be inside the text data directory' });
   }
-  
-  const execPath = path.join(__dirname, '../algorithms/DynamicProgramming/Knapsack01/Knapsack01');
-  const child = spawn(execPath, [capacity.toString(), itemsStr]);
+  const args = mode === 'lrs' ? ['lrs', indexPath] : [mode === 'find' ? 'find' : 'count', indexPath, pattern];
+  if (mode === 'find' && limit) args.push(limit.toString());
+
+  const execPath = path.join(__dirname, '../algorithms/StringAlgorithms/SuffixArray/SuffixArray');
+  const child = spawn(execPath, args);
   
   let output = '';
   child.stdout.on('data', (data) => {
@@ -1911,14 +2232,16 @@ router.post('/knapsack01', (req, res) => {
   });
 });
 
-// Huffman Coding
-router.post('/huffman', (req, res) => {
-  const { text } = req.body;
+// Longest common substring via generalized suffix array
+router.post('/suffixarray/lcs', (req, res) => {
+  const { string1, string2 } = req.body;
   const { spawn } = require('child_process');
   const path = require('path');
   
-  const execPath = path.join(__dirname, '../algorithms/GreedyAlgorithms/HuffmanCoding/HuffmanCoding');
-  const child = spawn(execPath, [text]);
+  const args = ['lcs', string1, string2];
+
+  const execPath = path.join(__dirname, '../algorithms/StringAlgorithms/SuffixArray/SuffixArray');
+  const child = spawn(execPath, args);
   
   let output = '';
   child.stdout.on('data', (data) => {
@@ -1939,20 +2262,524 @@ router.post('/huffman', (req, res) => {
   });
 });
 
-// Activity Selection
-router.post('/activityselection', (req, res) => {
-  const { activities } = req.body;
+// Aho-Corasick Multi-Pattern Matching
+router.post('/ahocorasick', (req, res) => {
+  const { text, patterns, trace } = req.body;
   const { spawn } = require('child_process');
   const path = require('path');
   
-  // Format: "6;1,3;2,5;0,6;5,7;8,9;5,9"
-  let activitiesStr = `${activities.length}`;
-  for (const activity of activities) {
-    activitiesStr += `;${activity.start},${activity.finish}`;
+  const args = [text, patterns.join(',')];
+  if (trace) args.push('trace');
+  
+  const execPath = path.join(__dirname, '../algorithms/StringAlgorithms/AhoCorasick/AhoCorasick');
+  const child = spawn(execPath, args);
+  
+  let output = '';
+  child.stdout.on('data', (data) => {
+    output += data.toString();
+  });
+  
+  child.on('close', (code) => {
+    try {
+      const result = JSON.parse(output.trim());
+      res.json(result);
+    } catch (e) {
+      res.json({ error: 'Failed to parse result', raw: output });
+    }
+  });
+  
+  child.on('error', (err) => {
+    res.json({ error: 'Execution failed', message: err.message });
+  });
+});
+
+// TSP (Travelling Salesman Problem)
+router.post('/tsp', (req, res) => {
+  const { distanceMatrix, threads } = req.body;
+  const { spawn } = require('child_process');
+  const path = require('path');
+  
+  // Format: "4;0,10,15,20;10,0,35,25;15,35,0,30;20,25,30,0"
+  let matrixStr = `${distanceMatrix.length}`;
+  for (let i = 0; i < distanceMatrix.length; i++) {
+    matrixStr += `;${distanceMatrix[i].join(',')}`;
+  }
+  
+  const execPath = path.join(__dirname, '../algorithms/BranchAndBound/TSP/TSP');
+  const args = [matrixStr];
+  if (threads) args.push(String(threads));
+  const child = spawn(execPath, args);
+  
+  let output = '';
+  child.stdout.on('data', (data) => {
+    output += data.toString();
+  });
+  
+  child.on('close', (code) => {
+    try {
+      const result = JSON.parse(output.trim());
+      res.json(result);
+    } catch (e) {
+      res.json({ error: 'Failed to parse result', raw: output });
+    }
+  });
+  
+  child.on('error', (err) => {
+    res.json({ error: 'Execution failed', message: err.message });
+  });
+});
+
+// Exact TSP by branch and bound (1-tree bounds, best-first with dives)
+router.post('/tsp/branch-bound', (req, res) => {
+  const { distanceMatrix, timeMs, threads } = req.body;
+  const { spawn } = require('child_process');
+  const path = require('path');
+  
+  let matrixStr = `${distanceMatrix.length}`;
+  for (let i = 0; i < distanceMatrix.length; i++) {
+    matrixStr += `;${distanceMatrix[i].join(',')}`;
+  }
+  const args = [matrixStr];
+  if (timeMs) args.push('--time', String(timeMs));
+  if (threads) args.push('--threads', String(threads));
+
+  const execPath = path.join(__dirname, '../algorithms/BranchAndBound/TSPBranchBound/TSPBranchBound');
+  const child = spawn(execPath, args);
+  
+  let output = '';
+  child.stdout.on('data', (data) => {
+    output += data.toString();
+  });
+  
+  child.on('close', (code) => {
+    try {
+      const result = JSON.parse(output.trim());
+      res.json(result);
+    } catch (e) {
+      res.json({ error: 'Failed to parse result', raw: output });
+    }
+  });
+  
+  child.on('error', (err) => {
+    res.json({ error: 'Execution failed', message: err.message });
+  });
+});
+
+// Heuristic TSP (greedy/NN start, 2-opt + Or-opt, iterated local search)
+router.post('/tsp/heuristic', (req, res) => {
+  const { distanceMatrix, points, timeMs, threads, construct } = req.body;
+  const { spawn } = require('child_process');
+  const path = require('path');
+  
+  let args;
+  if (points) {
+    args = ['--points', points.map((p) => `${p.x},${p.y}`).join(';')];
+  } else {
+    let matrixStr = `${distanceMatrix.length}`;
+    for (let i = 0; i < distanceMatrix.length; i++) {
+      matrixStr += `;${distanceMatrix[i].join(',')}`;
+    }
+    args = [matrixStr];
+  }
+  args.push('--time', String(timeMs || 1000));
+  if (threads) args.push('--threads', String(threads));
+  if (construct) args.push('--construct', construct);
+
+  const execPath = path.join(__dirname, '../algorithms/BranchAndBound/TSPHeuristic/TSPHeuristic');
+  const child = spawn(execPath, args);
+  
+  let output = '';
+  child.stdout.on('data', (data) => {
+    output += data.toString();
+  });
+  
+  child.on('close', (code) => {
+    try {
+      const result = JSON.parse(output.trim());
+      res.json(result);
+    } catch (e) {
+      res.json({ error: 'Failed to parse result', raw: output });
+    }
+  });
+  
+  child.on('error', (err) => {
+    res.json({ error: 'Execution failed', message: err.message });
+  });
+});
+
+// Job Scheduling
+router.post('/jobscheduling', (req, res) => {
+  const { jobs, weighted } = req.body;
+  const { spawn } = require('child_process');
+  const path = require('path');
+  
+  // Format: "5;A,2,100;B,1,19;C,2,27;D,1,25;E,3,15"
+  // Weighted (start and duration instead of a deadline): "2;A,0,3,50;B,2,4,60"
+  let jobsStr = `${jobs.length}`;
+  for (const job of jobs) {
+    jobsStr += weighted ? `;${job.id},${job.start},${job.duration},${job.profit}`
+                        : `;${job.id},${job.deadline},${job.profit}`;
+  }
+  const args = [jobsStr];
+  if (weighted) args.push('--weighted');
+  
+  const execPath = path.join(__dirname, '../algorithms/BranchAndBound/JobScheduling/JobScheduling');
+  const child = spawn(execPath, args);
+  
+  let output = '';
+  child.stdout.on('data', (data) => {
+    output += data.toString();
+  });
+  
+  child.on('close', (code) => {
+    try {
+      const result = JSON.parse(output.trim());
+      res.json(result);
+    } catch (e) {
+      res.json({ error: 'Failed to parse result', raw: output });
+    }
+  });
+  
+  child.on('error', (err) => {
+    res.json({ error: 'Execution failed', message: err.message });
+  });
+});
+
+// Job Scheduling over a server-side batch file (one id,deadline,profit record per line)
+router.post('/jobscheduling/file', (req, res) => {
+  const { file, weighted, list } = req.body;
+  const { spawn } = require('child_process');
+  const path = require('path');
+  
+  const filePath = resolveDataFile(file);
+  if (!filePath) {
+    return res.json({ error: 'File must be inside the text data directory' });
+  }
+  const args = ['--file', filePath];
+  if (weighted) args.push('--weighted');
+  if (!list) args.push('--no-list');
+  
+  const execPath = path.join(__dirname, '../algorithms/BranchAndBound/JobScheduling/JobScheduling');
+  const child = spawn(execPath, args);
+  
+  let output = '';
+  child.stdout.on('data', (data) => {
+    output += data.toString();
+  });
+  
+  child.on('close', (code) => {
+    try {
+      const result = JSON.parse(output.trim());
+      res.json(result);
+    } catch (e) {
+      res.json({ error: 'Failed to parse result', raw: output });
+    }
+  });
+  
+  child.on('error', (err) => {
+    res.json({ error: 'Execution failed', message: err.message });
+  });
+});
+
+// LCS (Longest Common Subsequence)
+router.post('/lcs', (req, res) => {
+  const { stringX, stringY, mode } = req.body;
+  const { spawn } = require('child_process');
+  const path = require('path');
+  
+  // '--' keeps strings that look like flags (e.g. "--files") as input
+  const args = ['--', stringX, stringY];
+  if (mode === 'length' || mode === 'wavefront') args.unshift(`--${mode}`);
+
+  const execPath = path.join(__dirname, '../algorithms/DynamicProgramming/LCS/LCS');
+  const child = spawn(execPath, args);
+  
+  let output = '';
+  child.stdout.on('data', (data) => {
+    output += data.toString();
+  });
+  
+  child.on('close', (code) => {
+    try {
+      const result = JSON.parse(output.trim());
+      res.json(result);
+    } catch (e) {
+      res.json({ error: 'Failed to parse result', raw: output });
+    }
+  });
+  
+  child.on('error', (err) => {
+    res.json({ error: 'Execution failed', message: err.message });
+  });
+});
+
+// LCS over two server-side documents (bit-parallel / Hirschberg / wavefront)
+router.post('/lcs/files', (req, res) => {
+  const { file1, file2, mode, threads } = req.body;
+  const { spawn } = require('child_process');
+  const path = require('path');
+  
+  const path1 = resolveDataFile(file1);
+  const path2 = resolveDataFile(file2);
+  if (!path1 || !path2) {
+    return res.json({ error: 'Files must be inside the text data directory' });
+  }
+  const args = ['--files', path1, path2];
+  if (mode === 'length' || mode === 'wavefront') args.unshift(`--${mode}`);
+  if (mode === 'wavefront' && threads) args.push(String(threads));
+
+  const execPath = path.join(__dirname, '../algorithms/DynamicProgramming/LCS/LCS');
+  const child = spawn(execPath, args);
+  
+  let output = '';
+  child.stdout.on('data', (data) => {
+    output += data.toString();
+  });
+  
+  child.on('close', (code) => {
+    try {
+      const result = JSON.parse(output.trim());
+      res.json(result);
+    } catch (e) {
+      res.json({ error: 'Failed to parse result', raw: output });
+    }
+  });
+  
+  child.on('error', (err) => {
+    res.json({ error: 'Execution failed', message: err.message });
+  });
+});
+
+// Edit distance family (Levenshtein, Damerau, affine gap, Myers, striped)
+router.post('/editdistance', (req, res) => {
+  const { stringX, stringY, file1, file2, model, maxDistance, align, mismatch, gapOpen, gapExtend } = req.body;
+  const { spawn } = require('child_process');
+  const path = require('path');
+  
+  // Options first, then '--' so strings that look like flags stay input
+  const args = [];
+  if (maxDistance !== undefined) args.push('--max', String(maxDistance));
+  if (align) args.push('--align');
+  if (mismatch !== undefined) args.push('--mismatch', String(mismatch));
+  if (gapOpen !== undefined) args.push('--gap-open', String(gapOpen));
+  if (gapExtend !== undefined) args.push('--gap-extend', String(gapExtend));
+  if (file1 || file2) {
+    const path1 = resolveDataFile(file1);
+    const path2 = resolveDataFile(file2);
+    if (!path1 || !path2) {
+      return res.json({ error: 'Files must be inside the text data directory' });
+    }
+    args.push('--files', '--', path1, path2);
+  } else {
+    args.push('--', stringX, stringY);
+  }
+  args.push(model || 'levenshtein');
+
+  const execPath = path.join(__dirname, '../algorithms/DynamicProgramming/EditDistance/EditDistance');
+  const child = spawn(execPath, args);
+  
+  let output = '';
+  child.stdout.on('data', (data) => {
+    output += data.toString();
+  });
+  
+  child.on('close', (code) => {
+    try {
+      const result = JSON.parse(output.trim());
+      res.json(result);
+    } catch (e) {
+      res.json({ error: 'Failed to parse result', raw: output });
+    }
+  });
+  
+  child.on('error', (err) => {
+    res.json({ error: 'Execution failed', message: err.message });
+  });
+});
+
+// Matrix Chain Multiplication
+router.post('/matrixchain', (req, res) => {
+  const { dimensions, mode, threads } = req.body;
+  const { spawn } = require('child_process');
+  const path = require('path');
+  
+  const dimsStr = dimensions.join(',');
+  
+  const execPath = path.join(__dirname, '../algorithms/DynamicProgramming/MatrixChainMultiplication/MatrixChainMultiplication');
+  const args = [dimsStr, mode || 'exact'];
+  if (threads) args.push(String(threads));
+  const child = spawn(execPath, args);
+  
+  let output = '';
+  child.stdout.on('data', (data) => {
+    output += data.toString();
+  });
+  
+  child.on('close', (code) => {
+    try {
+      const result = JSON.parse(output.trim());
+      res.json(result);
+    } catch (e) {
+      res.json({ error: 'Failed to parse result', raw: output });
+    }
+  });
+  
+  child.on('error', (err) => {
+    res.json({ error: 'Execution failed', message: err.message });
+  });
+});
+
+// 0/1 Knapsack
+router.post('/knapsack01', (req, res) => {
+  const { items, capacity, threads } = req.body;
+  const { spawn } = require('child_process');
+  const path = require('path');
+  
+  // Format: "4;60,10;100,20;120,30;80,15"
+  let itemsStr = `${items.length}`;
+  for (const item of items) {
+    itemsStr += `;${item.value},${item.weight}`;
+  }
+  
+  const execPath = path.join(__dirname, '../algorithms/DynamicProgramming/Knapsack01/Knapsack01');
+  const args = [capacity.toString(), itemsStr];
+  if (threads) args.push(String(threads));
+  const child = spawn(execPath, args);
+  
+  let output = '';
+  child.stdout.on('data', (data) => {
+    output += data.toString();
+  });
+  
+  child.on('close', (code) => {
+    try {
+      const result = JSON.parse(output.trim());
+      res.json(result);
+    } catch (e) {
+      res.json({ error: 'Failed to parse result', raw: output });
+    }
+  });
+  
+  child.on('error', (err) => {
+    res.json({ error: 'Execution failed', message: err.message });
+  });
+});
+
+// Huffman Coding
+router.post('/huffman', (req, res) => {
+  const { text } = req.body;
+  const { spawn } = require('child_process');
+  const path = require('path');
+  
+  const execPath = path.join(__dirname, '../algorithms/GreedyAlgorithms/HuffmanCoding/HuffmanCoding');
+  const child = spawn(execPath, [text]);
+  
+  let output = '';
+  child.stdout.on('data', (data) => {
+    output += data.toString();
+  });
+  
+  child.on('close', (code) => {
+    try {
+      const result = JSON.parse(output.trim());
+      res.json(result);
+    } catch (e) {
+      res.json({ error: 'Failed to parse result', raw: output });
+    }
+  });
+  
+  child.on('error', (err) => {
+    res.json({ error: 'Execution failed', message: err.message });
+  });
+});
+
+// Huffman encode/decode of a server-side file
+router.post('/huffman/codec', (req, res) => {
+  const { mode, input, output: outputFile } = req.body;
+  const { spawn } = require('child_process');
+  const path = require('path');
+  
+  const inPath = resolveDataFile(input);
+  const outPath = resolveDataFile(outputFile);
+  if (!inPath || !outPath) {
+    return res.json({ error: 'Files must be inside the text data directory' });
+  }
+  
+  const execPath = path.join(__dirname, '../algorithms/GreedyAlgorithms/HuffmanCoding/HuffmanCoding');
+  const child = spawn(execPath, [mode === 'decode' ? 'decode' : 'encode', inPath, outPath]);
+  
+  let output = '';
+  child.stdout.on('data', (data) => {
+    output += data.toString();
+  });
+  
+  child.on('close', (code) => {
+    try {
+      const result = JSON.parse(output.trim());
+      res.json(result);
+    } catch (e) {
+      res.json({ error: 'Failed to parse result', raw: output });
+    }
+  });
+  
+  child.on('error', (err) => {
+    res.json({ error: 'Execution failed', message: err.message });
+  });
+});
+
+// Activity Selection
+router.post('/activityselection', (req, res) => {
+  const { activities, mode } = req.body;
+  const { spawn } = require('child_process');
+  const path = require('path');
+  
+  // Format: "6;1,3;2,5;0,6;5,7;8,9;5,9" (weighted adds a third field)
+  let activitiesStr = `${activities.length}`;
+  for (const activity of activities) {
+    activitiesStr += mode === 'weighted' ? `;${activity.start},${activity.finish},${activity.weight}`
+                                         : `;${activity.start},${activity.finish}`;
+  }
+  const args = [activitiesStr];
+  if (mode === 'weighted' || mode === 'rooms') args.push(`--${mode}`);
+  
+  const execPath = path.join(__dirname, '../algorithms/GreedyAlgorithms/ActivitySelection/ActivitySelection');
+  const child = spawn(execPath, args);
+  
+  let output = '';
+  child.stdout.on('data', (data) => {
+    output += data.toString();
+  });
+  
+  child.on('close', (code) => {
+    try {
+      const result = JSON.parse(output.trim());
+      res.json(result);
+    } catch (e) {
+      res.json({ error: 'Failed to parse result', raw: output });
+    }
+  });
+  
+  child.on('error', (err) => {
+    res.json({ error: 'Execution failed', message: err.message });
+  });
+});
+
+// Activity Selection over a server-side file; mode "stream" needs it sorted by finish
+router.post('/activityselection/file', (req, res) => {
+  const { file, mode, list } = req.body;
+  const { spawn } = require('child_process');
+  const path = require('path');
+  
+  const filePath = resolveDataFile(file);
+  if (!filePath) {
+    return res.json({ error: 'File must be inside the text data directory' });
   }
+  const args = mode === 'stream' ? ['--stream', filePath] : ['--file', filePath];
+  if (mode === 'weighted' || mode === 'rooms') args.push(`--${mode}`);
+  if (!list) args.push('--no-list');
   
   const execPath = path.join(__dirname, '../algorithms/GreedyAlgorithms/ActivitySelection/ActivitySelection');
-  const child = spawn(execPath, [activitiesStr]);
+  const child = spawn(execPath, args);
   
   let output = '';
   child.stdout.on('data', (data) => {
@@ -1975,7 +2802,7 @@ router.post('/activityselection', (req, res) => {
 
 // Fractional Knapsack
 router.post('/fractionalknapsack', (req, res) => {
-  const { items, capacity } = req.body;
+  const { items, capacity, mode, threads } = req.body;
   const { spawn } = require('child_process');
   const path = require('path');
   
@@ -1984,9 +2811,13 @@ router.post('/fractionalknapsack', (req, res) => {
   for (const item of items) {
     itemsStr += `;${item.value},${item.weight}`;
   }
+  // mode: sort (default, includes the step trace), select or parallel
+  const args = [capacity.toString(), itemsStr];
+  if (mode) args.push(mode);
+  if (mode && threads) args.push(String(threads));
   
   const execPath = path.join(__dirname, '../algorithms/GreedyAlgorithms/FractionalKnapsack/FractionalKnapsack');
-  const child = spawn(execPath, [capacity.toString(), itemsStr]);
+  const child = spawn(execPath, args);
   
   let output = '';
   child.stdout.on('data', (data) => {